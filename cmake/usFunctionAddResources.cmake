@@ -8,7 +8,7 @@
 # .. code-block:: cmake
 #
 #    usFunctionAddResources(TARGET target [BUNDLE_NAME bundle_name]
-#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level]
+#      [WORKING_DIRECTORY dir] [COMPRESSION_LEVEL level] [BINARY_MANIFEST]
 #      [FILES res1...] [ZIP_ARCHIVES archive1...])
 #
 # This CMake function uses an external command line program to generate a ZIP archive
@@ -33,6 +33,11 @@
 #                           FILES config.properties logo.png
 #                          )
 #
+# **Options**
+#    * ``BINARY_MANIFEST``: Store a precompiled binary form of the bundle's manifest.json
+#      next to it. The framework reads the binary form instead of parsing the JSON when
+#      the bundle is installed.
+#
 # **One-value keywords**
 #    * ``TARGET`` (required): The target to which the resource files are added.
 #    * ``BUNDLE_NAME`` (required/optional): The bundle name of the target, as specified in
@@ -60,7 +65,7 @@
 #
 function(usFunctionAddResources)
 
-  cmake_parse_arguments(US_RESOURCE "" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
+  cmake_parse_arguments(US_RESOURCE "BINARY_MANIFEST" "TARGET;BUNDLE_NAME;WORKING_DIRECTORY;COMPRESSION_LEVEL" "FILES;ZIP_ARCHIVES" ${ARGN})
 
   if(NOT US_RESOURCE_TARGET)
     message(SEND_ERROR "TARGET argument not specified.")
@@ -85,9 +90,12 @@ function(usFunctionAddResources)
     set(US_RESOURCE_WORKING_DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}/${US_RESOURCE_WORKING_DIRECTORY}")
   endif()
 
-  if(US_RESOURCE_COMPRESSION_LEVEL)
+  if(NOT "${US_RESOURCE_COMPRESSION_LEVEL}" STREQUAL "")
     set(cmd_line_args -c ${US_RESOURCE_COMPRESSION_LEVEL})
   endif()
+  if(US_RESOURCE_BINARY_MANIFEST)
+    list(APPEND cmd_line_args --binary-manifest)
+  endif()
 
   set(_rc_env_cmd)
   if(CMAKE_CROSSCOMPILING)
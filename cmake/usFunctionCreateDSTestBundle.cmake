@@ -1,13 +1,19 @@
 function(usFunctionCreateDSTestBundle name)
   # Add in rule for how to build the autogen source for the glue
+  cmake_parse_arguments(US_DS_TEST "" "MANIFEST" "" ${ARGN})
+  if(US_DS_TEST_MANIFEST)
+    set(_manifest ${US_DS_TEST_MANIFEST})
+  else()
+    set(_manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json)
+  endif()
 
   set(_glue_file ${CMAKE_CURRENT_BINARY_DIR}/autogen_${name}_Glue.cpp)
   set(_glue_file ${_glue_file} PARENT_SCOPE)
 
   add_custom_command(
     OUTPUT ${_glue_file}
-    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json --out-file ${_glue_file} --include-headers ServiceComponents.hpp
-    DEPENDS SCRCodeGen usServiceComponent ${CMAKE_CURRENT_SOURCE_DIR}/resources/manifest.json
+    COMMAND $<TARGET_FILE:SCRCodeGen> --manifest ${_manifest} --out-file ${_glue_file} --include-headers ServiceComponents.hpp
+    DEPENDS SCRCodeGen usServiceComponent ${_manifest}
     COMMENT "Generate bundle activator based on manifest.json"
     VERBATIM)
 
@@ -24,6 +24,11 @@ macro(_us_create_test_bundle_helper)
                            FILES ${_res_files}
                            ZIP_ARCHIVES ${US_TEST_LINK_LIBRARIES})
   endif()
+  if(_stored_res_files)
+    usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${_res_root}
+                           COMPRESSION_LEVEL 0
+                           FILES ${_stored_res_files})
+  endif()
   if(_bin_res_files)
     usFunctionAddResources(TARGET ${name} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/resources
                            FILES ${_bin_res_files})
@@ -41,13 +46,14 @@ function(usFunctionCreateTestBundle name)
   set(_srcs ${ARGN})
   set(_res_files )
   set(_bin_res_files )
+  set(_stored_res_files )
   set(_bundle_symbolic_name ${name})
   usFunctionGenerateBundleInit(TARGET ${name} OUT _srcs)
   _us_create_test_bundle_helper()
 endfunction()
 
 function(usFunctionCreateTestBundleWithResources name)
-  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME" "SOURCES;RESOURCES;BINARY_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
+  cmake_parse_arguments(US_TEST "SKIP_BUNDLE_LIST;LINK_RESOURCES;APPEND_RESOURCES" "RESOURCES_ROOT;LIBRARY_EXTENSION;BUNDLE_SYMBOLIC_NAME" "SOURCES;RESOURCES;BINARY_RESOURCES;STORED_RESOURCES;LINK_LIBRARIES;OTHER_LIBRARIES" "" ${ARGN})
 
   if(US_TEST_BUNDLE_SYMBOLIC_NAME)
     set(_bundle_symbolic_name ${US_TEST_BUNDLE_SYMBOLIC_NAME})
@@ -66,6 +72,7 @@ function(usFunctionCreateTestBundleWithResources name)
   usFunctionGetResourceSource(TARGET ${name} OUT _srcs ${_mode})
   set(_res_files ${US_TEST_RESOURCES})
   set(_bin_res_files ${US_TEST_BINARY_RESOURCES})
+  set(_stored_res_files ${US_TEST_STORED_RESOURCES})
   if(US_TEST_RESOURCES_ROOT)
     set(_res_root ${US_TEST_RESOURCES_ROOT})
   else()
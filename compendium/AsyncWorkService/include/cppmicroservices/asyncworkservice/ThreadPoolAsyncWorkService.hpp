@@ -0,0 +1,142 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef CPPMICROSERVICES_THREAD_POOL_ASYNC_WORK_SERVICE_HPP
+#define CPPMICROSERVICES_THREAD_POOL_ASYNC_WORK_SERVICE_HPP
+
+#include "cppmicroservices/asyncworkservice/AsyncWorkService.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cppmicroservices
+{
+    namespace async
+    {
+
+        /**
+         * \ingroup MicroService
+         * \ingroup gr_asyncworkservice
+         *
+         * An AsyncWorkService which runs tasks on a fixed number of threads. DeclarativeServices and
+         * ConfigurationAdmin use it when no AsyncWorkService is registered with the framework; the
+         * THREADPOOL_SIZE and THREADPOOL_QUEUE_POLICY framework properties configure those instances.
+         *
+         * With QueuePolicy::WorkStealing, every thread owns a queue. Tasks posted from one of the
+         * threads are queued on that thread's queue, other tasks are spread over all queues, and an idle
+         * thread takes tasks from the back of the queues of busy threads. With QueuePolicy::Fifo, all
+         * threads share one queue and tasks are started in the order they were posted.
+         *
+         * @remarks This class is thread safe.
+         */
+        class US_usAsyncWorkService_EXPORT ThreadPoolAsyncWorkService final : public AsyncWorkService
+        {
+          public:
+            /**
+             * Name of the framework property holding the number of threads of the fallback
+             * AsyncWorkService used by DeclarativeServices and ConfigurationAdmin. "0" uses one
+             * thread per hardware thread.
+             */
+            static std::string const THREADPOOL_SIZE;
+
+            /**
+             * Name of the framework property holding the queue policy, "work_stealing" or "fifo", of the
+             * fallback AsyncWorkService used by DeclarativeServices and ConfigurationAdmin.
+             */
+            static std::string const THREADPOOL_QUEUE_POLICY;
+
+            enum class QueuePolicy
+            {
+                WorkStealing,
+                Fifo
+            };
+
+            struct Options
+            {
+                /// The number of threads, 0 for one per hardware thread.
+                std::size_t threads = 1;
+                QueuePolicy queuePolicy = QueuePolicy::WorkStealing;
+            };
+
+            /**
+             * Counters describing the work done by a ThreadPoolAsyncWorkService so far.
+             * The latencies are the times tasks spent queued before they were started.
+             */
+            struct Metrics
+            {
+                std::size_t queueDepth = 0;    ///< tasks currently queued and not yet started
+                std::size_t maxQueueDepth = 0; ///< largest queueDepth observed
+                std::uint64_t completedTasks = 0;
+                std::uint64_t stolenTasks = 0; ///< tasks run by a thread other than the one they were queued for
+                std::chrono::nanoseconds totalLatency { 0 };
+                std::chrono::nanoseconds maxLatency { 0 };
+            };
+
+            /**
+             * Creates Options from the string values of the THREADPOOL_SIZE and THREADPOOL_QUEUE_POLICY
+             * properties. An empty string keeps the corresponding value of defaults.
+             *
+             * @throws std::invalid_argument if threads is not a non-negative number or queuePolicy is
+             * neither "work_stealing" nor "fifo".
+             */
+            static Options ParseOptions(std::string const& threads,
+                                        std::string const& queuePolicy,
+                                        Options const& defaults);
+
+            /**
+             * Starts the threads of the pool.
+             */
+            explicit ThreadPoolAsyncWorkService(Options const& options);
+
+            /**
+             * Runs all queued tasks, including those they post, and joins the threads. Tasks posted
+             * afterwards are discarded, which makes their futures throw std::future_error.
+             */
+            ~ThreadPoolAsyncWorkService() override;
+
+            ThreadPoolAsyncWorkService(ThreadPoolAsyncWorkService const&) = delete;
+            ThreadPoolAsyncWorkService& operator=(ThreadPoolAsyncWorkService const&) = delete;
+
+            void post(std::packaged_task<void()>&& task) override;
+
+            /**
+             * Returns an AsyncWorkService which runs its tasks on this pool one at a time, in the order
+             * they were posted. It may outlive this ThreadPoolAsyncWorkService.
+             */
+            std::shared_ptr<AsyncWorkService> createStrand() override;
+
+            std::size_t GetThreadCount() const;
+
+            Metrics GetMetrics() const;
+
+          private:
+            class Pool;
+            class Strand;
+
+            std::shared_ptr<Pool> pool;
+        };
+    } // namespace async
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_THREAD_POOL_ASYNC_WORK_SERVICE_HPP
@@ -0,0 +1,443 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace cppmicroservices::async
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct QueuedTask
+        {
+            std::packaged_task<void()> task;
+            Clock::time_point posted;
+        };
+
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<QueuedTask> tasks;
+        };
+
+        template <typename T>
+        void
+        UpdateMax(std::atomic<T>& max, T value)
+        {
+            auto current = max.load(std::memory_order_relaxed);
+            while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // identifies the pool and queue of a pool thread, so that tasks it posts stay on its queue
+        thread_local void const* currentPool = nullptr;
+        thread_local std::size_t currentQueue = 0;
+    } // namespace
+
+    std::string const ThreadPoolAsyncWorkService::THREADPOOL_SIZE = "org.cppmicroservices.async.threadpool.size";
+    std::string const ThreadPoolAsyncWorkService::THREADPOOL_QUEUE_POLICY
+        = "org.cppmicroservices.async.threadpool.queue_policy";
+
+    class ThreadPoolAsyncWorkService::Pool : public std::enable_shared_from_this<Pool>
+    {
+      public:
+        explicit Pool(Options const& options)
+            : queuePolicy(options.queuePolicy)
+            , threadCount(options.threads > 0 ? options.threads
+                                              : std::max(1u, std::thread::hardware_concurrency()))
+        {
+            auto const queueCount = (queuePolicy == QueuePolicy::WorkStealing) ? threadCount : 1;
+            for (std::size_t i = 0; i < queueCount; ++i)
+            {
+                queues.push_back(std::make_unique<TaskQueue>());
+            }
+        }
+
+        void
+        Start()
+        {
+            for (std::size_t i = 0; i < threadCount; ++i)
+            {
+                // the threads keep the pool alive, in case the last reference is released by one of them
+                threads.emplace_back([self = shared_from_this(), i] { self->Run(i); });
+            }
+        }
+
+        // returns false, discarding the task, once the pool is shutting down, unless the task
+        // is posted by one of its threads
+        bool
+        Post(std::packaged_task<void()>&& task)
+        {
+            // The task is counted before stopping is checked, and a thread only exits once stopping is
+            // set and nothing is counted, so either a thread runs this task or it is discarded here.
+            // A pool thread posting a task has not exited yet, so it runs the task if no other does.
+            UpdateMax(maxQueueDepth, queued.fetch_add(1) + 1);
+            if (!AcceptsTasks())
+            {
+                queued.fetch_sub(1);
+                // discarding the task breaks its promise, so nobody waits for it forever
+                std::packaged_task<void()> discarded(std::move(task));
+                return false;
+            }
+
+            std::size_t index = 0;
+            if (queuePolicy == QueuePolicy::WorkStealing)
+            {
+                index = (currentPool == this) ? currentQueue
+                                              : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            }
+            {
+                auto& queue = *queues[index];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(QueuedTask { std::move(task), Clock::now() });
+            }
+
+            // a thread going to sleep increments sleepers before checking queued, so it either sees
+            // this task or is woken up here
+            if (sleepers.load() > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                }
+                wakeUp.notify_one();
+            }
+            return true;
+        }
+
+        // whether tasks posted by the calling thread are accepted, which they are until the pool
+        // is shutting down, and from its threads until it stopped
+        bool
+        AcceptsTasks() const
+        {
+            return !stopping.load() || currentPool == this;
+        }
+
+        void
+        Shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto& thread : threads)
+            {
+                if (thread.get_id() == std::this_thread::get_id())
+                {
+                    thread.detach();
+                }
+                else if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::size_t
+        GetThreadCount() const
+        {
+            return threadCount;
+        }
+
+        Metrics
+        GetMetrics() const
+        {
+            Metrics metrics;
+            metrics.queueDepth = queued.load();
+            metrics.maxQueueDepth = maxQueueDepth.load();
+            metrics.completedTasks = completedTasks.load();
+            metrics.stolenTasks = stolenTasks.load();
+            metrics.totalLatency = std::chrono::nanoseconds(totalLatency.load());
+            metrics.maxLatency = std::chrono::nanoseconds(maxLatency.load());
+            return metrics;
+        }
+
+      private:
+        void
+        Run(std::size_t index)
+        {
+            if (queuePolicy == QueuePolicy::Fifo)
+            {
+                index = 0;
+            }
+            currentPool = this;
+            currentQueue = index;
+
+            for (;;)
+            {
+                QueuedTask task;
+                if (TryPop(index, task))
+                {
+                    Execute(task);
+                    continue;
+                }
+
+                // a task may be counted shortly before it is queued, in that case this retries
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                sleepers.fetch_add(1);
+                wakeUp.wait(lock, [this] { return queued.load() > 0 || stopping; });
+                sleepers.fetch_sub(1);
+                // queued work, including work posted by running tasks, is drained before stopping
+                if (stopping && queued.load() == 0)
+                {
+                    break;
+                }
+            }
+            currentPool = nullptr;
+        }
+
+        bool
+        TryPop(std::size_t index, QueuedTask& task)
+        {
+            {
+                auto& own = *queues[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.front());
+                    own.tasks.pop_front();
+                    queued.fetch_sub(1);
+                    return true;
+                }
+            }
+
+            // steal the most recently queued task of another thread, leaving it the older ones
+            for (std::size_t i = 1; i < queues.size(); ++i)
+            {
+                auto& victim = *queues[(index + i) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.back());
+                    victim.tasks.pop_back();
+                    queued.fetch_sub(1);
+                    stolenTasks.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void
+        Execute(QueuedTask& task)
+        {
+            auto const latency
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - task.posted).count();
+            totalLatency.fetch_add(latency, std::memory_order_relaxed);
+            UpdateMax(maxLatency, static_cast<std::int64_t>(latency));
+
+            try
+            {
+                // the packaged_task stores exceptions thrown by the callable in its future
+                task.task();
+            }
+            catch (...)
+            {
+                // only thrown for a task without a shared state
+            }
+            completedTasks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        QueuePolicy const queuePolicy;
+        std::size_t const threadCount;
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        std::vector<std::thread> threads;
+
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::atomic<std::size_t> sleepers { 0 };
+        std::atomic<std::size_t> queued { 0 };
+        std::atomic<std::size_t> nextQueue { 0 };
+        std::atomic<bool> stopping { false }; // set with sleepMutex held
+
+        std::atomic<std::size_t> maxQueueDepth { 0 };
+        std::atomic<std::uint64_t> completedTasks { 0 };
+        std::atomic<std::uint64_t> stolenTasks { 0 };
+        std::atomic<std::int64_t> totalLatency { 0 };
+        std::atomic<std::int64_t> maxLatency { 0 };
+    };
+
+    /**
+     * Runs the tasks posted to it one at a time, by posting a task to the pool
+     * which runs the oldest of them and then posts itself again if there are more.
+     */
+    class ThreadPoolAsyncWorkService::Strand final
+        : public AsyncWorkService
+        , public std::enable_shared_from_this<Strand>
+    {
+      public:
+        explicit Strand(std::shared_ptr<Pool> pool_) : pool(std::move(pool_)) {}
+
+        void
+        post(std::packaged_task<void()>&& task) override
+        {
+            if (!pool->AcceptsTasks())
+            {
+                // Without this, tasks posted from other threads could keep a scheduled strand, and so
+                // the pool, running forever. Discarding the task breaks its promise.
+                std::packaged_task<void()> discarded(std::move(task));
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.push_back(std::move(task));
+                if (scheduled)
+                {
+                    return;
+                }
+                scheduled = true;
+            }
+            Schedule();
+        }
+
+      private:
+        void
+        Schedule()
+        {
+            if (!pool->Post(std::packaged_task<void()>([self = shared_from_this()] { self->RunNext(); })))
+            {
+                // the pool has stopped, break the promises of the queued tasks
+                std::deque<std::packaged_task<void()>> discarded;
+                std::lock_guard<std::mutex> lock(mutex);
+                discarded.swap(tasks);
+                scheduled = false;
+            }
+        }
+
+        void
+        RunNext()
+        {
+            std::packaged_task<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            if (task.valid())
+            {
+                task();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty())
+                {
+                    scheduled = false;
+                    return;
+                }
+            }
+            Schedule();
+        }
+
+        std::shared_ptr<Pool> pool;
+        std::mutex mutex;
+        std::deque<std::packaged_task<void()>> tasks;
+        bool scheduled = false; // whether a RunNext task is queued or running
+    };
+
+    ThreadPoolAsyncWorkService::Options
+    ThreadPoolAsyncWorkService::ParseOptions(std::string const& threads,
+                                             std::string const& queuePolicy,
+                                             Options const& defaults)
+    {
+        Options options = defaults;
+        if (!threads.empty())
+        {
+            std::size_t parsed = 0;
+            unsigned long long value = 0;
+            if (threads.find_first_not_of("0123456789") == std::string::npos)
+            {
+                try
+                {
+                    value = std::stoull(threads, &parsed);
+                }
+                catch (std::out_of_range const&)
+                {
+                    parsed = 0;
+                }
+            }
+            if (parsed != threads.size())
+            {
+                throw std::invalid_argument("Invalid value '" + threads + "' for " + THREADPOOL_SIZE
+                                            + ", expected a non-negative number.");
+            }
+            options.threads = static_cast<std::size_t>(value);
+        }
+        if (queuePolicy == "work_stealing")
+        {
+            options.queuePolicy = QueuePolicy::WorkStealing;
+        }
+        else if (queuePolicy == "fifo")
+        {
+            options.queuePolicy = QueuePolicy::Fifo;
+        }
+        else if (!queuePolicy.empty())
+        {
+            throw std::invalid_argument("Invalid value '" + queuePolicy + "' for " + THREADPOOL_QUEUE_POLICY
+                                        + ", expected 'work_stealing' or 'fifo'.");
+        }
+        return options;
+    }
+
+    ThreadPoolAsyncWorkService::ThreadPoolAsyncWorkService(Options const& options)
+        : pool(std::make_shared<Pool>(options))
+    {
+        pool->Start();
+    }
+
+    ThreadPoolAsyncWorkService::~ThreadPoolAsyncWorkService() { pool->Shutdown(); }
+
+    void
+    ThreadPoolAsyncWorkService::post(std::packaged_task<void()>&& task)
+    {
+        pool->Post(std::move(task));
+    }
+
+    std::shared_ptr<AsyncWorkService>
+    ThreadPoolAsyncWorkService::createStrand()
+    {
+        return std::make_shared<Strand>(pool);
+    }
+
+    std::size_t
+    ThreadPoolAsyncWorkService::GetThreadCount() const
+    {
+        return pool->GetThreadCount();
+    }
+
+    ThreadPoolAsyncWorkService::Metrics
+    ThreadPoolAsyncWorkService::GetMetrics() const
+    {
+        return pool->GetMetrics();
+    }
+
+} // namespace cppmicroservices::async
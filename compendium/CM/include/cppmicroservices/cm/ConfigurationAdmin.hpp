@@ -24,9 +24,12 @@
 #define CppMicroServices_CM_ConfigurationAdmin_hpp
 
 #include "cppmicroservices/cm/Configuration.hpp"
+#include "cppmicroservices/cm/detail/UpdateBatch.hpp"
 
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cppmicroservices
@@ -101,6 +104,62 @@ namespace cppmicroservices
                  */
                 virtual std::vector<std::shared_ptr<Configuration>> ListConfigurations(std::string const& filter = {})
                     = 0;
+
+                /**
+                 * Update the properties of many Configuration objects at once. For each PID, the Configuration
+                 * is obtained as if by GetConfiguration and its properties are replaced as if by
+                 * Configuration::Update. If a PID occurs more than once, only its last properties are used.
+                 *
+                 * All of the updates are applied before any ManagedService, ManagedServiceFactory or
+                 * ConfigurationListener is notified, and ListConfigurations and other batches observe either none
+                 * or all of them. Each of these services is then notified at most once per updated PID, with the
+                 * latest properties of that PID.
+                 *
+                 * @param updates The PIDs to update, together with their new properties.
+                 *
+                 * @remarks The shared_ptr<ThreadpoolSafeFuture> returned can contain a
+                 * cppmicroservices::SecurityException if the Configuration caused a bundle's shared library to be
+                 * loaded and the bundle failed a security check.
+                 *
+                 * @return a shared_ptr<ThreadpoolSafeFuture> which can be used to wait for the asynchronous
+                 * operation that pushed the updates to the ManagedServices, ManagedServiceFactories and
+                 * ConfigurationListeners to complete. This can be safely done from within a thread allocated to the
+                 * AsyncWorkService.
+                 *
+                 * @remarks The default implementation updates the Configurations one after the other, as if by
+                 * Configuration::SafeUpdate, so the services may observe and be notified of part of the updates
+                 * before the others.
+                 */
+                virtual std::shared_ptr<ThreadpoolSafeFuture>
+                SafeUpdateBatch(std::vector<std::pair<std::string, AnyMap>> updates)
+                {
+                    std::vector<std::shared_ptr<ThreadpoolSafeFuture>> futures;
+                    for (auto& update : detail::LastUpdates(updates))
+                    {
+                        futures.push_back(GetConfiguration(update->first)->SafeUpdate(std::move(update->second)));
+                    }
+                    return std::make_shared<detail::AllUpdatesFuture>(std::move(futures));
+                }
+
+                /**
+                 * Same as SafeUpdateBatch() except:
+                 * @return a std::shared_future<void> that is unsafe to wait on from within a thread allocated to the
+                 * AsyncWorkService
+                 *
+                 * @remarks The default implementation updates the Configurations one after the other, as if by
+                 * Configuration::Update. The future it returns is ready once all of the updates are, and is not
+                 * deferred: wait_for reports whether they completed.
+                 */
+                virtual std::shared_future<void>
+                UpdateBatch(std::vector<std::pair<std::string, AnyMap>> updates)
+                {
+                    std::vector<std::shared_future<void>> futures;
+                    for (auto& update : detail::LastUpdates(updates))
+                    {
+                        futures.push_back(GetConfiguration(update->first)->Update(std::move(update->second)));
+                    }
+                    return detail::AllUpdates(std::move(futures));
+                }
             };
         } // namespace cm
     }     // namespace service
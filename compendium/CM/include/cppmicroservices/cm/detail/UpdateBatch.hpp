@@ -0,0 +1,172 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#ifndef CppMicroServices_CM_detail_UpdateBatch_hpp
+#define CppMicroServices_CM_detail_UpdateBatch_hpp
+
+#include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/ThreadpoolSafeFuture.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace service
+    {
+        namespace cm
+        {
+            namespace detail
+            {
+                /**
+                 * A ThreadpoolSafeFuture which is ready when all of the given futures are ready.
+                 */
+                class AllUpdatesFuture : public ThreadpoolSafeFuture
+                {
+                  public:
+                    explicit AllUpdatesFuture(std::vector<std::shared_ptr<ThreadpoolSafeFuture>> futures)
+                        : futures(std::move(futures))
+                    {
+                    }
+
+                    void
+                    get() const override
+                    {
+                        for (auto const& future : futures)
+                        {
+                            future->get();
+                        }
+                    }
+
+                    void
+                    wait() const override
+                    {
+                        for (auto const& future : futures)
+                        {
+                            future->wait();
+                        }
+                    }
+
+                    std::future_status
+                    wait_for(std::uint32_t const& timeout_duration_ms) const override
+                    {
+                        using namespace std::chrono;
+                        auto const deadline = steady_clock::now() + milliseconds(timeout_duration_ms);
+                        for (auto const& future : futures)
+                        {
+                            auto const now = steady_clock::now();
+                            auto const remaining
+                                = now < deadline ? ceil<milliseconds>(deadline - now).count() : milliseconds::rep(0);
+                            if (future->wait_for(static_cast<std::uint32_t>(remaining)) != std::future_status::ready)
+                            {
+                                return std::future_status::timeout;
+                            }
+                        }
+                        return std::future_status::ready;
+                    }
+
+                  private:
+                    std::vector<std::shared_ptr<ThreadpoolSafeFuture>> futures;
+                };
+
+                /**
+                 * Returns a future which is ready when all of the given futures are ready, and which holds the
+                 * first exception they hold, if any.
+                 *
+                 * If all of the futures are ready already, so is the returned future. Otherwise it is completed
+                 * asynchronously, so that it reports its status to wait_for like any other pending future.
+                 */
+                inline std::shared_future<void>
+                AllUpdates(std::vector<std::shared_future<void>> futures)
+                {
+                    bool allReady = true;
+                    for (auto const& future : futures)
+                    {
+                        if (future.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+                        {
+                            allReady = false;
+                            break;
+                        }
+                    }
+                    if (!allReady)
+                    {
+                        return std::async(std::launch::async,
+                                          [futures = std::move(futures)]
+                                          {
+                                              for (auto const& future : futures)
+                                              {
+                                                  future.get();
+                                              }
+                                          })
+                            .share();
+                    }
+
+                    std::promise<void> ready;
+                    try
+                    {
+                        for (auto const& future : futures)
+                        {
+                            future.get();
+                        }
+                        ready.set_value();
+                    }
+                    catch (...)
+                    {
+                        ready.set_exception(std::current_exception());
+                    }
+                    return ready.get_future().share();
+                }
+
+                /**
+                 * Returns the last update of each PID in updates, in the order of these last updates.
+                 */
+                inline std::vector<std::pair<std::string, AnyMap>*>
+                LastUpdates(std::vector<std::pair<std::string, AnyMap>>& updates)
+                {
+                    std::unordered_map<std::string, std::size_t> lastIndices;
+                    for (std::size_t i = 0; i < updates.size(); ++i)
+                    {
+                        lastIndices[updates[i].first] = i;
+                    }
+                    std::vector<std::pair<std::string, AnyMap>*> lastUpdates;
+                    for (std::size_t i = 0; i < updates.size(); ++i)
+                    {
+                        if (lastIndices[updates[i].first] == i)
+                        {
+                            lastUpdates.push_back(&updates[i]);
+                        }
+                    }
+                    return lastUpdates;
+                }
+            } // namespace detail
+        }     // namespace cm
+    }         // namespace service
+} // namespace cppmicroservices
+
+#endif // CppMicroServices_CM_detail_UpdateBatch_hpp
@@ -23,6 +23,8 @@
 #include <functional>
 #include <stdexcept>
 
+#include "cppmicroservices/Constants.h"
+
 #include "CMActivator.hpp"
 #include "CMConstants.hpp"
 
@@ -41,8 +43,11 @@ namespace cppmicroservices
             logger->Log(SeverityLevel::LOG_DEBUG, "Starting CM bundle");
             // Create the AsyncWorkService object used by this runtime
             asyncWorkService = std::make_shared<CMAsyncWorkService>(context, logger);
-            // Create ConfigurationAdminImpl
-            configAdminImpl = std::make_shared<ConfigurationAdminImpl>(runtimeContext, logger, asyncWorkService);
+            // Create ConfigurationAdminImpl, which restores any persisted configurations
+            configAdminImpl = std::make_shared<ConfigurationAdminImpl>(runtimeContext,
+                                                                       logger,
+                                                                       asyncWorkService,
+                                                                       CreateConfigurationStore(context));
             activatorStopped = std::make_shared<bool>(false);
             notificationLock = std::make_shared<std::shared_mutex>();
             // Add bundle listener
@@ -70,6 +75,25 @@ namespace cppmicroservices
                 = context.RegisterService<cppmicroservices::service::cm::ConfigurationAdmin>(configAdminImpl);
         }
 
+        std::shared_ptr<ConfigurationStore>
+        CMActivator::CreateConfigurationStore(cppmicroservices::BundleContext const& context)
+        {
+            auto const persistence = context.GetProperty(CMConstants::CM_PERSISTENCE);
+            if (persistence.Empty() || persistence.Type() != typeid(bool) || !any_cast<bool>(persistence))
+            {
+                return nullptr;
+            }
+            auto const storage = context.GetProperty(Constants::FRAMEWORK_STORAGE);
+            auto directory = storage.Type() == typeid(std::string) ? any_cast<std::string>(storage) : std::string {};
+            if (!directory.empty())
+            {
+                directory += "/";
+            }
+            directory += CMConstants::CM_PERSISTENCE_DIRECTORY;
+            logger->Log(SeverityLevel::LOG_DEBUG, "Persisting configurations in " + directory);
+            return std::make_shared<ConfigurationStore>(std::move(directory), logger);
+        }
+
         void
         CMActivator::Stop(cppmicroservices::BundleContext context)
         {
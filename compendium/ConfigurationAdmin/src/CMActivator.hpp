@@ -78,6 +78,12 @@ namespace cppmicroservices
             void RemoveExtension(cppmicroservices::Bundle const& bundle);
 
           private:
+            /*
+             * Creates the store used to persist configurations if this is enabled
+             * by the CMConstants::CM_PERSISTENCE framework property.
+             */
+            std::shared_ptr<ConfigurationStore> CreateConfigurationStore(cppmicroservices::BundleContext const& context);
+
             cppmicroservices::BundleContext runtimeContext;
             std::shared_ptr<CMLogger> logger;
             std::shared_ptr<CMAsyncWorkService> asyncWorkService;
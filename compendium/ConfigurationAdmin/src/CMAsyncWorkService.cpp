@@ -22,17 +22,17 @@
 
 #include "CMAsyncWorkService.hpp"
 
-#include "boost/asio/async_result.hpp"
-#include "boost/asio/packaged_task.hpp"
-#include "boost/asio/post.hpp"
-#include "boost/asio/thread_pool.hpp"
-#include <boost/asio/strand.hpp>
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
+
+#include <stdexcept>
 
 namespace cppmicroservices
 {
     namespace cmimpl
     {
         using AWSInt = cppmicroservices::async::AsyncWorkService;
+        using cppmicroservices::async::ThreadPoolAsyncWorkService;
+
         /**
          * FallbackAsyncWorkService represents the fallback strategy in the event
          * that a AsyncWorkService is not present within the framework. It implements
@@ -43,18 +43,11 @@ namespace cppmicroservices
         class FallbackAsyncWorkService final : public AWSInt
         {
           public:
-            using Strand = boost::asio::strand<boost::asio::thread_pool::executor_type>;
-
-            FallbackAsyncWorkService(std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
-                : logger(logger_)
-            {
-                Initialize();
-            }
-
-            void
-            Initialize()
+            FallbackAsyncWorkService(ThreadPoolAsyncWorkService::Options const& options,
+                                     std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
+                : threadpool(std::make_unique<ThreadPoolAsyncWorkService>(options))
+                , logger(logger_)
             {
-                threadpool = std::make_shared<boost::asio::thread_pool>(1);
             }
 
             void
@@ -64,8 +57,6 @@ namespace cppmicroservices
                 {
                     try
                     {
-                        threadpool->join();
-                        threadpool->stop();
                         threadpool.reset();
                     }
                     catch (...)
@@ -86,47 +77,53 @@ namespace cppmicroservices
             {
                 if (threadpool)
                 {
-                    boost::asio::post(threadpool->get_executor(), [task = std::move(task)]() mutable { task(); });
+                    threadpool->post(std::move(task));
                 }
             }
 
-            // createStrand returns a new AsyncWorkService instance posting to a strand
+            // createStrand returns a new AsyncWorkService instance running its tasks in order on the threadpool
             std::shared_ptr<AsyncWorkService>
             createStrand() override
             {
-                if (!threadpool)
-                {
-                    return nullptr;
-                }
-                auto strand = std::make_shared<Strand>(threadpool->get_executor());
-                // Pass shared_ptr to threadpool to keep it alive as long as strand is alive
-                return std::make_shared<StrandAsyncWorkService>(strand);
+                return threadpool ? threadpool->createStrand() : nullptr;
             }
 
           private:
-            std::shared_ptr<boost::asio::thread_pool> threadpool;
+            std::unique_ptr<ThreadPoolAsyncWorkService> threadpool;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+        };
 
-            // Inner class for strand-based async work service
-            class StrandAsyncWorkService : public AsyncWorkService
+        /**
+         * Reads the options of the fallback threadpool from the framework properties, using one
+         * thread and work stealing unless configured otherwise.
+         */
+        ThreadPoolAsyncWorkService::Options
+        GetFallbackOptions(cppmicroservices::BundleContext const& context,
+                           std::shared_ptr<cppmicroservices::logservice::LogService> const& logger)
+        {
+            ThreadPoolAsyncWorkService::Options defaults;
+            defaults.threads = 1;
+            auto property = [&context](std::string const& name)
             {
-              public:
-                StrandAsyncWorkService(std::shared_ptr<Strand> strand_) : strand(std::move(strand_)) {}
-
-                void
-                post(std::packaged_task<void()>&& task) override
-                {
-                    if (strand)
-                    {
-                        boost::asio::post(*strand, [task = std::move(task)]() mutable { task(); });
-                    }
-                }
-
-              private:
-                std::shared_ptr<Strand> strand;
-                std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+                auto const value = context.GetProperty(name);
+                return value.Empty() ? std::string() : value.ToStringNoExcept();
             };
-        };
+            try
+            {
+                using Pool = ThreadPoolAsyncWorkService;
+                return Pool::ParseOptions(property(Pool::THREADPOOL_SIZE),
+                                          property(Pool::THREADPOOL_QUEUE_POLICY),
+                                          defaults);
+            }
+            catch (std::invalid_argument const&)
+            {
+                logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                            "Ignoring the invalid threadpool configuration of the fallback "
+                            "cppmicroservices::async::AsyncWorkService.",
+                            std::current_exception());
+                return defaults;
+            }
+        }
 
         CMAsyncWorkService::CMAsyncWorkService(cppmicroservices::BundleContext context,
                                                std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
@@ -135,6 +132,7 @@ namespace cppmicroservices
             , usingFallback(true)
             , asyncWorkService(nullptr)
             , logger(logger_)
+            , fallbackOptions(GetFallbackOptions(context, logger_))
         {
             {
                 if (auto asyncWSSRef = context.GetServiceReference<AWSInt>(); asyncWSSRef)
@@ -146,7 +144,7 @@ namespace cppmicroservices
                 else
                 {
                     usingFallback = true;
-                    asyncWorkService = std::make_shared<FallbackAsyncWorkService>(logger_);
+                    asyncWorkService = std::make_shared<FallbackAsyncWorkService>(fallbackOptions, logger_);
                 }
             }
             serviceTracker->Open();
@@ -213,7 +211,7 @@ namespace cppmicroservices
                 currRef = ServiceReference<AWSInt>();
                 usingFallback = true;
                 // replace existing asyncWorkService with a fallbackAsyncWorkService
-                asyncWorkService = std::make_shared<FallbackAsyncWorkService>(logger);
+                asyncWorkService = std::make_shared<FallbackAsyncWorkService>(fallbackOptions, logger);
             }
         }
 
@@ -26,6 +26,7 @@
 #include "CMLogger.hpp"
 #include <cppmicroservices/ServiceTracker.h>
 #include <cppmicroservices/asyncworkservice/AsyncWorkService.hpp>
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
 
 #include <future>
 
@@ -80,6 +81,8 @@ namespace cppmicroservices
             ServiceReference<AWSInt> currRef;
             std::shared_ptr<AWSInt> asyncWorkService;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+            // options of the threadpool used when no AsyncWorkService is registered
+            cppmicroservices::async::ThreadPoolAsyncWorkService::Options fallbackOptions;
         };
     } // namespace cmimpl
 } // namespace cppmicroservices
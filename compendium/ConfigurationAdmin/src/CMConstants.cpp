@@ -73,6 +73,17 @@ namespace cppmicroservices
              */
             const std::string CM_COMPONENT_SUBKEY = "name";
 
+            /**
+             * Framework property enabling the persistence of Configuration objects.
+             */
+            const std::string CM_PERSISTENCE = "org.cppmicroservices.cm.persistence";
+
+            /**
+             * Name of the directory within the framework storage area used to persist
+             * Configuration objects.
+             */
+            const std::string CM_PERSISTENCE_DIRECTORY = "cm";
+
         } // namespace CMConstants
     }     // namespace cmimpl
 } // namespace cppmicroservices
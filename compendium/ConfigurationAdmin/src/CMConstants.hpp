@@ -75,6 +75,21 @@ namespace cppmicroservices
              */
             extern const std::string CM_COMPONENT_SUBKEY;
 
+            /**
+             * Framework property enabling the persistence of Configuration objects. If it is set
+             * to {@code true}, Configuration objects are stored in the "cm" directory of the
+             * framework storage area (see {@code Constants::FRAMEWORK_STORAGE}) and restored when
+             * ConfigurationAdmin is started again, before any ManagedService or ManagedServiceFactory
+             * is notified.
+             */
+            extern const std::string CM_PERSISTENCE;
+
+            /**
+             * Name of the directory within the framework storage area used to persist
+             * Configuration objects.
+             */
+            extern const std::string CM_PERSISTENCE_DIRECTORY;
+
         } // namespace CMConstants
     }     // namespace cmimpl
 } // namespace cppmicroservices
@@ -21,6 +21,7 @@
  =============================================================================*/
 
 #include <cassert>
+#include <cctype>
 #include <memory>
 #include <stdexcept>
 #include <thread>
@@ -48,6 +49,40 @@ namespace
         return pid.substr(0, pos);
     }
 
+    /* Recognizes filters of the form "(pid=value)" and "(pid=value~*)", which
+     * can be answered from the configuration repository without evaluating the
+     * filter against every configuration. On success, value is the pid (or the
+     * factory pid, if isFactoryPrefix is true) to look up. Anything that might
+     * need the full LDAP semantics, such as wildcards other than a trailing
+     * "~*", escapes or whitespace, is left to the general path.
+     */
+    bool
+    parsePidFilter(std::string const& filter, std::string& value, bool& isFactoryPrefix)
+    {
+        static std::string const prefix = "(pid=";
+        if (filter.size() <= prefix.size() + 1 || filter.compare(0, prefix.size(), prefix) != 0
+            || filter.back() != ')')
+        {
+            return false;
+        }
+        auto candidate = filter.substr(prefix.size(), filter.size() - prefix.size() - 1);
+        isFactoryPrefix = candidate.size() > 2 && candidate.compare(candidate.size() - 2, 2, "~*") == 0;
+        if (isFactoryPrefix)
+        {
+            candidate.resize(candidate.size() - 2);
+        }
+        for (auto const c : candidate)
+        {
+            if (c == '*' || c == '\\' || c == '(' || c == ')' || std::isspace(static_cast<unsigned char>(c))
+                || (isFactoryPrefix && c == '~'))
+            {
+                return false;
+            }
+        }
+        value = std::move(candidate);
+        return true;
+    }
+
     void
     handleUpdatedException(std::string const& pid,
                            cppmicroservices::AnyMap const& properties,
@@ -209,15 +244,51 @@ namespace cppmicroservices
         ConfigurationAdminImpl::ConfigurationAdminImpl(
             cppmicroservices::BundleContext context,
             std::shared_ptr<cppmicroservices::logservice::LogService> const& lggr,
-            std::shared_ptr<AsyncWorkService> const& asyncWS)
+            std::shared_ptr<AsyncWorkService> const& asyncWS,
+            std::shared_ptr<ConfigurationStore> configurationStore)
             : cmContext(std::move(context))
             , logger(lggr)
             , asyncWorkService(asyncWS)
+            , store(std::move(configurationStore))
             , futuresID { 0u }
             , managedServiceTracker(cmContext, this)
             , managedServiceFactoryTracker(cmContext, this)
             , configListenerTracker(cmContext)
         {
+            // Persisted configurations are restored before the trackers are opened, so that
+            // ManagedServices are notified about them just like about any existing configuration.
+            if (store)
+            {
+                try
+                {
+                    auto storedConfigurations = store->Load();
+                    std::lock_guard<std::mutex> lk { configurationsMutex };
+                    for (auto& stored : storedConfigurations)
+                    {
+                        AddFactoryInstanceIfRequired(stored.pid, stored.factoryPid);
+                        configurations.emplace(stored.pid,
+                                               std::make_shared<ConfigurationImpl>(this,
+                                                                                   stored.pid,
+                                                                                   std::move(stored.factoryPid),
+                                                                                   std::move(stored.properties),
+                                                                                   asyncWorkService,
+                                                                                   ++instanceCount[stored.pid],
+                                                                                   stored.changeCount,
+                                                                                   store));
+                    }
+                    logger->Log(SeverityLevel::LOG_DEBUG,
+                                "Restored " + std::to_string(storedConfigurations.size())
+                                    + " persisted Configuration instances");
+                }
+                catch (std::exception const&)
+                {
+                    logger->Log(SeverityLevel::LOG_ERROR,
+                                "Failed to restore the persisted Configuration instances. Configurations will not be "
+                                "persisted.",
+                                std::current_exception());
+                    store = nullptr;
+                }
+            }
             managedServiceTracker.Open();
             managedServiceFactoryTracker.Open();
             configListenerTracker.Open();
@@ -248,6 +319,12 @@ namespace cppmicroservices
                 factoryInstancesCopy.swap(factoryInstances);
                 configurationsToInvalidate.swap(configurations);
             }
+            // Configuration objects held by clients may still be updated, but another
+            // ConfigurationAdmin could own the store by then.
+            if (store)
+            {
+                store->Close();
+            }
             for (auto const& configuration : configurationsToInvalidate)
             {
                 configuration.second->Invalidate();
@@ -324,7 +401,9 @@ namespace cppmicroservices
                                           std::move(factoryPid),
                                           AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS },
                                           asyncWorkService,
-                                          ++instanceCount[pid]))
+                                          ++instanceCount[pid],
+                                          0u,
+                                          store))
                              .first;
                     created = true;
                 }
@@ -358,7 +437,9 @@ namespace cppmicroservices
                                                                  factoryPid,
                                                                  AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS },
                                                                  asyncWorkService,
-                                                                 ++instanceCount[pid]))
+                                                                 ++instanceCount[pid],
+                                                                 0u,
+                                                                 store))
                          .first;
                 result = it->second;
             }
@@ -383,7 +464,8 @@ namespace cppmicroservices
          * be "pid=startup.options", (to search for a configuration object with a matching pid)
          * "pid=virtualfilesystem~user1", (to search for a configuration object with a matching factory pid)
          *  "key1=abc" (to search for a configuration object containing a property with key "key1" with a value "abc".
-         * Regular expressions are allowed.
+         * Regular expressions are allowed. Filters of the exact form "(pid=value)" or "(pid=value~*)"
+         * are answered from the pid and factory pid indexes instead of scanning every configuration.
          */
         std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>>
         ConfigurationAdminImpl::ListConfigurations(std::string const& filter)
@@ -409,22 +491,54 @@ namespace cppmicroservices
                 // filter is not empty so look for pid and property matches
                 LDAPFilter ldap { filter };
 
-                for (auto const& it : configurations)
+                // a filter on the pid or factory pid alone is answered from the
+                // repository's indexes
+                std::string pidValue;
+                bool isFactoryPrefix = false;
+                if (parsePidFilter(filter, pidValue, isFactoryPrefix))
                 {
-                    // configurations that have not yet been updated cannot be
-                    // returned.
-                    if (!it.second->HasBeenUpdatedAtLeastOnce())
+                    auto addIfUpdated = [this, &result](std::string const& pid)
                     {
-                        continue;
+                        auto const it = configurations.find(pid);
+                        if (it != configurations.end() && it->second->HasBeenUpdatedAtLeastOnce())
+                        {
+                            result.push_back(it->second);
+                        }
+                    };
+
+                    if (!isFactoryPrefix)
+                    {
+                        addIfUpdated(pidValue);
+                        return result;
+                    }
+
+                    // Factory instances are indexed by the factory pid they were created
+                    // with, which for CreateFactoryConfiguration may itself contain a '~'.
+                    // Every such factory pid starts with "pidValue~", so only those
+                    // entries (and the one for pidValue itself) need to be visited.
+                    auto const instancePrefix = pidValue + "~";
+                    std::set<std::string> pids;
+                    for (auto const& instances : factoryInstances)
+                    {
+                        if (instances.first == pidValue
+                            || instances.first.compare(0, instancePrefix.size(), instancePrefix) == 0)
+                        {
+                            pids.insert(instances.second.begin(), instances.second.end());
+                        }
                     }
-                    /* Build a single map containing both the pid and the configuration
-                     * properties so that the LDAP filter is evaluated against the full
-                     * set of attributes.
-                     */
-                    auto props = it.second->GetProperties();
-                    props["pid"] = it.first;
-
-                    if (ldap.Match(props))
+                    result.reserve(pids.size());
+                    for (auto const& pid : pids)
+                    {
+                        addIfUpdated(pid);
+                    }
+                    return result;
+                }
+
+                for (auto const& it : configurations)
+                {
+                    // configurations that have not yet been updated (or have been
+                    // removed) do not match.
+                    if (it.second->MatchesFilter(ldap))
                     {
                         result.emplace_back(it.second);
                     }
@@ -433,6 +547,109 @@ namespace cppmicroservices
             return result;
         }
 
+        std::shared_ptr<ThreadpoolSafeFuture>
+        ConfigurationAdminImpl::SafeUpdateBatch(std::vector<std::pair<std::string, AnyMap>> updates)
+        {
+            return SafeUpdateBatchImpl(std::move(updates));
+        }
+
+        std::shared_future<void>
+        ConfigurationAdminImpl::UpdateBatch(std::vector<std::pair<std::string, AnyMap>> updates)
+        {
+            return SafeUpdateBatchImpl(std::move(updates))->retrieveFuture();
+        }
+
+        /* SafeUpdateBatchImpl applies all of the updates while holding the configurationsMutex, so that
+         * ListConfigurations and other batches see either none or all of them. Instead of posting one
+         * notification task per pid, a single task notifies the tracked services of the whole batch.
+         */
+        std::shared_ptr<ThreadpoolSafeFuturePrivate>
+        ConfigurationAdminImpl::SafeUpdateBatchImpl(std::vector<std::pair<std::string, AnyMap>> updates)
+        {
+            // only the last update for each pid is applied
+            std::unordered_map<std::string, std::size_t> lastUpdate;
+            lastUpdate.reserve(updates.size());
+            for (std::size_t i = 0; i < updates.size(); ++i)
+            {
+                lastUpdate[updates[i].first] = i;
+            }
+
+            std::vector<std::pair<std::string, unsigned long>> pidsAndChangeCounts;
+            pidsAndChangeCounts.reserve(lastUpdate.size());
+            std::vector<std::shared_ptr<ConfigurationImpl>> configurationsToInvalidate;
+            {
+                std::lock_guard<std::mutex> lk { configurationsMutex };
+                for (std::size_t i = 0; i < updates.size(); ++i)
+                {
+                    auto& [pid, properties] = updates[i];
+                    if (lastUpdate.find(pid)->second != i)
+                    {
+                        continue;
+                    }
+                    auto it = configurations.find(pid);
+                    if (it != std::end(configurations))
+                    {
+                        try
+                        {
+                            auto const changeCount = it->second->UpdateWithoutNotification(std::move(properties));
+                            pidsAndChangeCounts.emplace_back(pid, changeCount);
+                            continue;
+                        }
+                        catch (std::runtime_error const&) // Configuration has been Removed by someone else, but we've
+                                                          // won the race to handle that.
+                        {
+                            configurationsToInvalidate.push_back(std::move(it->second));
+                        }
+                    }
+
+                    auto factoryPid = getFactoryPid(pid);
+                    AddFactoryInstanceIfRequired(pid, factoryPid);
+                    if (store)
+                    {
+                        store->RecordUpdate(pid, factoryPid, properties, 1u);
+                    }
+                    // construct the Configuration Object with a changeCount of 1, the
+                    // update counts as a create and an update operation even if the
+                    // properties are empty.
+                    auto newConfig = std::make_shared<ConfigurationImpl>(this,
+                                                                         pid,
+                                                                         std::move(factoryPid),
+                                                                         std::move(properties),
+                                                                         asyncWorkService,
+                                                                         ++instanceCount[pid],
+                                                                         1u,
+                                                                         store);
+                    pidsAndChangeCounts.emplace_back(pid, newConfig->GetChangeCount());
+                    if (it != std::end(configurations))
+                    {
+                        it->second = std::move(newConfig);
+                    }
+                    else
+                    {
+                        configurations.emplace(pid, std::move(newConfig));
+                    }
+                }
+            }
+            // This cannot be called whilst holding the configurationsMutex as it could cause a deadlock.
+            for (auto const& configurationToInvalidate : configurationsToInvalidate)
+            {
+                configurationToInvalidate->Invalidate();
+            }
+            logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                        "UpdateBatch: updated " + std::to_string(pidsAndChangeCounts.size())
+                            + " Configuration instances");
+
+            if (pidsAndChangeCounts.empty())
+            {
+                std::promise<void> ready;
+                std::shared_future<void> fut = ready.get_future();
+                ready.set_value();
+                return std::make_shared<ThreadpoolSafeFuturePrivate>(fut);
+            }
+            return PerformAsync([this, pidsAndChangeCounts = std::move(pidsAndChangeCounts)]
+                                { NotifyConfigurationsUpdated(pidsAndChangeCounts); });
+        }
+
         std::vector<ConfigurationAddedInfo>
         ConfigurationAdminImpl::AddConfigurations(std::vector<metadata::ConfigurationMetadata> configurationMetadata)
         {
@@ -461,9 +678,14 @@ namespace cppmicroservices
                                                                              configMetadata.properties,
                                                                              asyncWorkService,
                                                                              ++instanceCount[pid],
-                                                                             1u);
+                                                                             1u,
+                                                                             store);
                         changeCount = newConfig->GetChangeCount();
                         it = configurations.emplace(pid, std::move(newConfig)).first;
+                        if (store)
+                        {
+                            store->RecordUpdate(pid, getFactoryPid(pid), configMetadata.properties, changeCount);
+                        }
                         pidsAndChangeCountsAndIDs.emplace_back(pid,
                                                                changeCount,
                                                                reinterpret_cast<std::uintptr_t>(it->second.get()));
@@ -490,7 +712,16 @@ namespace cppmicroservices
                                                                          getFactoryPid(pid),
                                                                          configMetadata.properties,
                                                                          asyncWorkService,
-                                                                         ++instanceCount[pid]);
+                                                                         ++instanceCount[pid],
+                                                                         0u,
+                                                                         store);
+                        if (store && it->second->HasBeenUpdatedAtLeastOnce())
+                        {
+                            store->RecordUpdate(pid,
+                                                getFactoryPid(pid),
+                                                configMetadata.properties,
+                                                it->second->GetChangeCount());
+                        }
                         pidsAndChangeCountsAndIDs.emplace_back(pid,
                                                                changeCount,
                                                                reinterpret_cast<std::uintptr_t>(it->second.get()));
@@ -616,143 +847,178 @@ namespace cppmicroservices
             // is not available and that method cannot be called. For this reason, NotifyConfigurationUpdated
             // should not be called for Remove operations unless the caller has already confirmed
             // the configuration object has been updated at least once.
-            return PerformAsync(
-                [this, pid, changeCount]
+            return PerformAsync([this, pid, changeCount] { NotifyConfigurationsUpdated({ { pid, changeCount } }); },
+                                strand);
+        }
+
+        void
+        ConfigurationAdminImpl::NotifyConfigurationsUpdated(
+            std::vector<std::pair<std::string, unsigned long>> const& pidsAndChangeCounts)
+        {
+            using ManagedServiceWrapper = TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>;
+            using ManagedServiceFactoryWrapper
+                = TrackedServiceWrapper<cppmicroservices::service::cm::ManagedServiceFactory>;
+
+            struct ConfigurationState
+            {
+                std::string const& pid;
+                unsigned long changeCount;
+                AnyMap properties;
+                bool removed;
+            };
+            std::vector<ConfigurationState> states;
+            states.reserve(pidsAndChangeCounts.size());
+            std::unordered_map<std::string, std::vector<std::shared_ptr<ManagedServiceWrapper>>> managedServicesByPid;
+            std::unordered_map<std::string, std::vector<std::shared_ptr<ManagedServiceFactoryWrapper>>>
+                managedServiceFactoriesByPid;
+            {
+                std::lock_guard<std::mutex> lk { configurationsMutex };
+                for (auto const& [pid, changeCount] : pidsAndChangeCounts)
                 {
                     AnyMap properties { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
-                    std::string fPid;
-                    std::string nonFPid;
                     auto removed = false;
                     auto hasBeenUpdated = false;
-                    std::vector<std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedService>>>
-                        managedServiceWrappers;
-                    std::vector<
-                        std::shared_ptr<TrackedServiceWrapper<cppmicroservices::service::cm::ManagedServiceFactory>>>
-                        managedServiceFactoryWrappers;
+                    auto const it = configurations.find(pid);
+                    if (it == std::end(configurations))
                     {
-                        std::lock_guard<std::mutex> lk { configurationsMutex };
-                        auto const it = configurations.find(pid);
-                        if (it == std::end(configurations))
+                        removed = true;
+                        hasBeenUpdated = true;
+                    }
+                    else
+                    {
+                        try
                         {
-                            removed = true;
-                            hasBeenUpdated = true;
+                            hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
+                            properties = it->second->GetProperties();
                         }
-                        else
+                        catch (std::runtime_error const&)
                         {
-                            try
-                            {
-                                hasBeenUpdated = it->second->HasBeenUpdatedAtLeastOnce();
-                                properties = it->second->GetProperties();
-                            }
-                            catch (std::runtime_error const&)
-                            {
-                                // Configuration is being removed
-                                removed = true;
-                            }
+                            // Configuration is being removed
+                            removed = true;
                         }
+                    }
 
-                        // We can only send update notifications for configuration objects that have
-                        // been updated. Just return without sending the notification for objects
-                        // that have not yet been updated.
-                        if (!hasBeenUpdated)
-                        {
-                            return;
-                        }
+                    // We can only send update notifications for configuration objects that have
+                    // been updated. Skip the configuration objects that have not yet been updated.
+                    if (hasBeenUpdated)
+                    {
+                        states.push_back(ConfigurationState { pid, changeCount, std::move(properties), removed });
+                    }
+                }
+                if (states.empty())
+                {
+                    return;
+                }
 
-                        if (pid.find('~') != std::string::npos)
-                        {
-                            // this is a factory pid
-                            fPid = pid;
-                        }
-                        else
-                        {
-                            nonFPid = pid;
-                        }
-                        managedServiceWrappers = trackedManagedServices_;
-                        managedServiceFactoryWrappers = trackedManagedServiceFactories_;
+                // Index the tracked services by pid, so that each configuration only visits the services
+                // it is meant for, however many configurations are notified at once.
+                // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
+                // or ManagedServiceFactory that we aren't tracking. We must be careful not to dereference these!
+                for (auto const& managedServiceWrapper : trackedManagedServices_)
+                {
+                    if (managedServiceWrapper)
+                    {
+                        managedServicesByPid[managedServiceWrapper->getPid()].push_back(managedServiceWrapper);
                     }
+                }
+                for (auto const& managedServiceFactoryWrapper : trackedManagedServiceFactories_)
+                {
+                    if (managedServiceFactoryWrapper)
+                    {
+                        managedServiceFactoriesByPid[managedServiceFactoryWrapper->getPid()].push_back(
+                            managedServiceFactoryWrapper);
+                    }
+                }
+            }
+
+            auto configurationListeners = configListenerTracker.GetServices();
+            auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
+            for (auto const& state : states)
+            {
+                auto const& pid = state.pid;
+                auto const changeCount = state.changeCount;
+                auto const removed = state.removed;
+                auto const& properties = state.properties;
+
+                std::string fPid;
+                std::string nonFPid;
+                if (pid.find('~') != std::string::npos)
+                {
+                    // this is a factory pid
+                    fPid = pid;
+                }
+                else
+                {
+                    nonFPid = pid;
+                }
+
+                auto type = removed ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
+                                    : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
 
-                    auto type = removed ? cppmicroservices::service::cm::ConfigurationEventType::CM_DELETED
-                                        : cppmicroservices::service::cm::ConfigurationEventType::CM_UPDATED;
+                for (auto const& it : configurationListeners)
+                {
+                    auto configEvent
+                        = cppmicroservices::service::cm::ConfigurationEvent(configAdminRef, type, fPid, nonFPid);
+                    it->configurationEvent((configEvent));
+                }
 
-                    auto configurationListeners = configListenerTracker.GetServices();
-                    auto configAdminRef = cmContext.GetServiceReference<ConfigurationAdmin>();
-                    for (auto const& it : configurationListeners)
+                if (auto const it = managedServicesByPid.find(pid); it != std::end(managedServicesByPid))
+                {
+                    for (auto const& managedServiceWrapper : it->second)
                     {
-                        auto configEvent
-                            = cppmicroservices::service::cm::ConfigurationEvent(configAdminRef, type, fPid, nonFPid);
-                        it->configurationEvent((configEvent));
+                        if (removed || managedServiceWrapper->needsAnUpdateNotification(pid, changeCount))
+                        {
+                            notifyServiceUpdated(pid,
+                                                 *(managedServiceWrapper->getTrackedService()),
+                                                 properties,
+                                                 *logger);
+                            if (removed)
+                            {
+                                managedServiceWrapper->removeLastUpdatedChangeCount(pid);
+                            }
+                            else
+                            {
+                                managedServiceWrapper->setLastUpdatedChangeCount(pid, changeCount);
+                            }
+                        }
                     }
+                }
 
-                    std::for_each(
-                        managedServiceWrappers.begin(),
-                        managedServiceWrappers.end(),
-                        [&](auto const& managedServiceWrapper)
+                if (auto const factoryPid = getFactoryPid(pid); !factoryPid.empty())
+                {
+                    if (auto const it = managedServiceFactoriesByPid.find(factoryPid);
+                        it != std::end(managedServiceFactoriesByPid))
+                    {
+                        for (auto const& managedServiceFactoryWrapper : it->second)
                         {
-                            // The ServiceTracker will return a default constructed shared_ptr for each ManagedService
-                            // that we aren't tracking. We must be careful not to dereference these!
-                            if ((managedServiceWrapper) && (managedServiceWrapper->getPid() == pid)
-                                && (removed
-                                    || (!removed
-                                        && managedServiceWrapper->needsAnUpdateNotification(pid, changeCount))))
+                            if (removed)
+                            {
+                                notifyServiceRemoved(pid,
+                                                     *(managedServiceFactoryWrapper->getTrackedService()),
+                                                     *logger);
+                                managedServiceFactoryWrapper->removeLastUpdatedChangeCount(pid);
+                            }
+                            else if (managedServiceFactoryWrapper->needsAnUpdateNotification(pid, changeCount))
                             {
                                 notifyServiceUpdated(pid,
-                                                     *(managedServiceWrapper->getTrackedService()),
+                                                     *(managedServiceFactoryWrapper->getTrackedService()),
                                                      properties,
                                                      *logger);
-                                if (removed)
-                                {
-                                    managedServiceWrapper->removeLastUpdatedChangeCount(pid);
-                                }
-                                else
-                                {
-                                    managedServiceWrapper->setLastUpdatedChangeCount(pid, changeCount);
-                                }
+                                managedServiceFactoryWrapper->setLastUpdatedChangeCount(pid, changeCount);
                             }
-                        });
-
-                    if (auto const factoryPid = getFactoryPid(pid); !factoryPid.empty())
-                    {
-                        std::for_each(
-                            managedServiceFactoryWrappers.begin(),
-                            managedServiceFactoryWrappers.end(),
-                            [&](auto const& managedServiceFactoryWrapper)
-                            {
-                                // The ServiceTracker will return a default constructed shared_ptr for each
-                                // ManagedServiceFactory that we aren't tracking. We must be careful not to dereference
-                                // these!
-                                if ((managedServiceFactoryWrapper)
-                                    && (managedServiceFactoryWrapper->getPid() == factoryPid))
-                                {
-                                    if (removed)
-                                    {
-                                        notifyServiceRemoved(pid,
-                                                             *(managedServiceFactoryWrapper->getTrackedService()),
-                                                             *logger);
-                                        managedServiceFactoryWrapper->removeLastUpdatedChangeCount(pid);
-                                    }
-                                    else if (managedServiceFactoryWrapper->needsAnUpdateNotification(pid, changeCount))
-                                    {
-                                        notifyServiceUpdated(pid,
-                                                             *(managedServiceFactoryWrapper->getTrackedService()),
-                                                             properties,
-                                                             *logger);
-                                        managedServiceFactoryWrapper->setLastUpdatedChangeCount(pid, changeCount);
-                                    }
-                                }
-                            });
+                        }
                     }
-                    if (!removed)
-                    {
-                        std::ostringstream configValue;
-                        any_value_to_json(configValue, properties);
+                }
+                if (!removed)
+                {
+                    std::ostringstream configValue;
+                    any_value_to_json(configValue, properties);
 
-                        logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
-                                    "Configuration Updated: Configuration instance with PID " + pid + " version: "
-                                        + std::to_string(changeCount) + " properties: " + configValue.str());
-                    }
-                },
-                strand);
+                    logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_DEBUG,
+                                "Configuration Updated: Configuration instance with PID " + pid + " version: "
+                                    + std::to_string(changeCount) + " properties: " + configValue.str());
+                }
+            }
         }
 
         std::shared_ptr<ThreadpoolSafeFuturePrivate>
@@ -43,6 +43,7 @@
 
 #include "ConfigurationAdminPrivate.hpp"
 #include "ConfigurationImpl.hpp"
+#include "ConfigurationStore.hpp"
 #include "ThreadpoolSafeFuturePrivate.hpp"
 
 namespace cppmicroservices
@@ -135,7 +136,8 @@ namespace cppmicroservices
           public:
             ConfigurationAdminImpl(cppmicroservices::BundleContext cmContext,
                                    std::shared_ptr<cppmicroservices::logservice::LogService> const& logger,
-                                   std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWorkService);
+                                   std::shared_ptr<cppmicroservices::async::AsyncWorkService> const& asyncWorkService,
+                                   std::shared_ptr<ConfigurationStore> configurationStore = nullptr);
             ~ConfigurationAdminImpl() override;
             ConfigurationAdminImpl(ConfigurationAdminImpl const&) = delete;
             ConfigurationAdminImpl& operator=(ConfigurationAdminImpl const&) = delete;
@@ -179,6 +181,26 @@ namespace cppmicroservices
             std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>> ListConfigurations(
                 std::string const& filter = std::string {}) override;
 
+            /**
+             * Update the properties of many {@code Configuration} objects at once and send one coalesced
+             * notification for all of them.
+             *
+             * See {@code ConfigurationAdmin#SafeUpdateBatch}
+             */
+            std::shared_ptr<ThreadpoolSafeFuture> SafeUpdateBatch(
+                std::vector<std::pair<std::string, AnyMap>> updates) override;
+            std::shared_ptr<ThreadpoolSafeFuturePrivate> SafeUpdateBatchImpl(
+                std::vector<std::pair<std::string, AnyMap>> updates);
+
+            /**
+             * Same as SafeUpdateBatch, except:
+             * @return a std::shared_future<void>
+             * @note not safe to wait on future from within the AsyncWorkService
+             *
+             * See {@code ConfigurationAdmin#UpdateBatch}
+             */
+            std::shared_future<void> UpdateBatch(std::vector<std::pair<std::string, AnyMap>> updates) override;
+
             /**
              * Internal method used by {@code CMBundleExtension} to add new {@code Configuration} objects
              *
@@ -257,6 +279,11 @@ namespace cppmicroservices
                                                                       std::shared_ptr<AsyncWorkService> strand
                                                                       = nullptr);
 
+            // Notifies the ConfigurationListeners and any matching ManagedService or ManagedServiceFactory
+            // of the latest state of each of the given configurations. Runs on the async work service.
+            void NotifyConfigurationsUpdated(
+                std::vector<std::pair<std::string, unsigned long>> const& pidsAndChangeCounts);
+
             // Flag set to false when the activator has stopped the bundle
             bool active = true;
 
@@ -270,6 +297,7 @@ namespace cppmicroservices
             cppmicroservices::BundleContext cmContext;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
             std::shared_ptr<cppmicroservices::async::AsyncWorkService> asyncWorkService;
+            std::shared_ptr<ConfigurationStore> store; ///< persists the configurations, if enabled
             std::mutex configurationsMutex;
             std::unordered_map<std::string, std::shared_ptr<ConfigurationImpl>> configurations;
             std::unordered_map<std::string, unsigned long> instanceCount;
@@ -21,6 +21,7 @@
  =============================================================================*/
 
 #include "ConfigurationImpl.hpp"
+#include "cppmicroservices/detail/ScopeGuard.h"
 #include <cassert>
 #include <future>
 #include <sstream>
@@ -41,7 +42,8 @@ namespace cppmicroservices
                                              AnyMap props,
                                              std::shared_ptr<AsyncWorkService> aws,
                                              unsigned long const iCount,
-                                             unsigned long const cCount)
+                                             unsigned long const cCount,
+                                             std::shared_ptr<ConfigurationStore> configurationStore)
             : strand(aws->createStrand())
             , configAdminImpl(configAdmin)
             , pid(std::move(thePid))
@@ -50,6 +52,7 @@ namespace cppmicroservices
             , changeCount { cCount }
             , removed { false }
             , instance { iCount }
+            , store(std::move(configurationStore))
         {
             assert(configAdminImpl != nullptr && "Invalid ConfigurationAdminPrivate pointer");
             // constructing a configuration object with properties is the equivalent
@@ -127,6 +130,10 @@ namespace cppmicroservices
                 }
                 properties = std::move(newProperties);
                 ++changeCount;
+                if (store)
+                {
+                    store->RecordUpdate(pid, factoryPid, properties, changeCount);
+                }
             }
             std::lock_guard<std::mutex> lk { configAdminMutex };
             if (configAdminImpl)
@@ -200,6 +207,10 @@ namespace cppmicroservices
                     throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
                 }
                 removed = true;
+                if (store)
+                {
+                    store->RecordRemove(pid);
+                }
             }
             std::lock_guard<std::mutex> lk { configAdminMutex };
             if (configAdminImpl)
@@ -229,7 +240,29 @@ namespace cppmicroservices
                 return std::pair<bool, unsigned long> { false, 0u };
             }
             properties = std::move(newProperties);
-            return std::pair<bool, unsigned long> { true, ++changeCount };
+            ++changeCount;
+            if (store)
+            {
+                store->RecordUpdate(pid, factoryPid, properties, changeCount);
+            }
+            return std::pair<bool, unsigned long> { true, changeCount };
+        }
+
+        unsigned long
+        ConfigurationImpl::UpdateWithoutNotification(AnyMap&& newProperties)
+        {
+            std::lock_guard<std::mutex> lk { propertiesMutex };
+            if (removed)
+            {
+                throw std::runtime_error(REMOVED_EXCEPTION_MESSAGE);
+            }
+            properties = std::move(newProperties);
+            ++changeCount;
+            if (store)
+            {
+                store->RecordUpdate(pid, factoryPid, properties, changeCount);
+            }
+            return changeCount;
         }
 
         bool
@@ -243,6 +276,10 @@ namespace cppmicroservices
             if (expectedChangeCount == changeCount)
             {
                 removed = true;
+                if (store)
+                {
+                    store->RecordRemove(pid);
+                }
                 return true;
             }
             return false;
@@ -255,6 +292,31 @@ namespace cppmicroservices
             configAdminImpl = nullptr;
         }
 
+        bool
+        ConfigurationImpl::MatchesFilter(LDAPFilter const& filter)
+        {
+            std::lock_guard<std::mutex> lk { propertiesMutex };
+            if (removed || changeCount == 0u)
+            {
+                return false;
+            }
+
+            // The filter is evaluated against the properties with "pid" set to this
+            // configuration's pid. Rather than copying the properties, add (or replace)
+            // the entry while the lock is held and restore the original afterwards.
+            if (properties.count("pid") == 0u)
+            {
+                properties.emplace("pid", pid);
+                detail::ScopeGuard erasePid([this]() { properties.erase("pid"); });
+                return filter.Match(properties);
+            }
+
+            auto original = std::move(properties["pid"]);
+            properties["pid"] = pid;
+            detail::ScopeGuard restorePid([this, &original]() { properties["pid"] = std::move(original); });
+            return filter.Match(properties);
+        }
+
         unsigned long
         ConfigurationImpl::GetInstanceCount()
         {
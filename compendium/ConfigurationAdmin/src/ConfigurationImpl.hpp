@@ -30,6 +30,7 @@
 
 #include "ConfigurationAdminPrivate.hpp"
 #include "ConfigurationPrivate.hpp"
+#include "ConfigurationStore.hpp"
 #include "ThreadpoolSafeFuturePrivate.hpp"
 
 namespace cppmicroservices
@@ -51,7 +52,8 @@ namespace cppmicroservices
                               AnyMap properties,
                               std::shared_ptr<AsyncWorkService> aws,
                               unsigned long const iCount,
-                              unsigned long const cCount = 0);
+                              unsigned long const cCount = 0,
+                              std::shared_ptr<ConfigurationStore> store = nullptr);
             ~ConfigurationImpl() override = default;
             ConfigurationImpl(ConfigurationImpl const&) = delete;
             ConfigurationImpl& operator=(ConfigurationImpl const&) = delete;
@@ -166,6 +168,14 @@ namespace cppmicroservices
              */
             std::pair<bool, unsigned long> UpdateWithoutNotificationIfDifferent(AnyMap properties) override;
 
+            /**
+             * Internal method used by {@code ConfigurationAdminImpl} to update the properties without triggering
+             * the notification to the corresponding ManagedService / ManagedServiceFactory.
+             *
+             * See {@code ConfigurationPrivate#UpdateWithoutNotification}
+             */
+            unsigned long UpdateWithoutNotification(AnyMap&& properties) override;
+
             /**
              * Internal method used by {@code ConfigurationAdminImpl} to Remove the Configuration without triggering
              * the notification to the corresponding ManagedService / ManagedServiceFactory.
@@ -200,6 +210,14 @@ namespace cppmicroservices
                 }
             }
 
+            /**
+             * Internal method used by {@code ConfigurationAdminImpl} to match a configuration
+             * against a filter.
+             *
+             * See {@code ConfigurationPrivate#MatchesFilter}
+             */
+            bool MatchesFilter(LDAPFilter const& filter) override;
+
           private:
             std::shared_ptr<AsyncWorkService> strand;
             std::mutex configAdminMutex;
@@ -211,6 +229,7 @@ namespace cppmicroservices
             unsigned long changeCount;
             bool removed;
             unsigned long instance;
+            std::shared_ptr<ConfigurationStore> store; ///< records changes if persistence is enabled
         };
     } // namespace cmimpl
 } // namespace cppmicroservices
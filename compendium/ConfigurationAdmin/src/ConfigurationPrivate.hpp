@@ -25,6 +25,8 @@
 
 #include <mutex>
 
+#include "cppmicroservices/LDAPFilter.h"
+
 #include "ConfigurationAdminPrivate.hpp"
 
 namespace cppmicroservices
@@ -50,6 +52,18 @@ namespace cppmicroservices
              */
             virtual std::pair<bool, unsigned long> UpdateWithoutNotificationIfDifferent(AnyMap properties) = 0;
 
+            /**
+             * Internal method used by {@code ConfigurationAdminImpl#SafeUpdateBatch} to update the properties
+             * without triggering the notification to the corresponding ManagedService / ManagedServiceFactory.
+             * That will be taken care of by {@code ConfigurationAdminImpl} instead.
+             *
+             * @throws std::runtime_error if this Configuration has been Removed
+             *
+             * @param properties The properties to update this Configuration with
+             * @return the value of the changeCount after the update
+             */
+            virtual unsigned long UpdateWithoutNotification(AnyMap&& properties) = 0;
+
             /**
              * Internal method used by {@code ConfigurationAdminImpl} to Remove the Configuration without triggering
              * the notification to the corresponding ManagedService / ManagedServiceFactory. That will be taken
@@ -74,6 +88,17 @@ namespace cppmicroservices
              * See {@code ConfigurationPrivate#Invalidate}
              */
             virtual bool HasBeenUpdatedAtLeastOnce() = 0;
+
+            /**
+             * Internal method used by {@code ConfigurationAdminImpl#ListConfigurations} to evaluate an LDAP
+             * filter against the properties of this configuration together with its "pid", without copying
+             * the properties.
+             *
+             * @param filter The filter to evaluate.
+             * @return true if the configuration has been updated at least once, has not been removed and
+             *         matches the filter.
+             */
+            virtual bool MatchesFilter(LDAPFilter const& filter) = 0;
         };
     } // namespace cmimpl
 } // namespace cppmicroservices
@@ -0,0 +1,928 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#include "ConfigurationStore.hpp"
+
+#include <cppmicroservices/GlobalConfig.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <typeinfo>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef US_PLATFORM_WINDOWS
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+using cppmicroservices::logservice::SeverityLevel;
+
+namespace
+{
+    using cppmicroservices::Any;
+    using cppmicroservices::AnyMap;
+
+    constexpr auto LOG_FILE_NAME = "configurations.log";
+    constexpr auto SNAPSHOT_FILE_NAME = "configurations.snapshot";
+    constexpr auto TEMP_SUFFIX = ".tmp";
+    constexpr auto CORRUPT_SUFFIX = ".corrupt";
+
+    constexpr char FILE_MAGIC[8] = { 'U', 'S', 'C', 'M', 'S', 'T', 'O', 'R' };
+    constexpr std::uint32_t FILE_VERSION = 1u;
+    // magic, version, generation
+    constexpr std::size_t FILE_HEADER_SIZE = sizeof(FILE_MAGIC) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+    // payload size, checksum
+    constexpr std::size_t RECORD_HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    enum class Op : std::uint8_t
+    {
+        Update = 1,
+        Remove = 2
+    };
+
+    enum class Tag : std::uint8_t
+    {
+        Empty,
+        Bool,
+        Int,
+        UnsignedInt,
+        Long,
+        UnsignedLong,
+        LongLong,
+        UnsignedLongLong,
+        Float,
+        Double,
+        String,
+        Vector,
+        Map
+    };
+
+    // The store is private to the machine it was written on, so values are
+    // written in native byte order.
+    class Encoder
+    {
+      public:
+        std::string buffer;
+
+        template <typename T>
+        void
+        Write(T value)
+        {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            buffer.append(bytes, sizeof(T));
+        }
+
+        void
+        WriteString(std::string const& value)
+        {
+            Write(static_cast<std::uint32_t>(value.size()));
+            buffer.append(value);
+        }
+
+        void
+        WriteValue(Any const& value, int depth)
+        {
+            // Any is only checked for the types configurations are commonly made of; the
+            // types of numbers are kept so that any_cast works on the restored values.
+            auto const& type = value.Type();
+            if (value.Empty())
+            {
+                Write(Tag::Empty);
+            }
+            else if (type == typeid(bool))
+            {
+                Write(Tag::Bool);
+                Write(static_cast<std::uint8_t>(cppmicroservices::any_cast<bool>(value) ? 1 : 0));
+            }
+            else if (type == typeid(int))
+            {
+                Write(Tag::Int);
+                Write(static_cast<std::int64_t>(cppmicroservices::any_cast<int>(value)));
+            }
+            else if (type == typeid(unsigned int))
+            {
+                Write(Tag::UnsignedInt);
+                Write(static_cast<std::uint64_t>(cppmicroservices::any_cast<unsigned int>(value)));
+            }
+            else if (type == typeid(long))
+            {
+                Write(Tag::Long);
+                Write(static_cast<std::int64_t>(cppmicroservices::any_cast<long>(value)));
+            }
+            else if (type == typeid(unsigned long))
+            {
+                Write(Tag::UnsignedLong);
+                Write(static_cast<std::uint64_t>(cppmicroservices::any_cast<unsigned long>(value)));
+            }
+            else if (type == typeid(long long))
+            {
+                Write(Tag::LongLong);
+                Write(static_cast<std::int64_t>(cppmicroservices::any_cast<long long>(value)));
+            }
+            else if (type == typeid(unsigned long long))
+            {
+                Write(Tag::UnsignedLongLong);
+                Write(static_cast<std::uint64_t>(cppmicroservices::any_cast<unsigned long long>(value)));
+            }
+            else if (type == typeid(float))
+            {
+                Write(Tag::Float);
+                Write(cppmicroservices::any_cast<float>(value));
+            }
+            else if (type == typeid(double))
+            {
+                Write(Tag::Double);
+                Write(cppmicroservices::any_cast<double>(value));
+            }
+            else if (type == typeid(std::string))
+            {
+                Write(Tag::String);
+                WriteString(cppmicroservices::ref_any_cast<std::string>(value));
+            }
+            else if (type == typeid(std::vector<Any>))
+            {
+                auto const& values = cppmicroservices::ref_any_cast<std::vector<Any>>(value);
+                Write(Tag::Vector);
+                Write(static_cast<std::uint32_t>(values.size()));
+                for (auto const& element : values)
+                {
+                    WriteValue(element, depth + 1);
+                }
+            }
+            else if (type == typeid(AnyMap))
+            {
+                Write(Tag::Map);
+                WriteMap(cppmicroservices::ref_any_cast<AnyMap>(value), depth + 1);
+            }
+            else
+            {
+                throw std::invalid_argument(std::string("values of type ") + type.name() + " cannot be stored");
+            }
+        }
+
+        void
+        WriteMap(AnyMap const& map, int depth)
+        {
+            Write(static_cast<std::uint8_t>(map.GetType()));
+            Write(static_cast<std::uint32_t>(map.size()));
+            for (auto const& entry : map)
+            {
+                WriteString(entry.first);
+                WriteValue(entry.second, depth);
+            }
+        }
+    };
+
+    class Decoder
+    {
+      public:
+        static constexpr int MAX_DEPTH = 64;
+
+        explicit Decoder(std::string_view data) : data(data) {}
+
+        std::size_t
+        Remaining() const
+        {
+            return data.size();
+        }
+
+        template <typename T>
+        bool
+        Read(T& value)
+        {
+            if (data.size() < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, data.data(), sizeof(T));
+            data.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        bool
+        ReadString(std::string& value)
+        {
+            std::uint32_t size = 0;
+            if (!Read(size) || data.size() < size)
+            {
+                return false;
+            }
+            value.assign(data.data(), size);
+            data.remove_prefix(size);
+            return true;
+        }
+
+        bool
+        ReadValue(Any& value, int depth)
+        {
+            Tag tag = Tag::Empty;
+            if (depth > MAX_DEPTH || !Read(tag))
+            {
+                return false;
+            }
+            switch (tag)
+            {
+                case Tag::Empty:
+                    value = Any();
+                    return true;
+                case Tag::Bool:
+                {
+                    std::uint8_t b = 0;
+                    if (!Read(b))
+                    {
+                        return false;
+                    }
+                    value = (b != 0);
+                    return true;
+                }
+                case Tag::Int:
+                    return ReadNumber<int, std::int64_t>(value);
+                case Tag::UnsignedInt:
+                    return ReadNumber<unsigned int, std::uint64_t>(value);
+                case Tag::Long:
+                    return ReadNumber<long, std::int64_t>(value);
+                case Tag::UnsignedLong:
+                    return ReadNumber<unsigned long, std::uint64_t>(value);
+                case Tag::LongLong:
+                    return ReadNumber<long long, std::int64_t>(value);
+                case Tag::UnsignedLongLong:
+                    return ReadNumber<unsigned long long, std::uint64_t>(value);
+                case Tag::Float:
+                    return ReadNumber<float, float>(value);
+                case Tag::Double:
+                    return ReadNumber<double, double>(value);
+                case Tag::String:
+                {
+                    std::string s;
+                    if (!ReadString(s))
+                    {
+                        return false;
+                    }
+                    value = std::move(s);
+                    return true;
+                }
+                case Tag::Vector:
+                {
+                    std::uint32_t count = 0;
+                    if (!Read(count) || count > data.size())
+                    {
+                        return false;
+                    }
+                    std::vector<Any> values(count);
+                    for (auto& element : values)
+                    {
+                        if (!ReadValue(element, depth + 1))
+                        {
+                            return false;
+                        }
+                    }
+                    value = std::move(values);
+                    return true;
+                }
+                case Tag::Map:
+                {
+                    AnyMap map { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                    if (!ReadMap(map, depth + 1))
+                    {
+                        return false;
+                    }
+                    value = std::move(map);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool
+        ReadMap(AnyMap& map, int depth)
+        {
+            std::uint8_t type = 0;
+            std::uint32_t count = 0;
+            if (!Read(type) || type > static_cast<std::uint8_t>(AnyMap::FLAT_MAP) || !Read(count)
+                || count > data.size())
+            {
+                return false;
+            }
+            AnyMap result { static_cast<AnyMap::map_type>(type) };
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                std::string key;
+                Any value;
+                if (!ReadString(key) || !ReadValue(value, depth))
+                {
+                    return false;
+                }
+                result.emplace(std::move(key), std::move(value));
+            }
+            map = std::move(result);
+            return true;
+        }
+
+      private:
+        template <typename ValueType, typename StoredType>
+        bool
+        ReadNumber(Any& value)
+        {
+            StoredType stored {};
+            if (!Read(stored))
+            {
+                return false;
+            }
+            value = static_cast<ValueType>(stored);
+            return true;
+        }
+
+        std::string_view data;
+    };
+
+    std::uint64_t
+    Checksum(std::string_view data)
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ull;
+        for (auto const c : data)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string
+    FrameRecord(std::string const& payload)
+    {
+        Encoder record;
+        record.Write(static_cast<std::uint32_t>(payload.size()));
+        record.Write(Checksum(payload));
+        record.buffer.append(payload);
+        return std::move(record.buffer);
+    }
+
+    std::string
+    FileHeader(std::uint64_t generation)
+    {
+        Encoder header;
+        header.buffer.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.Write(FILE_VERSION);
+        header.Write(generation);
+        return std::move(header.buffer);
+    }
+
+    /*
+     * Reads a file written by FileHeader followed by records. Complete records are passed
+     * to the callback; the number of bytes following the last complete record is returned.
+     * checksumMismatch is set if reading stopped at a record whose checksum does not match.
+     */
+    template <typename Callback>
+    bool
+    ReadFile(std::string const& path,
+             std::uint64_t& generation,
+             std::size_t& trailingBytes,
+             bool& checksumMismatch,
+             Callback&& callback)
+    {
+        checksumMismatch = false;
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::string const content { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        std::string_view data { content };
+
+        std::uint32_t version = 0;
+        if (data.size() < FILE_HEADER_SIZE || data.compare(0, sizeof(FILE_MAGIC), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+        {
+            return false;
+        }
+        Decoder header { data.substr(sizeof(FILE_MAGIC), FILE_HEADER_SIZE - sizeof(FILE_MAGIC)) };
+        if (!header.Read(version) || version != FILE_VERSION || !header.Read(generation))
+        {
+            return false;
+        }
+        data.remove_prefix(FILE_HEADER_SIZE);
+
+        while (!data.empty())
+        {
+            Decoder recordHeader { data };
+            std::uint32_t size = 0;
+            std::uint64_t checksum = 0;
+            if (!recordHeader.Read(size) || !recordHeader.Read(checksum) || recordHeader.Remaining() < size)
+            {
+                break;
+            }
+            auto const payload = data.substr(RECORD_HEADER_SIZE, size);
+            if (Checksum(payload) != checksum)
+            {
+                checksumMismatch = true;
+                break;
+            }
+            callback(payload, data.substr(0, RECORD_HEADER_SIZE + size));
+            data.remove_prefix(RECORD_HEADER_SIZE + size);
+        }
+        trailingBytes = data.size();
+        return true;
+    }
+
+#ifdef US_PLATFORM_WINDOWS
+    constexpr int WRITE_FLAGS = _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY;
+    constexpr int APPEND_FLAGS = _O_WRONLY | _O_APPEND | _O_BINARY;
+#else
+    constexpr int WRITE_FLAGS = O_WRONLY | O_CREAT | O_TRUNC;
+    constexpr int APPEND_FLAGS = O_WRONLY | O_APPEND;
+#endif
+
+    [[noreturn]] void
+    ThrowFileError(std::string const& action, std::string const& path)
+    {
+        throw std::system_error(errno, std::generic_category(), "Failed to " + action + " " + path);
+    }
+
+    int
+    OpenFile(std::string const& path, int flags)
+    {
+#ifdef US_PLATFORM_WINDOWS
+        int const fd = _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+        int const fd = open(path.c_str(), flags, 0644);
+#endif
+        if (fd < 0)
+        {
+            ThrowFileError("open", path);
+        }
+        return fd;
+    }
+
+    void
+    CloseFile(int fd)
+    {
+#ifdef US_PLATFORM_WINDOWS
+        _close(fd);
+#else
+        close(fd);
+#endif
+    }
+
+    void
+    WriteFile(int fd, std::string const& data, std::string const& path)
+    {
+        std::size_t written = 0;
+        while (written < data.size())
+        {
+#ifdef US_PLATFORM_WINDOWS
+            auto const result = _write(fd,
+                                       data.data() + written,
+                                       static_cast<unsigned int>(std::min<std::size_t>(data.size() - written, 1u << 30)));
+#else
+            auto const result = write(fd, data.data() + written, data.size() - written);
+#endif
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ThrowFileError("write", path);
+            }
+            written += static_cast<std::size_t>(result);
+        }
+    }
+
+    void
+    SyncFile(int fd, std::string const& path)
+    {
+#ifdef US_PLATFORM_WINDOWS
+        if (_commit(fd) != 0)
+#else
+        if (fsync(fd) != 0)
+#endif
+        {
+            ThrowFileError("sync", path);
+        }
+    }
+
+    // Makes a rename within the directory durable.
+    void
+    SyncDirectory(std::string const& directory)
+    {
+#ifndef US_PLATFORM_WINDOWS
+        int const fd = open(directory.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            fsync(fd);
+            close(fd);
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    // Atomically replaces path with the given content.
+    void
+    ReplaceFile(std::string const& directory, std::string const& path, std::string const& content)
+    {
+        auto const tempPath = path + TEMP_SUFFIX;
+        int const fd = OpenFile(tempPath, WRITE_FLAGS);
+        try
+        {
+            WriteFile(fd, content, tempPath);
+            SyncFile(fd, tempPath);
+        }
+        catch (...)
+        {
+            CloseFile(fd);
+            throw;
+        }
+        CloseFile(fd);
+        std::filesystem::rename(tempPath, path);
+        SyncDirectory(directory);
+    }
+
+    // Renames a damaged file so that it is kept for recovery instead of being replaced.
+    std::string
+    PreserveFile(std::string const& path)
+    {
+        auto preserved = path + CORRUPT_SUFFIX;
+        for (int i = 1; std::filesystem::exists(preserved); ++i)
+        {
+            preserved = path + CORRUPT_SUFFIX + "." + std::to_string(i);
+        }
+        std::filesystem::rename(path, preserved);
+        return preserved;
+    }
+} // namespace
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        ConfigurationStore::ConfigurationStore(std::string dir,
+                                               std::shared_ptr<cppmicroservices::logservice::LogService> lggr,
+                                               std::size_t minCompaction)
+            : directory(std::move(dir))
+            , logger(std::move(lggr))
+            , minCompactionBytes(minCompaction)
+        {
+        }
+
+        ConfigurationStore::~ConfigurationStore()
+        {
+            try
+            {
+                Close();
+            }
+            catch (...)
+            {
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            "Exception while closing the configuration store in " + directory,
+                            std::current_exception());
+            }
+        }
+
+        std::vector<StoredConfiguration>
+        ConfigurationStore::Load()
+        {
+            std::filesystem::create_directories(directory);
+            auto const snapshotPath = directory + "/" + SNAPSHOT_FILE_NAME;
+            auto const logPath = directory + "/" + LOG_FILE_NAME;
+
+            auto apply = [this](std::string_view payload, std::string_view record)
+            {
+                Decoder decoder { payload };
+                Op op {};
+                std::string pid;
+                if (!decoder.Read(op) || !decoder.ReadString(pid))
+                {
+                    return;
+                }
+                if (op == Op::Update)
+                {
+                    latest[pid] = std::string(record);
+                }
+                else
+                {
+                    latest.erase(pid);
+                }
+            };
+
+            // A damaged snapshot or log is renamed before the files are compacted below, so that
+            // the configurations which could not be read are not lost for good.
+            auto preserve = [this](std::string const& path, std::string const& reason)
+            {
+                auto const preserved = PreserveFile(path);
+                logger->Log(SeverityLevel::LOG_ERROR,
+                            reason + ". The configurations in it which could not be restored are kept in "
+                                + preserved);
+            };
+
+            std::uint64_t snapshotGeneration = 0;
+            std::size_t trailingBytes = 0;
+            auto checksumMismatch = false;
+            if (!ReadFile(snapshotPath, snapshotGeneration, trailingBytes, checksumMismatch, apply))
+            {
+                if (std::filesystem::exists(snapshotPath))
+                {
+                    // without the snapshot the log cannot be replayed either
+                    preserve(snapshotPath, "Cannot read the configuration snapshot " + snapshotPath);
+                    if (std::filesystem::exists(logPath))
+                    {
+                        preserve(logPath, "Cannot replay the configuration log " + logPath);
+                    }
+                }
+            }
+            else if (checksumMismatch || trailingBytes > 0)
+            {
+                // the snapshot is written atomically, so it is never incomplete
+                preserve(snapshotPath,
+                         "Ignoring " + std::to_string(trailingBytes) + " bytes of the configuration snapshot "
+                             + snapshotPath
+                             + (checksumMismatch ? " after a checksum mismatch" : " which are incomplete"));
+            }
+            generation = snapshotGeneration;
+
+            // A log of an earlier generation was superseded by the snapshot before a crash
+            // during compaction, its records must not be replayed.
+            std::uint64_t logGeneration = 0;
+            if (ReadFile(logPath,
+                         logGeneration,
+                         trailingBytes,
+                         checksumMismatch,
+                         [&](std::string_view payload, std::string_view record)
+                         {
+                             if (logGeneration == snapshotGeneration)
+                             {
+                                 apply(payload, record);
+                             }
+                         }))
+            {
+                if (logGeneration > snapshotGeneration)
+                {
+                    preserve(logPath,
+                             "The configuration log " + logPath + " of generation " + std::to_string(logGeneration)
+                                 + " does not belong to the snapshot of generation "
+                                 + std::to_string(snapshotGeneration));
+                }
+                else if (logGeneration == snapshotGeneration && checksumMismatch)
+                {
+                    preserve(logPath,
+                             "Ignoring " + std::to_string(trailingBytes) + " bytes of the configuration log " + logPath
+                                 + " after a checksum mismatch");
+                }
+                else if (logGeneration == snapshotGeneration && trailingBytes > 0)
+                {
+                    // expected after a crash while a change was written
+                    logger->Log(SeverityLevel::LOG_WARNING,
+                                "Ignoring " + std::to_string(trailingBytes) + " bytes of incomplete changes at the end of "
+                                    + logPath);
+                }
+            }
+            else if (std::filesystem::exists(logPath))
+            {
+                preserve(logPath, "Cannot read the configuration log " + logPath);
+            }
+
+            std::vector<StoredConfiguration> result;
+            std::vector<std::string> records;
+            result.reserve(latest.size());
+            records.reserve(latest.size());
+            for (auto it = latest.begin(); it != latest.end();)
+            {
+                StoredConfiguration configuration;
+                Decoder decoder { std::string_view(it->second).substr(RECORD_HEADER_SIZE) };
+                Op op {};
+                std::uint64_t changeCount = 0;
+                if (!decoder.Read(op) || !decoder.ReadString(configuration.pid)
+                    || !decoder.ReadString(configuration.factoryPid) || !decoder.Read(changeCount)
+                    || !decoder.ReadMap(configuration.properties, 0) || decoder.Remaining() != 0)
+                {
+                    logger->Log(SeverityLevel::LOG_ERROR,
+                                "Ignoring stored configuration with PID " + it->first + " which cannot be read");
+                    it = latest.erase(it);
+                    continue;
+                }
+                configuration.changeCount = static_cast<unsigned long>(changeCount);
+                result.push_back(std::move(configuration));
+                records.push_back(it->second);
+                ++it;
+            }
+
+            // start from a compacted snapshot and an empty log, which also drops any
+            // incomplete record at the end of the log
+            Compact(records);
+
+            {
+                std::lock_guard<std::mutex> lk { mutex };
+                accepting = true;
+            }
+            writer = std::thread([this] { WriteLoop(); });
+            return result;
+        }
+
+        void
+        ConfigurationStore::RecordUpdate(std::string const& pid,
+                                         std::string const& factoryPid,
+                                         AnyMap const& properties,
+                                         unsigned long changeCount)
+        {
+            Encoder payload;
+            try
+            {
+                payload.Write(Op::Update);
+                payload.WriteString(pid);
+                payload.WriteString(factoryPid);
+                payload.Write(static_cast<std::uint64_t>(changeCount));
+                payload.WriteMap(properties, 0);
+            }
+            catch (std::invalid_argument const&)
+            {
+                logger->Log(SeverityLevel::LOG_WARNING,
+                            "Configuration with PID " + pid + " cannot be persisted",
+                            std::current_exception());
+                RecordRemove(pid);
+                return;
+            }
+            Enqueue(pid, FrameRecord(payload.buffer), false);
+        }
+
+        void
+        ConfigurationStore::RecordRemove(std::string const& pid)
+        {
+            Encoder payload;
+            payload.Write(Op::Remove);
+            payload.WriteString(pid);
+            Enqueue(pid, FrameRecord(payload.buffer), true);
+        }
+
+        void
+        ConfigurationStore::Enqueue(std::string const& pid, std::string record, bool remove)
+        {
+            std::lock_guard<std::mutex> lk { mutex };
+            if (!accepting)
+            {
+                return;
+            }
+            if (remove)
+            {
+                latest.erase(pid);
+            }
+            else
+            {
+                latest[pid] = record;
+            }
+            pending.push_back(std::move(record));
+            ++recordedCount;
+            changed.notify_all();
+        }
+
+        void
+        ConfigurationStore::Flush()
+        {
+            std::unique_lock<std::mutex> lk { mutex };
+            auto const target = recordedCount;
+            changed.wait(lk, [this, target] { return syncedCount >= target || !accepting; });
+        }
+
+        void
+        ConfigurationStore::Close()
+        {
+            {
+                std::lock_guard<std::mutex> lk { mutex };
+                accepting = false;
+                stopping = true;
+                changed.notify_all();
+            }
+            if (writer.joinable())
+            {
+                writer.join();
+            }
+            if (logFile >= 0)
+            {
+                CloseFile(logFile);
+                logFile = -1;
+            }
+        }
+
+        void
+        ConfigurationStore::WriteLoop()
+        {
+            auto const logPath = directory + "/" + LOG_FILE_NAME;
+            auto compactionRequired = false;
+            std::unique_lock<std::mutex> lk { mutex };
+            while (true)
+            {
+                changed.wait(lk, [this] { return stopping || !pending.empty(); });
+                if (pending.empty())
+                {
+                    break;
+                }
+                std::vector<std::string> batch;
+                batch.swap(pending);
+                auto const batchEnd = recordedCount;
+                lk.unlock();
+
+                // everything queued so far is written with a single write and sync
+                std::string buffer;
+                for (auto const& record : batch)
+                {
+                    buffer.append(record);
+                }
+                try
+                {
+                    if (!compactionRequired)
+                    {
+                        WriteFile(logFile, buffer, logPath);
+                        SyncFile(logFile, logPath);
+                        logBytes += buffer.size();
+                    }
+                    if (compactionRequired || logBytes > std::max(minCompactionBytes, snapshotBytes))
+                    {
+                        std::vector<std::string> records;
+                        lk.lock();
+                        records.reserve(latest.size());
+                        for (auto const& entry : latest)
+                        {
+                            records.push_back(entry.second);
+                        }
+                        lk.unlock();
+                        Compact(records);
+                        compactionRequired = false;
+                    }
+                }
+                catch (...)
+                {
+                    // The log may now end with an incomplete record, which would hide any record
+                    // appended after it. Rewrite everything instead with the next batch.
+                    compactionRequired = true;
+                    logger->Log(SeverityLevel::LOG_ERROR,
+                                "Failed to persist configuration changes in " + directory,
+                                std::current_exception());
+                }
+
+                lk.lock();
+                syncedCount = batchEnd;
+                changed.notify_all();
+            }
+        }
+
+        void
+        ConfigurationStore::Compact(std::vector<std::string> const& records)
+        {
+            auto const snapshotPath = directory + "/" + SNAPSHOT_FILE_NAME;
+            auto const logPath = directory + "/" + LOG_FILE_NAME;
+
+            // The snapshot of the next generation supersedes the current log as soon as it
+            // is renamed into place, the log of that generation is started afterwards.
+            auto const nextGeneration = generation + 1;
+            auto snapshot = FileHeader(nextGeneration);
+            for (auto const& record : records)
+            {
+                snapshot.append(record);
+            }
+            ReplaceFile(directory, snapshotPath, snapshot);
+            generation = nextGeneration;
+            snapshotBytes = snapshot.size();
+
+            if (logFile >= 0)
+            {
+                CloseFile(logFile);
+                logFile = -1;
+            }
+            auto const logHeader = FileHeader(generation);
+            ReplaceFile(directory, logPath, logHeader);
+            logFile = OpenFile(logPath, APPEND_FLAGS);
+            logBytes = logHeader.size();
+        }
+
+    } // namespace cmimpl
+} // namespace cppmicroservices
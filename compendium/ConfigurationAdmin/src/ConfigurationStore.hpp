@@ -0,0 +1,158 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#ifndef CONFIGURATIONSTORE_HPP
+#define CONFIGURATIONSTORE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cppmicroservices/AnyMap.h"
+#include "cppmicroservices/logservice/LogService.hpp"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+
+        /**
+         * A configuration as restored by {@code ConfigurationStore#Load}.
+         */
+        struct StoredConfiguration final
+        {
+            std::string pid;
+            std::string factoryPid;
+            AnyMap properties { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            unsigned long changeCount { 0ul };
+        };
+
+        /**
+         * This class persists Configuration objects to a directory, so that they can be restored
+         * when ConfigurationAdmin is activated again.
+         *
+         * Changes are appended to a log file which is periodically compacted into a snapshot of
+         * the live configurations. Recording a change only encodes it and queues it; a background
+         * thread appends everything queued so far to the log and syncs it to disk once per batch,
+         * so callers are never blocked on disk I/O.
+         *
+         * Each log record carries a checksum, so a record torn by a crash is detected and ignored
+         * (together with anything after it). Snapshots are written to a temporary file and renamed
+         * into place. Both files carry a generation number and the log is only replayed on top of
+         * the snapshot of the same generation, so a crash during compaction never replays records
+         * that the snapshot already supersedes.
+         */
+        class ConfigurationStore final
+        {
+          public:
+            /**
+             * @param directory The directory to store the files in. It is created if it does not exist.
+             * @param logger Used to report configurations which cannot be stored or restored.
+             * @param minCompactionBytes The log is not compacted before it is at least this large
+             *        (and larger than the last snapshot).
+             */
+            ConfigurationStore(std::string directory,
+                               std::shared_ptr<cppmicroservices::logservice::LogService> logger,
+                               std::size_t minCompactionBytes = 1024 * 1024);
+            ConfigurationStore(ConfigurationStore const&) = delete;
+            ConfigurationStore& operator=(ConfigurationStore const&) = delete;
+            ConfigurationStore(ConfigurationStore&&) = delete;
+            ConfigurationStore& operator=(ConfigurationStore&&) = delete;
+
+            /**
+             * Closes the store. See {@code ConfigurationStore#Close}
+             */
+            ~ConfigurationStore();
+
+            /**
+             * Reads the stored configurations, compacts the files and starts accepting changes.
+             * Must be called exactly once, before any change is recorded.
+             *
+             * A snapshot or log which cannot be read completely, other than a log ending with an
+             * incomplete change, is renamed with the suffix ".corrupt" instead of being replaced.
+             *
+             * @return the configurations in the store
+             * @throws std::runtime_error if the directory cannot be created or the files cannot be written.
+             */
+            std::vector<StoredConfiguration> Load();
+
+            /**
+             * Record that the configuration with the given pid was created or updated. Properties
+             * containing values of unsupported types cannot be stored; the configuration is then
+             * removed from the store (and a warning logged) so that a stale version is not restored.
+             */
+            void RecordUpdate(std::string const& pid,
+                              std::string const& factoryPid,
+                              AnyMap const& properties,
+                              unsigned long changeCount);
+
+            /**
+             * Record that the configuration with the given pid was removed.
+             */
+            void RecordRemove(std::string const& pid);
+
+            /**
+             * Block until all changes recorded so far have been written and synced to disk.
+             */
+            void Flush();
+
+            /**
+             * Write and sync all changes recorded so far and stop the background thread. Changes
+             * recorded afterwards are ignored. Used by {@code ConfigurationAdminImpl} when it shuts
+             * down, as Configuration objects held by clients can outlive it.
+             */
+            void Close();
+
+          private:
+            void Enqueue(std::string const& pid, std::string record, bool remove);
+            void WriteLoop();
+            void Compact(std::vector<std::string> const& records);
+
+            std::string const directory;
+            std::shared_ptr<cppmicroservices::logservice::LogService> logger;
+            std::size_t const minCompactionBytes;
+
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::unordered_map<std::string, std::string> latest; ///< the latest update record of every pid
+            std::vector<std::string> pending;                    ///< records not yet written to the log
+            std::uint64_t recordedCount { 0u };                  ///< number of records queued so far
+            std::uint64_t syncedCount { 0u };                    ///< number of records synced to disk
+            bool accepting { false };
+            bool stopping { false };
+            std::thread writer;
+
+            // only used by Load and the writer thread
+            std::uint64_t generation { 0u };
+            std::size_t snapshotBytes { 0u };
+            std::size_t logBytes { 0u };
+            int logFile { -1 };
+        };
+    } // namespace cmimpl
+} // namespace cppmicroservices
+
+#endif // CONFIGURATIONSTORE_HPP
@@ -86,7 +86,90 @@ namespace
             iter += 1;
         }
     }
+
+    constexpr size_t NumberOfConfigurations = 10000;
+    constexpr size_t NumberOfFactoryConfigurations = 100;
+
+    /*
+     * Populates ConfigurationAdmin with NumberOfConfigurations configurations
+     * and NumberOfFactoryConfigurations instances of the factory pid "factory".
+     */
+    void
+    CreateConfigurations(cppmicroservices::service::cm::ConfigurationAdmin& configAdmin)
+    {
+        for (size_t i = 0; i < NumberOfConfigurations; ++i)
+        {
+            cppmicroservices::AnyMap props(cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            props["anInt"] = static_cast<int>(i);
+            props["aString"] = std::string("value") + std::to_string(i);
+            configAdmin.GetConfiguration("someConfig" + std::to_string(i))->Update(props).get();
+        }
+        for (size_t i = 0; i < NumberOfFactoryConfigurations; ++i)
+        {
+            cppmicroservices::AnyMap props(cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            props["anInt"] = static_cast<int>(i);
+            configAdmin.GetFactoryConfiguration("factory", std::to_string(i))->Update(props).get();
+        }
+    }
+
+    BENCHMARK_DEFINE_F(GetConfigurationTest, listConfigurationsByPid)(benchmark::State& state)
+    {
+        auto const configAdmin
+            = context.GetService(context.GetServiceReference<cppmicroservices::service::cm::ConfigurationAdmin>());
+        CreateConfigurations(*configAdmin);
+
+        size_t iter = 0;
+        for (auto _ : state)
+        {
+            auto const configurations = configAdmin->ListConfigurations(
+                "(pid=someConfig" + std::to_string(iter % NumberOfConfigurations) + ")");
+            if (configurations.size() != 1)
+            {
+                state.SkipWithError("unexpected number of configurations");
+                break;
+            }
+            iter += 1;
+        }
+    }
+
+    BENCHMARK_DEFINE_F(GetConfigurationTest, listConfigurationsByFactoryPid)(benchmark::State& state)
+    {
+        auto const configAdmin
+            = context.GetService(context.GetServiceReference<cppmicroservices::service::cm::ConfigurationAdmin>());
+        CreateConfigurations(*configAdmin);
+
+        for (auto _ : state)
+        {
+            auto const configurations = configAdmin->ListConfigurations("(pid=factory~*)");
+            if (configurations.size() != NumberOfFactoryConfigurations)
+            {
+                state.SkipWithError("unexpected number of configurations");
+                break;
+            }
+        }
+    }
+
+    BENCHMARK_DEFINE_F(GetConfigurationTest, listConfigurationsByProperty)(benchmark::State& state)
+    {
+        auto const configAdmin
+            = context.GetService(context.GetServiceReference<cppmicroservices::service::cm::ConfigurationAdmin>());
+        CreateConfigurations(*configAdmin);
+
+        for (auto _ : state)
+        {
+            // matches someConfig42 only, the factory instances have a smaller anInt
+            auto const configurations = configAdmin->ListConfigurations("(&(anInt=42)(aString=value42))");
+            if (configurations.size() != 1)
+            {
+                state.SkipWithError("unexpected number of configurations");
+                break;
+            }
+        }
+    }
 } // namespace
 
 BENCHMARK_REGISTER_F(GetConfigurationTest, createConfiguration);
 BENCHMARK_REGISTER_F(GetConfigurationTest, updateConfigurationUsedByService);
+BENCHMARK_REGISTER_F(GetConfigurationTest, listConfigurationsByPid);
+BENCHMARK_REGISTER_F(GetConfigurationTest, listConfigurationsByFactoryPid)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(GetConfigurationTest, listConfigurationsByProperty)->Unit(benchmark::kMillisecond);
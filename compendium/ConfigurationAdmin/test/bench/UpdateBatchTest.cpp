@@ -0,0 +1,192 @@
+#include "../TestUtils.hpp"
+#include <benchmark/benchmark.h>
+#include <cppmicroservices/AnyMap.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceRegistration.h>
+#include <cppmicroservices/cm/ConfigurationAdmin.hpp>
+#include <cppmicroservices/cm/ManagedService.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using cppmicroservices::AnyMap;
+
+    /*
+     * Counts the notifications received by all ManagedServices of a benchmark.
+     */
+    class Propagation
+    {
+      public:
+        void
+        Notify()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++count;
+            }
+            cv.notify_one();
+        }
+
+        void
+        Reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            count = 0;
+        }
+
+        bool
+        WaitFor(std::size_t expected)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, std::chrono::seconds(60), [this, expected] { return count >= expected; });
+        }
+
+      private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t count = 0;
+    };
+
+    class CountingManagedService : public cppmicroservices::service::cm::ManagedService
+    {
+      public:
+        explicit CountingManagedService(Propagation& propagation) : propagation(propagation) {}
+
+        void
+        Updated(AnyMap const&) override
+        {
+            propagation.Notify();
+        }
+
+      private:
+        Propagation& propagation;
+    };
+
+    class UpdateBatchTest : public ::benchmark::Fixture
+    {
+      public:
+        using benchmark::Fixture::SetUp;
+        using benchmark::Fixture::TearDown;
+
+        void
+        SetUp(::benchmark::State const& state)
+        {
+            using namespace cppmicroservices;
+            framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+            framework->Start();
+
+            context = framework->GetBundleContext();
+
+            test::InstallAndStartDS(context);
+            test::InstallAndStartConfigAdmin(context);
+            configAdmin = context.GetService(context.GetServiceReference<service::cm::ConfigurationAdmin>());
+
+            // one ManagedService per pid
+            auto const numberOfPids = static_cast<std::size_t>(state.range(0));
+            for (std::size_t i = 0; i < numberOfPids; ++i)
+            {
+                auto const pid = "batch.pid" + std::to_string(i);
+                registrations.push_back(context.RegisterService<service::cm::ManagedService>(
+                    std::make_shared<CountingManagedService>(propagation),
+                    ServiceProperties({
+                        { std::string("service.pid"), pid }
+                })));
+                pids.push_back(pid);
+            }
+        }
+
+        void
+        TearDown(::benchmark::State const&)
+        {
+            for (auto& registration : registrations)
+            {
+                registration.Unregister();
+            }
+            registrations.clear();
+            pids.clear();
+            configAdmin.reset();
+            framework->Stop();
+            framework->WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        ~UpdateBatchTest() = default;
+
+        std::shared_ptr<cppmicroservices::Framework> framework;
+        cppmicroservices::BundleContext context;
+        std::shared_ptr<cppmicroservices::service::cm::ConfigurationAdmin> configAdmin;
+        std::vector<cppmicroservices::ServiceRegistration<cppmicroservices::service::cm::ManagedService>>
+            registrations;
+        std::vector<std::string> pids;
+        Propagation propagation;
+    };
+
+    AnyMap
+    MakeProperties(std::size_t value)
+    {
+        AnyMap props(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        props["val"] = value;
+        return props;
+    }
+
+    // Measures the time until every ManagedService has received its new
+    // configuration, when each pid is updated on its own.
+    BENCHMARK_DEFINE_F(UpdateBatchTest, updateEachConfiguration)(benchmark::State& state)
+    {
+        std::size_t iter = 0;
+        for (auto _ : state)
+        {
+            propagation.Reset();
+            for (auto const& pid : pids)
+            {
+                configAdmin->GetConfiguration(pid)->Update(MakeProperties(iter));
+            }
+            if (!propagation.WaitFor(pids.size()))
+            {
+                state.SkipWithError("not all ManagedServices were notified");
+                break;
+            }
+            ++iter;
+        }
+    }
+
+    // Measures the time until every ManagedService has received its new
+    // configuration, when all pids are updated in one batch.
+    BENCHMARK_DEFINE_F(UpdateBatchTest, updateBatch)(benchmark::State& state)
+    {
+        std::size_t iter = 0;
+        for (auto _ : state)
+        {
+            propagation.Reset();
+            std::vector<std::pair<std::string, AnyMap>> updates;
+            updates.reserve(pids.size());
+            for (auto const& pid : pids)
+            {
+                updates.emplace_back(pid, MakeProperties(iter));
+            }
+            configAdmin->UpdateBatch(std::move(updates));
+            if (!propagation.WaitFor(pids.size()))
+            {
+                state.SkipWithError("not all ManagedServices were notified");
+                break;
+            }
+            ++iter;
+        }
+    }
+} // namespace
+
+BENCHMARK_REGISTER_F(UpdateBatchTest, updateEachConfiguration)
+    ->Arg(500)
+    ->Arg(5000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_REGISTER_F(UpdateBatchTest, updateBatch)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
@@ -13,8 +14,10 @@
 #include "TestInterfaces/Interfaces.hpp"
 
 #include <chrono>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <random>
 #include <string>
 #include <thread>
 #include <utility>
@@ -945,4 +948,54 @@ TEST_F(ConfigAdminTests, testManagedServiceRemoveConfigurationsDeadlock)
     {
         b.Stop();
     }
-}
\ No newline at end of file
+}
+/*
+ * testConfigurationsArePersisted
+ *
+ * With persistence enabled, a framework using the same storage area restores the
+ * configurations, including their change counts, when ConfigAdmin is started again.
+ */
+TEST(ConfigAdminPersistenceTests, testConfigurationsArePersisted)
+{
+    auto const storage = std::filesystem::temp_directory_path()
+                         / ("us_cm_persistence_" + std::to_string(std::random_device {}()));
+    cppmicroservices::FrameworkConfiguration const frameworkConfig {
+        { cppmicroservices::Constants::FRAMEWORK_STORAGE, storage.string() },
+        { "org.cppmicroservices.cm.persistence", true }
+    };
+
+    auto runWithConfigAdmin = [&frameworkConfig](std::function<void(cm::ConfigurationAdmin&)> const& test)
+    {
+        auto framework = cppmicroservices::FrameworkFactory().NewFramework(frameworkConfig);
+        framework.Start();
+        auto ctx = framework.GetBundleContext();
+        InstallAndStartDSAndConfigAdmin(ctx);
+        auto sr = ctx.GetServiceReference<cm::ConfigurationAdmin>();
+        ASSERT_TRUE(sr);
+        test(*ctx.GetService<cm::ConfigurationAdmin>(sr));
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    };
+
+    runWithConfigAdmin(
+        [](cm::ConfigurationAdmin& configAdmin)
+        {
+            cppmicroservices::AnyMap props(cppmicroservices::AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            props["anInt"] = 42;
+            auto const configuration = configAdmin.GetConfiguration("cm.persisted");
+            configuration->Update(props).get();
+            configuration->Update(props).get();
+        });
+
+    runWithConfigAdmin(
+        [](cm::ConfigurationAdmin& configAdmin)
+        {
+            auto const configurations = configAdmin.ListConfigurations("(pid=cm.persisted)");
+            ASSERT_EQ(configurations.size(), 1ul);
+            EXPECT_EQ(configurations[0]->GetChangeCount(), 2ul);
+            EXPECT_EQ(cppmicroservices::any_cast<int>(configurations[0]->GetProperties().at("anInt")), 42);
+        });
+
+    std::error_code ec;
+    std::filesystem::remove_all(storage, ec);
+}
@@ -27,12 +27,18 @@
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/cm/ConfigurationException.hpp"
+#include "cppmicroservices/detail/ScopeGuard.h"
 
 #include "../../src/CMAsyncWorkService.hpp"
 
 #include "../../src/ConfigurationAdminImpl.hpp"
 #include "Mocks.hpp"
+#include <chrono>
+#include <filesystem>
+#include <future>
 #include <mutex>
+#include <random>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -356,6 +362,145 @@ namespace cppmicroservices
             EXPECT_EQ(negativeResult[0]->GetPid(), "test.neg.pid2");
         }
 
+        TEST_F(TestConfigurationAdminImpl, VerifyListConfigurationsByPid)
+        {
+            auto bundleContext = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService> asyncWorkService
+                = std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(bundleContext, fakeLogger);
+            ConfigurationAdminImpl configAdmin(bundleContext, fakeLogger, asyncWorkService);
+
+            auto update = [](std::shared_ptr<cppmicroservices::service::cm::Configuration> const& conf)
+            {
+                auto props = conf->GetProperties();
+                props["PID"] = std::string { "overridden" };
+                EXPECT_NO_THROW(conf->Update(props).get());
+            };
+
+            auto const single = configAdmin.GetConfiguration("test.single");
+            auto const instance1 = configAdmin.GetFactoryConfiguration("test.factory", "instance1");
+            auto const instance2 = configAdmin.GetFactoryConfiguration("test.factory", "instance2");
+            auto const notUpdated = configAdmin.GetFactoryConfiguration("test.factory", "instance3");
+            auto const nested = configAdmin.CreateFactoryConfiguration("test.factory~nested");
+            auto const otherFactory = configAdmin.GetFactoryConfiguration("test.factory2", "instance1");
+            update(single);
+            update(instance1);
+            update(instance2);
+            update(nested);
+            update(otherFactory);
+
+            auto pidsOf = [](std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>> const& configs)
+            {
+                std::set<std::string> pids;
+                for (auto const& config : configs)
+                {
+                    pids.insert(config->GetPid());
+                }
+                return pids;
+            };
+
+            // a "pid" property is replaced by the configuration's pid when filtering
+            EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.single)")),
+                      std::set<std::string> { "test.single" });
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=overridden)").empty());
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=test.factory~instance3)").empty());
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=unknown)").empty());
+
+            // configurations created with CreateFactoryConfiguration for a factory pid
+            // containing '~' also match the shorter factory pid
+            std::set<std::string> const factoryPids { "test.factory~instance1",
+                                                      "test.factory~instance2",
+                                                      nested->GetPid() };
+            EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.factory~*)")), factoryPids);
+            EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(&(pid=test.factory~*))")), factoryPids);
+            EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.factory~nested~*)")),
+                      std::set<std::string> { nested->GetPid() });
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=unknown~*)").empty());
+
+            // removed configurations are no longer listed
+            EXPECT_NO_THROW(instance1->Remove().get());
+            EXPECT_EQ(pidsOf(configAdmin.ListConfigurations("(pid=test.factory~*)")),
+                      (std::set<std::string> { "test.factory~instance2", nested->GetPid() }));
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=test.factory~instance1)").empty());
+
+            EXPECT_THROW(configAdmin.ListConfigurations("(pid=test.single"), std::invalid_argument);
+        }
+
+        TEST_F(TestConfigurationAdminImpl, VerifyPersistedConfigurationsAreRestored)
+        {
+            auto bundleContext = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService> asyncWorkService
+                = std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(bundleContext, fakeLogger);
+            auto const directory = std::filesystem::temp_directory_path()
+                                   / ("us_cm_admin_store_" + std::to_string(std::random_device {}()));
+            detail::ScopeGuard removeDirectory(
+                [&directory]()
+                {
+                    std::error_code ec;
+                    std::filesystem::remove_all(directory, ec);
+                });
+
+            std::string nestedFactoryPid;
+            {
+                ConfigurationAdminImpl configAdmin(
+                    bundleContext,
+                    fakeLogger,
+                    asyncWorkService,
+                    std::make_shared<ConfigurationStore>(directory.string(), fakeLogger));
+
+                auto props = AnyMap { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                props["foo"] = std::string { "bar" };
+                auto const conf = configAdmin.GetConfiguration("test.pid");
+                EXPECT_NO_THROW(conf->Update(props).get());
+                EXPECT_NO_THROW(conf->Update(props).get());
+
+                auto const instance = configAdmin.GetFactoryConfiguration("test.factory", "instance");
+                EXPECT_NO_THROW(instance->Update(props).get());
+                auto const nested = configAdmin.CreateFactoryConfiguration("test.factory~nested");
+                EXPECT_NO_THROW(nested->Update(props).get());
+                nestedFactoryPid = nested->GetPid();
+
+                auto const removed = configAdmin.GetConfiguration("test.removed");
+                EXPECT_NO_THROW(removed->Update(props).get());
+                EXPECT_NO_THROW(removed->Remove().get());
+
+                // never updated, so not restored
+                (void)configAdmin.GetConfiguration("test.notupdated");
+
+                std::vector<metadata::ConfigurationMetadata> configs;
+                configs.emplace_back("test.metadata", props);
+                (void)configAdmin.AddConfigurations(std::move(configs));
+                configAdmin.WaitForAllAsync();
+            }
+
+            ConfigurationAdminImpl configAdmin(bundleContext,
+                                               fakeLogger,
+                                               asyncWorkService,
+                                               std::make_shared<ConfigurationStore>(directory.string(), fakeLogger));
+            auto const restored = configAdmin.ListConfigurations();
+            EXPECT_EQ(restored.size(), 4u);
+
+            auto const conf = configAdmin.ListConfigurations("(pid=test.pid)");
+            ASSERT_EQ(conf.size(), 1u);
+            EXPECT_EQ(conf[0]->GetChangeCount(), 2u);
+            EXPECT_EQ(any_cast<std::string>(conf[0]->GetProperties().at("foo")), "bar");
+
+            auto const instances = configAdmin.ListConfigurations("(pid=test.factory~*)");
+            EXPECT_EQ(instances.size(), 2u);
+            auto const nested = configAdmin.ListConfigurations("(pid=" + nestedFactoryPid + ")");
+            ASSERT_EQ(nested.size(), 1u);
+            EXPECT_EQ(nested[0]->GetFactoryPid(), "test.factory~nested");
+
+            EXPECT_EQ(configAdmin.ListConfigurations("(pid=test.metadata)").size(), 1u);
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=test.removed)").empty());
+            EXPECT_TRUE(configAdmin.ListConfigurations("(pid=test.notupdated)").empty());
+
+            // restored configurations keep being persisted
+            EXPECT_NO_THROW(conf[0]->Remove().get());
+            configAdmin.WaitForAllAsync();
+        }
+
         TEST_F(TestConfigurationAdminImpl, VerifyAddConfigurations)
         {
             auto bundleContext = GetFramework().GetBundleContext();
@@ -698,6 +843,170 @@ namespace cppmicroservices
 
             configAdmin.WaitForAllAsync();
         }
+
+        TEST_F(TestConfigurationAdminImpl, VerifyUpdateBatch)
+        {
+            auto bundleContext = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService> asyncWorkService
+                = std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(bundleContext, fakeLogger);
+            ConfigurationAdminImpl configAdmin(bundleContext, fakeLogger, asyncWorkService);
+
+            auto const existing = configAdmin.GetConfiguration("batch.existing");
+            AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            props["foo"] = std::string { "bar" };
+            EXPECT_NO_THROW(existing->Update(props).get());
+
+            AnyMap intermediateProps { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            intermediateProps["foo"] = std::string { "intermediate" };
+            AnyMap newProps { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            newProps["foo"] = std::string { "baz" };
+            AnyMap emptyProps { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+
+            auto mockManagedService = std::make_shared<MockManagedService>();
+            auto mockExistingManagedService = std::make_shared<MockManagedService>();
+            auto mockManagedServiceFactory = std::make_shared<MockManagedServiceFactory>();
+            // every service receives a single notification with the latest properties
+            EXPECT_CALL(*mockExistingManagedService, Updated(AnyMapEquals(props))).Times(1);
+            EXPECT_CALL(*mockExistingManagedService, Updated(AnyMapEquals(newProps))).Times(1);
+            EXPECT_CALL(*mockManagedService, Updated(AnyMapEquals(newProps))).Times(1);
+            EXPECT_CALL(*mockManagedService, Updated(AnyMapEquals(intermediateProps))).Times(0);
+            EXPECT_CALL(*mockManagedServiceFactory,
+                        Updated(std::string { "batch.factory~instance1" }, AnyMapEquals(newProps)))
+                .Times(1);
+            EXPECT_CALL(*mockManagedServiceFactory,
+                        Updated(std::string { "batch.factory~instance2" }, AnyMapEquals(emptyProps)))
+                .Times(1);
+            EXPECT_CALL(*mockManagedServiceFactory, Removed(testing::_)).Times(0);
+
+            AnyMap pidProp { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            pidProp["pid"] = std::string("batch.factory");
+            auto reg1 = bundleContext.RegisterService<cppmicroservices::service::cm::ManagedService>(
+                mockManagedService,
+                cppmicroservices::ServiceProperties({
+                    { std::string("service.pid"), std::string("batch.pid") }
+            }));
+            auto reg2 = bundleContext.RegisterService<cppmicroservices::service::cm::ManagedService>(
+                mockExistingManagedService,
+                cppmicroservices::ServiceProperties({
+                    { std::string("service.pid"), std::string("batch.existing") }
+            }));
+            auto reg3 = bundleContext.RegisterService<cppmicroservices::service::cm::ManagedServiceFactory>(
+                mockManagedServiceFactory,
+                cppmicroservices::ServiceProperties({
+                    { std::string("service"), pidProp }
+            }));
+            configAdmin.WaitForAllAsync();
+
+            std::vector<std::pair<std::string, AnyMap>> updates { { "batch.pid", intermediateProps },
+                                                                  { "batch.existing", newProps },
+                                                                  { "batch.factory~instance1", newProps },
+                                                                  { "batch.factory~instance2", emptyProps },
+                                                                  { "batch.unused", props },
+                                                                  { "batch.pid", newProps } };
+            EXPECT_NO_THROW(configAdmin.UpdateBatch(updates).get());
+
+            // the updates are visible as soon as UpdateBatch returns
+            EXPECT_EQ(existing->GetChangeCount(), 2u);
+            EXPECT_EQ(existing->GetProperties(), newProps);
+            auto const created = configAdmin.GetConfiguration("batch.pid");
+            EXPECT_EQ(created->GetChangeCount(), 1u);
+            EXPECT_EQ(created->GetProperties(), newProps);
+            EXPECT_EQ(configAdmin.ListConfigurations("(pid=batch.factory~*)").size(), 2u);
+            EXPECT_EQ(configAdmin.ListConfigurations("(pid=batch.unused)").size(), 1u);
+
+            EXPECT_NO_THROW(configAdmin.SafeUpdateBatch({})->get());
+
+            reg1.Unregister();
+            reg2.Unregister();
+            reg3.Unregister();
+
+            configAdmin.WaitForAllAsync();
+        }
+
+        // A ConfigurationAdmin which only implements the methods that are pure virtual, and so
+        // relies on the default implementations of UpdateBatch and SafeUpdateBatch.
+        class MinimalConfigurationAdmin : public cppmicroservices::service::cm::ConfigurationAdmin
+        {
+          public:
+            explicit MinimalConfigurationAdmin(ConfigurationAdminImpl& impl) : impl(impl) {}
+
+            std::shared_ptr<cppmicroservices::service::cm::Configuration>
+            GetConfiguration(std::string const& pid) override
+            {
+                return impl.GetConfiguration(pid);
+            }
+
+            std::shared_ptr<cppmicroservices::service::cm::Configuration>
+            CreateFactoryConfiguration(std::string const& factoryPid) override
+            {
+                return impl.CreateFactoryConfiguration(factoryPid);
+            }
+
+            std::shared_ptr<cppmicroservices::service::cm::Configuration>
+            GetFactoryConfiguration(std::string const& factoryPid, std::string const& instanceName) override
+            {
+                return impl.GetFactoryConfiguration(factoryPid, instanceName);
+            }
+
+            std::vector<std::shared_ptr<cppmicroservices::service::cm::Configuration>>
+            ListConfigurations(std::string const& filter) override
+            {
+                return impl.ListConfigurations(filter);
+            }
+
+          private:
+            ConfigurationAdminImpl& impl;
+        };
+
+        TEST_F(TestConfigurationAdminImpl, VerifyDefaultUpdateBatch)
+        {
+            auto bundleContext = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            std::shared_ptr<cppmicroservices::cmimpl::CMAsyncWorkService> asyncWorkService
+                = std::make_shared<cppmicroservices::cmimpl::CMAsyncWorkService>(bundleContext, fakeLogger);
+            ConfigurationAdminImpl configAdminImpl(bundleContext, fakeLogger, asyncWorkService);
+            MinimalConfigurationAdmin configAdmin(configAdminImpl);
+
+            AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            props["foo"] = std::string { "bar" };
+            AnyMap newProps { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            newProps["foo"] = std::string { "baz" };
+
+            auto mockManagedService = std::make_shared<MockManagedService>();
+            EXPECT_CALL(*mockManagedService, Updated(AnyMapEquals(newProps))).Times(1);
+            EXPECT_CALL(*mockManagedService, Updated(AnyMapEquals(props))).Times(0);
+            auto reg = bundleContext.RegisterService<cppmicroservices::service::cm::ManagedService>(
+                mockManagedService,
+                cppmicroservices::ServiceProperties({
+                    { std::string("service.pid"), std::string("default.pid") }
+            }));
+
+            // only the last properties of a PID are applied
+            std::vector<std::pair<std::string, AnyMap>> updates { { "default.pid", props },
+                                                                  { "default.other", props },
+                                                                  { "default.pid", newProps } };
+            auto batch = configAdmin.UpdateBatch(updates);
+            // the future is not deferred, so its status can be polled
+            EXPECT_NE(batch.wait_for(std::chrono::milliseconds::zero()), std::future_status::deferred);
+            EXPECT_NO_THROW(batch.get());
+            EXPECT_EQ(batch.wait_for(std::chrono::milliseconds::zero()), std::future_status::ready);
+            EXPECT_EQ(configAdmin.UpdateBatch({}).wait_for(std::chrono::milliseconds::zero()),
+                      std::future_status::ready);
+            EXPECT_EQ(configAdminImpl.GetConfiguration("default.pid")->GetChangeCount(), 1u);
+            EXPECT_EQ(configAdminImpl.GetConfiguration("default.pid")->GetProperties(), newProps);
+            EXPECT_EQ(configAdminImpl.GetConfiguration("default.other")->GetProperties(), props);
+
+            updates = { { "default.other", newProps } };
+            auto future = configAdmin.SafeUpdateBatch(updates);
+            EXPECT_NO_THROW(future->get());
+            EXPECT_EQ(future->wait_for(0), std::future_status::ready);
+            EXPECT_EQ(configAdminImpl.GetConfiguration("default.other")->GetProperties(), newProps);
+
+            reg.Unregister();
+            configAdminImpl.WaitForAllAsync();
+        }
+
         // This test confirms that when ConfigurationAdmin shuts down the appropriate
         // Removed notifications should be sent to the ManagedService and ManagedFactoryServices.
         // Configuration objects will be added to the repository but never updated so when
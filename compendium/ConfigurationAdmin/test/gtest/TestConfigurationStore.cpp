@@ -0,0 +1,380 @@
+/*=============================================================================
+
+ Library: CppMicroServices
+
+ Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+ file at the top-level directory of this distribution and at
+ https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+
+ =============================================================================*/
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "../../src/ConfigurationStore.hpp"
+#include "Mocks.hpp"
+
+namespace cppmicroservices
+{
+    namespace cmimpl
+    {
+        namespace
+        {
+            class TestConfigurationStore : public ::testing::Test
+            {
+              protected:
+                TestConfigurationStore()
+                    : directory(std::filesystem::temp_directory_path()
+                                / ("us_cm_store_" + std::to_string(std::random_device {}())))
+                    , logger(std::make_shared<FakeLogger>())
+                {
+                }
+
+                ~TestConfigurationStore() override
+                {
+                    std::error_code ec;
+                    std::filesystem::remove_all(directory, ec);
+                }
+
+                std::unique_ptr<ConfigurationStore>
+                OpenStore(std::size_t minCompactionBytes = 1024 * 1024)
+                {
+                    return std::make_unique<ConfigurationStore>(directory.string(), logger, minCompactionBytes);
+                }
+
+                std::vector<StoredConfiguration>
+                Reload(std::size_t minCompactionBytes = 1024 * 1024)
+                {
+                    return OpenStore(minCompactionBytes)->Load();
+                }
+
+                std::string
+                LogPath() const
+                {
+                    return (directory / "configurations.log").string();
+                }
+
+                std::string
+                SnapshotPath() const
+                {
+                    return (directory / "configurations.snapshot").string();
+                }
+
+                std::filesystem::path directory;
+                std::shared_ptr<FakeLogger> logger;
+            };
+
+            std::string
+            ReadContent(std::string const& path)
+            {
+                std::ifstream file(path, std::ios::binary);
+                return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+            }
+
+            void
+            WriteContent(std::string const& path, std::string const& content)
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file << content;
+            }
+
+            AnyMap
+            MakeProperties(int value)
+            {
+                AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+                props["value"] = value;
+                return props;
+            }
+
+            StoredConfiguration const*
+            Find(std::vector<StoredConfiguration> const& configurations, std::string const& pid)
+            {
+                for (auto const& configuration : configurations)
+                {
+                    if (configuration.pid == pid)
+                    {
+                        return &configuration;
+                    }
+                }
+                return nullptr;
+            }
+        } // namespace
+
+        TEST_F(TestConfigurationStore, VerifyEmptyStore)
+        {
+            auto store = OpenStore();
+            EXPECT_TRUE(store->Load().empty());
+            store->Close();
+            EXPECT_TRUE(Reload().empty());
+        }
+
+        TEST_F(TestConfigurationStore, VerifyRecordedChangesAreRestored)
+        {
+            {
+                auto store = OpenStore();
+                ASSERT_TRUE(store->Load().empty());
+                store->RecordUpdate("test.pid", "", MakeProperties(1), 1u);
+                store->RecordUpdate("factory~instance", "factory", MakeProperties(2), 1u);
+                store->RecordUpdate("test.pid", "", MakeProperties(3), 2u);
+                store->RecordUpdate("test.removed", "", MakeProperties(4), 1u);
+                store->RecordRemove("test.removed");
+                store->Flush();
+            }
+
+            auto const configurations = Reload();
+            ASSERT_EQ(configurations.size(), 2u);
+
+            auto const single = Find(configurations, "test.pid");
+            ASSERT_NE(single, nullptr);
+            EXPECT_EQ(single->factoryPid, "");
+            EXPECT_EQ(single->changeCount, 2u);
+            EXPECT_EQ(single->properties, MakeProperties(3));
+
+            auto const instance = Find(configurations, "factory~instance");
+            ASSERT_NE(instance, nullptr);
+            EXPECT_EQ(instance->factoryPid, "factory");
+            EXPECT_EQ(instance->changeCount, 1u);
+            EXPECT_EQ(instance->properties, MakeProperties(2));
+        }
+
+        TEST_F(TestConfigurationStore, VerifyValueTypesAreRestored)
+        {
+            AnyMap nested { AnyMap::ORDERED_MAP };
+            nested["text"] = std::string("nested");
+            nested["list"] = std::vector<Any> { Any(1), Any(std::string("two")), Any(3.0) };
+
+            AnyMap props { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+            props["bool"] = true;
+            props["int"] = -1;
+            props["unsigned"] = 2u;
+            props["long"] = -3l;
+            props["unsignedLong"] = 4ul;
+            props["longLong"] = -5ll;
+            props["unsignedLongLong"] = 6ull;
+            props["float"] = 7.5f;
+            props["double"] = 8.25;
+            props["string"] = std::string("nine");
+            props["empty"] = Any();
+            props["map"] = nested;
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid", "", props, 1u);
+            }
+
+            auto const configurations = Reload();
+            ASSERT_EQ(configurations.size(), 1u);
+            auto const& restored = configurations[0].properties;
+            EXPECT_EQ(restored.GetType(), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            EXPECT_EQ(any_cast<bool>(restored.at("bool")), true);
+            EXPECT_EQ(any_cast<int>(restored.at("int")), -1);
+            EXPECT_EQ(any_cast<unsigned int>(restored.at("unsigned")), 2u);
+            EXPECT_EQ(any_cast<long>(restored.at("long")), -3l);
+            EXPECT_EQ(any_cast<unsigned long>(restored.at("unsignedLong")), 4ul);
+            EXPECT_EQ(any_cast<long long>(restored.at("longLong")), -5ll);
+            EXPECT_EQ(any_cast<unsigned long long>(restored.at("unsignedLongLong")), 6ull);
+            EXPECT_EQ(any_cast<float>(restored.at("float")), 7.5f);
+            EXPECT_EQ(any_cast<double>(restored.at("double")), 8.25);
+            EXPECT_EQ(any_cast<std::string>(restored.at("string")), "nine");
+            EXPECT_TRUE(restored.at("empty").Empty());
+
+            auto const& restoredNested = ref_any_cast<AnyMap>(restored.at("map"));
+            EXPECT_EQ(restoredNested.GetType(), AnyMap::ORDERED_MAP);
+            EXPECT_EQ(restoredNested, nested);
+
+            // empty values cannot be compared
+            auto restoredWithoutEmpty = restored;
+            restoredWithoutEmpty.erase("empty");
+            props.erase("empty");
+            EXPECT_EQ(restoredWithoutEmpty, props);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyUnsupportedValuesAreNotStored)
+        {
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid", "", MakeProperties(1), 1u);
+                auto props = MakeProperties(2);
+                props["unsupported"] = std::vector<int> { 1, 2 };
+                store->RecordUpdate("test.pid", "", props, 2u);
+            }
+
+            // the previous version must not be restored instead
+            EXPECT_TRUE(Reload().empty());
+        }
+
+        TEST_F(TestConfigurationStore, VerifyIncompleteRecordIsIgnored)
+        {
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid1", "", MakeProperties(1), 1u);
+                store->RecordUpdate("test.pid2", "", MakeProperties(2), 1u);
+            }
+
+            // simulate a crash while the last record was written
+            auto const size = std::filesystem::file_size(LogPath());
+            std::filesystem::resize_file(LogPath(), size - 3);
+
+            auto configurations = Reload();
+            ASSERT_EQ(configurations.size(), 1u);
+            EXPECT_EQ(configurations[0].pid, "test.pid1");
+
+            // the incomplete record was dropped, so changes recorded afterwards are restored
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid3", "", MakeProperties(3), 1u);
+            }
+            {
+                std::ofstream log(LogPath(), std::ios::binary | std::ios::app);
+                log << "garbage";
+            }
+            configurations = Reload();
+            ASSERT_EQ(configurations.size(), 2u);
+            EXPECT_NE(Find(configurations, "test.pid1"), nullptr);
+            EXPECT_NE(Find(configurations, "test.pid3"), nullptr);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyLogIsCompacted)
+        {
+            constexpr std::size_t minCompactionBytes = 1024;
+            {
+                auto store = OpenStore(minCompactionBytes);
+                store->Load();
+                for (unsigned long i = 1; i <= 1000; ++i)
+                {
+                    store->RecordUpdate("test.pid", "", MakeProperties(static_cast<int>(i)), i);
+                }
+                store->Flush();
+                EXPECT_LT(std::filesystem::file_size(LogPath()), 2 * minCompactionBytes);
+            }
+
+            auto const configurations = Reload(minCompactionBytes);
+            ASSERT_EQ(configurations.size(), 1u);
+            EXPECT_EQ(configurations[0].changeCount, 1000u);
+            EXPECT_EQ(configurations[0].properties, MakeProperties(1000));
+        }
+
+        TEST_F(TestConfigurationStore, VerifySupersededLogIsNotReplayed)
+        {
+            auto const oldLog = directory.string() + "/old.log";
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid", "", MakeProperties(1), 1u);
+            }
+            std::filesystem::copy_file(LogPath(), oldLog);
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid", "", MakeProperties(2), 2u);
+            }
+            // compacts the update above into the snapshot
+            Reload();
+
+            // simulate a crash after the snapshot was replaced but before the log was
+            std::filesystem::copy_file(oldLog, LogPath(), std::filesystem::copy_options::overwrite_existing);
+
+            auto const configurations = Reload();
+            ASSERT_EQ(configurations.size(), 1u);
+            EXPECT_EQ(configurations[0].changeCount, 2u);
+            EXPECT_EQ(configurations[0].properties, MakeProperties(2));
+        }
+
+        TEST_F(TestConfigurationStore, VerifyDamagedSnapshotIsPreserved)
+        {
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid1", "", MakeProperties(1), 1u);
+                store->RecordUpdate("test.pid2", "", MakeProperties(2), 1u);
+            }
+            // compacts the updates above into the snapshot
+            ASSERT_EQ(Reload().size(), 2u);
+
+            // damage the last record of the snapshot
+            auto damaged = ReadContent(SnapshotPath());
+            damaged.back() ^= 0x1;
+            WriteContent(SnapshotPath(), damaged);
+
+            auto configurations = Reload();
+            ASSERT_EQ(configurations.size(), 1u);
+            EXPECT_EQ(ReadContent(SnapshotPath() + ".corrupt"), damaged);
+
+            // the configuration which could be read is stored in a new snapshot
+            EXPECT_EQ(Reload().size(), 1u);
+            EXPECT_FALSE(std::filesystem::exists(SnapshotPath() + ".corrupt.1"));
+
+            // a snapshot which cannot be read at all is preserved along with the log
+            auto unreadable = ReadContent(SnapshotPath());
+            unreadable[0] = 'X';
+            WriteContent(SnapshotPath(), unreadable);
+            auto const log = ReadContent(LogPath());
+
+            EXPECT_TRUE(Reload().empty());
+            EXPECT_EQ(ReadContent(SnapshotPath() + ".corrupt.1"), unreadable);
+            EXPECT_EQ(ReadContent(LogPath() + ".corrupt"), log);
+            EXPECT_EQ(ReadContent(SnapshotPath() + ".corrupt"), damaged);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyLogOfAnotherSnapshotIsPreserved)
+        {
+            auto const oldSnapshot = directory.string() + "/old.snapshot";
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->Flush();
+                std::filesystem::copy_file(SnapshotPath(), oldSnapshot);
+                store->RecordUpdate("test.pid1", "", MakeProperties(1), 1u);
+            }
+            {
+                auto store = OpenStore();
+                EXPECT_EQ(store->Load().size(), 1u);
+                store->RecordUpdate("test.pid2", "", MakeProperties(2), 1u);
+            }
+            auto const log = ReadContent(LogPath());
+
+            // the log is newer than the snapshot, so its changes are not applied
+            // to it, but they are not dropped either
+            std::filesystem::copy_file(oldSnapshot, SnapshotPath(), std::filesystem::copy_options::overwrite_existing);
+            EXPECT_TRUE(Reload().empty());
+            EXPECT_EQ(ReadContent(LogPath() + ".corrupt"), log);
+        }
+
+        TEST_F(TestConfigurationStore, VerifyChangesAfterCloseAreIgnored)
+        {
+            {
+                auto store = OpenStore();
+                store->Load();
+                store->RecordUpdate("test.pid1", "", MakeProperties(1), 1u);
+                store->Close();
+                store->RecordUpdate("test.pid2", "", MakeProperties(2), 1u);
+                store->Flush();
+            }
+
+            auto const configurations = Reload();
+            ASSERT_EQ(configurations.size(), 1u);
+            EXPECT_EQ(configurations[0].pid, "test.pid1");
+        }
+    } // namespace cmimpl
+} // namespace cppmicroservices
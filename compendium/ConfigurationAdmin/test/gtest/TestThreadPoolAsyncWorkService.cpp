@@ -0,0 +1,280 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "gtest/gtest.h"
+
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+    using cppmicroservices::async::ThreadPoolAsyncWorkService;
+    using QueuePolicy = ThreadPoolAsyncWorkService::QueuePolicy;
+
+    namespace
+    {
+        ThreadPoolAsyncWorkService::Options
+        MakeOptions(std::size_t threads, QueuePolicy queuePolicy)
+        {
+            ThreadPoolAsyncWorkService::Options options;
+            options.threads = threads;
+            options.queuePolicy = queuePolicy;
+            return options;
+        }
+
+        template <typename Fn>
+        std::future<void>
+        Post(cppmicroservices::async::AsyncWorkService& service, Fn&& fn)
+        {
+            std::packaged_task<void()> task(std::forward<Fn>(fn));
+            auto future = task.get_future();
+            service.post(std::move(task));
+            return future;
+        }
+
+        // the completed task count is updated after a task's future becomes ready
+        bool
+        WaitForCompletedTasks(ThreadPoolAsyncWorkService const& pool, std::uint64_t expected)
+        {
+            auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (pool.GetMetrics().completedTasks < expected)
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            return true;
+        }
+    } // namespace
+
+    class TestThreadPoolAsyncWorkService : public ::testing::TestWithParam<QueuePolicy>
+    {
+    };
+
+    TEST_P(TestThreadPoolAsyncWorkService, RunsPostedTasks)
+    {
+        ThreadPoolAsyncWorkService pool(MakeOptions(4, GetParam()));
+        EXPECT_EQ(pool.GetThreadCount(), 4u);
+
+        std::atomic<int> count { 0 };
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 1000; ++i)
+        {
+            futures.push_back(Post(pool, [&count] { ++count; }));
+        }
+        futures.push_back(Post(pool, [] { throw std::runtime_error("task failure"); }));
+
+        for (std::size_t i = 0; i + 1 < futures.size(); ++i)
+        {
+            ASSERT_EQ(futures[i].wait_for(std::chrono::seconds(10)), std::future_status::ready);
+            EXPECT_NO_THROW(futures[i].get());
+        }
+        EXPECT_THROW(futures.back().get(), std::runtime_error);
+        EXPECT_EQ(count, 1000);
+        EXPECT_TRUE(WaitForCompletedTasks(pool, 1001));
+        EXPECT_EQ(pool.GetMetrics().queueDepth, 0u);
+        EXPECT_LE(pool.GetMetrics().maxQueueDepth, 1001u);
+    }
+
+    TEST_P(TestThreadPoolAsyncWorkService, StrandRunsTasksInOrder)
+    {
+        ThreadPoolAsyncWorkService pool(MakeOptions(4, GetParam()));
+        auto strand = pool.createStrand();
+        ASSERT_NE(strand, nullptr);
+
+        std::vector<int> order;
+        std::atomic<bool> running { false };
+        std::atomic<bool> overlapped { false };
+        std::vector<std::future<void>> futures;
+        for (int i = 0; i < 1000; ++i)
+        {
+            futures.push_back(Post(*strand,
+                                   [&, i]
+                                   {
+                                       if (running.exchange(true))
+                                       {
+                                           overlapped = true;
+                                       }
+                                       order.push_back(i);
+                                       running = false;
+                                   }));
+            // unrelated work competing for the same threads
+            Post(pool, [] { std::this_thread::yield(); });
+        }
+        for (auto& future : futures)
+        {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        }
+
+        EXPECT_FALSE(overlapped);
+        ASSERT_EQ(order.size(), 1000u);
+        for (int i = 0; i < 1000; ++i)
+        {
+            EXPECT_EQ(order[i], i);
+        }
+    }
+
+    TEST_P(TestThreadPoolAsyncWorkService, DrainsQueuedTasksOnDestruction)
+    {
+        auto pool = std::make_unique<ThreadPoolAsyncWorkService>(MakeOptions(1, GetParam()));
+        auto strand = pool->createStrand();
+
+        std::promise<void> started;
+        std::promise<void> gate;
+        auto blocker = Post(*pool,
+                            [&started, opened = gate.get_future().share()]
+                            {
+                                started.set_value();
+                                opened.wait();
+                            });
+        started.get_future().wait();
+
+        std::vector<std::future<void>> futures;
+        std::vector<std::future<void>> nested;
+        for (int i = 0; i < 100; ++i)
+        {
+            // tasks posted by queued tasks are run as well
+            auto service = pool.get();
+            futures.push_back(Post(*service, [&nested, service] { nested.push_back(Post(*service, [] {})); }));
+        }
+        auto const metrics = pool->GetMetrics();
+        EXPECT_EQ(metrics.queueDepth, 100u);
+        EXPECT_GE(metrics.maxQueueDepth, 100u);
+
+        gate.set_value();
+        pool.reset();
+
+        for (auto& future : futures)
+        {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        }
+        ASSERT_EQ(nested.size(), 100u);
+        for (auto& future : nested)
+        {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        }
+
+        // the strand outlives the pool, but its tasks are discarded
+        auto discarded = Post(*strand, [] {});
+        EXPECT_THROW(discarded.get(), std::future_error);
+    }
+
+    TEST_P(TestThreadPoolAsyncWorkService, TasksPostedDuringShutdownAreRunOrDiscarded)
+    {
+        auto pool = std::make_unique<ThreadPoolAsyncWorkService>(MakeOptions(2, GetParam()));
+        auto strand = pool->createStrand();
+
+        std::atomic<bool> done { false };
+        std::vector<std::future<void>> futures;
+        std::thread poster(
+            [&]
+            {
+                while (!done)
+                {
+                    futures.push_back(Post(*strand, [] {}));
+                }
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        pool.reset();
+        done = true;
+        poster.join();
+
+        // no task may be left in a pool without threads
+        for (auto& future : futures)
+        {
+            ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(QueuePolicies,
+                             TestThreadPoolAsyncWorkService,
+                             ::testing::Values(QueuePolicy::WorkStealing, QueuePolicy::Fifo));
+
+    TEST(TestThreadPoolAsyncWorkServiceWorkStealing, IdleThreadsStealQueuedTasks)
+    {
+        ThreadPoolAsyncWorkService pool(MakeOptions(2, QueuePolicy::WorkStealing));
+
+        // tasks posted from a pool thread are queued for that thread, which is blocked until
+        // the other thread has run all of them
+        auto outer = Post(pool,
+                          [&pool]
+                          {
+                              std::vector<std::future<void>> inner;
+                              for (int i = 0; i < 100; ++i)
+                              {
+                                  inner.push_back(Post(pool, [] {}));
+                              }
+                              for (auto& future : inner)
+                              {
+                                  if (future.wait_for(std::chrono::seconds(10)) != std::future_status::ready)
+                                  {
+                                      throw std::runtime_error("queued task was not stolen");
+                                  }
+                              }
+                          });
+        ASSERT_EQ(outer.wait_for(std::chrono::seconds(20)), std::future_status::ready);
+        EXPECT_NO_THROW(outer.get());
+        EXPECT_TRUE(WaitForCompletedTasks(pool, 101));
+
+        auto const metrics = pool.GetMetrics();
+        EXPECT_GE(metrics.stolenTasks, 100u);
+        EXPECT_EQ(metrics.queueDepth, 0u);
+        EXPECT_GE(metrics.maxLatency.count(), 0);
+        EXPECT_GE(metrics.totalLatency, metrics.maxLatency);
+    }
+
+    TEST(TestThreadPoolAsyncWorkServiceOptions, ParseOptions)
+    {
+        ThreadPoolAsyncWorkService::Options defaults = MakeOptions(2, QueuePolicy::WorkStealing);
+
+        auto options = ThreadPoolAsyncWorkService::ParseOptions("", "", defaults);
+        EXPECT_EQ(options.threads, 2u);
+        EXPECT_EQ(options.queuePolicy, QueuePolicy::WorkStealing);
+
+        options = ThreadPoolAsyncWorkService::ParseOptions("8", "fifo", defaults);
+        EXPECT_EQ(options.threads, 8u);
+        EXPECT_EQ(options.queuePolicy, QueuePolicy::Fifo);
+
+        options = ThreadPoolAsyncWorkService::ParseOptions("0", "work_stealing", MakeOptions(1, QueuePolicy::Fifo));
+        EXPECT_EQ(options.threads, 0u);
+        EXPECT_EQ(options.queuePolicy, QueuePolicy::WorkStealing);
+
+        EXPECT_THROW(ThreadPoolAsyncWorkService::ParseOptions("-1", "", defaults), std::invalid_argument);
+        EXPECT_THROW(ThreadPoolAsyncWorkService::ParseOptions("4 threads", "", defaults), std::invalid_argument);
+        EXPECT_THROW(ThreadPoolAsyncWorkService::ParseOptions("99999999999999999999999", "", defaults),
+                     std::invalid_argument);
+        EXPECT_THROW(ThreadPoolAsyncWorkService::ParseOptions("", "lifo", defaults), std::invalid_argument);
+
+        // a pool of 0 threads has one per hardware thread
+        ThreadPoolAsyncWorkService pool(options);
+        EXPECT_GE(pool.GetThreadCount(), 1u);
+    }
+} // namespace test
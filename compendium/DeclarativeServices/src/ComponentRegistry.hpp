@@ -24,6 +24,7 @@
 #define COMPONENT_REGISTRY_HPP
 
 #include "manager/ComponentManager.hpp"
+#include "manager/ReferenceTracker.hpp"
 #include <memory>
 #include <vector>
 
@@ -122,9 +123,21 @@ namespace cppmicroservices
              */
             size_t Count() const;
 
+            /**
+             * Returns the registry of the service trackers shared by the reference managers
+             * of all component configurations in the runtime
+             */
+            std::shared_ptr<ReferenceTrackerRegistry>
+            GetReferenceTrackers() const
+            {
+                return mReferenceTrackers;
+            }
+
           private:
             std::map<std::pair<unsigned long, std::string>, std::shared_ptr<ComponentManager>> mComponentsByName;
             mutable std::mutex mMapsMutex;
+            std::shared_ptr<ReferenceTrackerRegistry> const mReferenceTrackers
+                = std::make_shared<ReferenceTrackerRegistry>();
         };
     } // namespace scrimpl
 } // namespace cppmicroservices
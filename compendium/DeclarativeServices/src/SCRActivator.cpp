@@ -85,7 +85,10 @@ namespace cppmicroservices::scrimpl
         // manually
         for (auto const& bundle : context.GetBundles())
         {
-            if (bundle.GetState() & cppmicroservices::Bundle::State::STATE_ACTIVE)
+            // A bundle waiting in STATE_STARTING for its lazy activation provides its
+            // components too
+            if (bundle.GetState()
+                & (cppmicroservices::Bundle::State::STATE_ACTIVE | cppmicroservices::Bundle::State::STATE_STARTING))
             {
                 cppmicroservices::BundleEvent evt(cppmicroservices::BundleEvent::BUNDLE_STARTED, bundle);
                 BundleChanged(evt);
@@ -221,8 +224,10 @@ namespace cppmicroservices::scrimpl
             return;
         }
 
-        // TODO: revisit to include LAZY_ACTIVATION when supported by the framework
-        if (eventType & cppmicroservices::BundleEvent::BUNDLE_STARTED)
+        // A lazily started bundle provides its components before it is activated.
+        // Getting one of their services triggers the activation of the bundle.
+        if (eventType
+            & (cppmicroservices::BundleEvent::BUNDLE_STARTED | cppmicroservices::BundleEvent::BUNDLE_LAZY_ACTIVATION))
         {
             CreateExtension(bundle);
         }
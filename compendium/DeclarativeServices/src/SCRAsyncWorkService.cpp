@@ -22,15 +22,16 @@
 
 #include "SCRAsyncWorkService.hpp"
 
-#include "boost/asio/async_result.hpp"
-#include "boost/asio/packaged_task.hpp"
-#include "boost/asio/post.hpp"
-#include "boost/asio/thread_pool.hpp"
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
+
+#include <stdexcept>
 
 namespace cppmicroservices::scrimpl
 {
     using AWSInt = cppmicroservices::async::AsyncWorkService;
 
+    using cppmicroservices::async::ThreadPoolAsyncWorkService;
+
     /**
      * FallbackAsyncWorkService represents the fallback strategy in the event
      * that a AsyncWorkService is not present within the framework. It implements
@@ -41,16 +42,11 @@ namespace cppmicroservices::scrimpl
     class FallbackAsyncWorkService final : public AWSInt
     {
       public:
-        FallbackAsyncWorkService(std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
-            : logger(logger_)
+        FallbackAsyncWorkService(ThreadPoolAsyncWorkService::Options const& options,
+                                 std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
+            : threadpool(std::make_unique<ThreadPoolAsyncWorkService>(options))
+            , logger(logger_)
         {
-            Initialize();
-        }
-
-        void
-        Initialize()
-        {
-            threadpool = std::make_shared<boost::asio::thread_pool>(2);
         }
 
         void
@@ -60,15 +56,13 @@ namespace cppmicroservices::scrimpl
             {
                 try
                 {
-                    threadpool->join();
-                    threadpool->stop();
                     threadpool.reset();
                 }
                 catch (...)
                 {
                     auto exceptionPtr = std::current_exception();
                     std::string msg = "An exception has occurred while trying to shutdown "
-                                      "the fallback AWSInt "
+                                      "the fallback cppmicroservices::async::AsyncWorkService "
                                       "instance.";
                     logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING, msg, exceptionPtr);
                 }
@@ -82,21 +76,54 @@ namespace cppmicroservices::scrimpl
         {
             if (threadpool)
             {
-                using Sig = void();
-                using Result = boost::asio::async_result<decltype(task), Sig>;
-                using Handler = typename Result::completion_handler_type;
-
-                Handler handler(std::forward<decltype(task)>(task));
-
-                boost::asio::post(threadpool->get_executor(), [handler = std::move(handler)]() mutable { handler(); });
+                threadpool->post(std::move(task));
             }
         }
 
+        // createStrand returns a new AsyncWorkService instance running its tasks in order on the threadpool
+        std::shared_ptr<AsyncWorkService>
+        createStrand() override
+        {
+            return threadpool ? threadpool->createStrand() : nullptr;
+        }
+
       private:
-        std::shared_ptr<boost::asio::thread_pool> threadpool;
+        std::unique_ptr<ThreadPoolAsyncWorkService> threadpool;
         std::shared_ptr<cppmicroservices::logservice::LogService> logger;
     };
 
+    /**
+     * Reads the options of the fallback threadpool from the framework properties, using two
+     * threads and work stealing unless configured otherwise.
+     */
+    ThreadPoolAsyncWorkService::Options
+    GetFallbackOptions(cppmicroservices::BundleContext const& context,
+                       std::shared_ptr<cppmicroservices::logservice::LogService> const& logger)
+    {
+        ThreadPoolAsyncWorkService::Options defaults;
+        defaults.threads = 2;
+        auto property = [&context](std::string const& name)
+        {
+            auto const value = context.GetProperty(name);
+            return value.Empty() ? std::string() : value.ToStringNoExcept();
+        };
+        try
+        {
+            using Pool = ThreadPoolAsyncWorkService;
+            return Pool::ParseOptions(property(Pool::THREADPOOL_SIZE),
+                                      property(Pool::THREADPOOL_QUEUE_POLICY),
+                                      defaults);
+        }
+        catch (std::invalid_argument const&)
+        {
+            logger->Log(cppmicroservices::logservice::SeverityLevel::LOG_WARNING,
+                        "Ignoring the invalid threadpool configuration of the fallback "
+                        "cppmicroservices::async::AsyncWorkService.",
+                        std::current_exception());
+            return defaults;
+        }
+    }
+
     SCRAsyncWorkService::SCRAsyncWorkService(cppmicroservices::BundleContext context,
                                              std::shared_ptr<cppmicroservices::logservice::LogService> const& logger_)
         : scrContext(context)
@@ -104,6 +131,7 @@ namespace cppmicroservices::scrimpl
         , usingFallback(true)
         , asyncWorkService(nullptr)
         , logger(logger_)
+        , fallbackOptions(GetFallbackOptions(context, logger_))
     {
         {
             if (auto asyncWSSRef = context.GetServiceReference<AWSInt>(); asyncWSSRef)
@@ -115,7 +143,7 @@ namespace cppmicroservices::scrimpl
             else
             {
                 usingFallback = true;
-                asyncWorkService = std::make_shared<FallbackAsyncWorkService>(logger_);
+                asyncWorkService = std::make_shared<FallbackAsyncWorkService>(fallbackOptions, logger_);
             }
         }
 
@@ -183,7 +211,7 @@ namespace cppmicroservices::scrimpl
             currRef = ServiceReference<AWSInt>();
             usingFallback = true;
             // replace existing asyncWorkService with a fallbackAsyncWorkService
-            asyncWorkService = std::make_shared<FallbackAsyncWorkService>(logger);
+            asyncWorkService = std::make_shared<FallbackAsyncWorkService>(fallbackOptions, logger);
         }
     }
 
@@ -194,4 +222,11 @@ namespace cppmicroservices::scrimpl
         asyncWorkService->post(std::move(task));
     }
 
+    std::shared_ptr<AWSInt>
+    SCRAsyncWorkService::createStrand()
+    {
+        std::unique_lock<std::mutex> lock { m };
+        return asyncWorkService->createStrand();
+    }
+
 } // namespace cppmicroservices::scrimpl
\ No newline at end of file
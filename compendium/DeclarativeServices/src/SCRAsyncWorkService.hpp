@@ -26,6 +26,7 @@
 #include "SCRLogger.hpp"
 #include <cppmicroservices/ServiceTracker.h>
 #include <cppmicroservices/asyncworkservice/AsyncWorkService.hpp>
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
 
 #include <future>
 
@@ -60,6 +61,7 @@ namespace cppmicroservices
 
             // methods from the AWSInt interface
             void post(std::packaged_task<void()>&& task) override;
+            std::shared_ptr<AWSInt> createStrand() override;
 
             // methods from the cppmicroservices::ServiceTrackerCustomizer interface
             std::shared_ptr<TrackedParamType> AddingService(
@@ -83,7 +85,8 @@ namespace cppmicroservices
             ServiceReference<AWSInt> currRef;
             std::shared_ptr<AWSInt> asyncWorkService;
             std::shared_ptr<cppmicroservices::logservice::LogService> logger;
-            
+            // options of the threadpool used when no AsyncWorkService is registered
+            cppmicroservices::async::ThreadPoolAsyncWorkService::Options fallbackOptions;
         };
     } // namespace scrimpl
 } // namespace cppmicroservices
@@ -22,6 +22,7 @@
 
 #include "cppmicroservices/FrameworkFactory.h"
 
+#include "../ComponentRegistry.hpp"
 #include "../ConfigurationListenerImpl.hpp"
 #include "BundleLoader.hpp"
 #include "ComponentConfigurationImpl.hpp"
@@ -87,7 +88,8 @@ namespace cppmicroservices
                 auto refManager = std::make_shared<ReferenceManagerImpl>(refMetadata,
                                                                          bundle.GetBundleContext(),
                                                                          this->logger,
-                                                                         this->metadata->name);
+                                                                         this->metadata->name,
+                                                                         this->registry->GetReferenceTrackers());
                 referenceManagers.emplace(refMetadata.name, refManager);
             }
             if ((this->metadata->configurationPids.size() > 0)
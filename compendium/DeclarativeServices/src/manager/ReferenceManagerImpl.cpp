@@ -64,12 +64,14 @@ namespace cppmicroservices
             metadata::ReferenceMetadata const& metadata,
             cppmicroservices::BundleContext const& bc,
             std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-            std::string const& configName)
+            std::string const& configName,
+            std::shared_ptr<ReferenceTrackerRegistry> const& trackers)
             : ReferenceManagerBaseImpl(metadata,
                                        bc,
                                        logger,
                                        configName,
-                                       CreateBindingPolicy(*this, metadata.policy, metadata.policyOption))
+                                       CreateBindingPolicy(*this, metadata.policy, metadata.policyOption),
+                                       trackers)
         {
         }
 
@@ -78,7 +80,8 @@ namespace cppmicroservices
             cppmicroservices::BundleContext const& bc,
             std::shared_ptr<cppmicroservices::logservice::LogService> logger,
             std::string const& configName,
-            std::unique_ptr<BindingPolicy> policy)
+            std::unique_ptr<BindingPolicy> policy,
+            std::shared_ptr<ReferenceTrackerRegistry> const& trackers)
             : metadata_(metadata)
             , tracker(nullptr)
             , logger_(std::move(logger))
@@ -91,8 +94,9 @@ namespace cppmicroservices
             }
             try
             {
-                tracker = std::make_unique<ServiceTracker<void>>(bc, GetReferenceLDAPFilter(metadata_), this);
-                tracker->Open();
+                auto const filter = GetReferenceLDAPFilter(metadata_);
+                tracker = trackers ? trackers->GetTracker(bc, filter) : std::make_shared<ReferenceTracker>(bc, filter);
+                trackerSubscription = tracker->Subscribe(this);
             }
             catch (...)
             {
@@ -109,7 +113,10 @@ namespace cppmicroservices
         {
             try
             {
-                tracker->Close();
+                if (tracker && trackerSubscription)
+                {
+                    tracker->Unsubscribe(trackerSubscription);
+                }
             }
             catch (...)
             {
@@ -32,6 +32,7 @@
 #endif
 #include "ConcurrencyUtil.hpp"
 #include "ReferenceManager.hpp"
+#include "ReferenceTracker.hpp"
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/ServiceTracker.h"
 
@@ -63,13 +64,16 @@ namespace cppmicroservices
              * \param metadata - the reference description as specified in the component description
              * \param bc - the {@link BundleContext} of the bundle containing the component
              * \param logger - the logger object used to log information from this class.
+             * \param trackers - the registry of the trackers shared with the other reference managers
+             *        of the runtime, or nullptr to track the reference on its own
              *
              * \throws \c std::runtime_error if \c bc or \c logger is invalid
              */
             ReferenceManagerBaseImpl(metadata::ReferenceMetadata const& metadata,
                                      cppmicroservices::BundleContext const& bc,
                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-                                     std::string const& configName);
+                                     std::string const& configName,
+                                     std::shared_ptr<ReferenceTrackerRegistry> const& trackers = nullptr);
             ReferenceManagerBaseImpl(ReferenceManagerBaseImpl const&) = delete;
             ReferenceManagerBaseImpl(ReferenceManagerBaseImpl&&) = delete;
             ReferenceManagerBaseImpl& operator=(ReferenceManagerBaseImpl const&) = delete;
@@ -257,7 +261,8 @@ namespace cppmicroservices
                                      cppmicroservices::BundleContext const& bc,
                                      std::shared_ptr<cppmicroservices::logservice::LogService> logger,
                                      std::string const& configName,
-                                     std::unique_ptr<BindingPolicy> policy);
+                                     std::unique_ptr<BindingPolicy> policy,
+                                     std::shared_ptr<ReferenceTrackerRegistry> const& trackers = nullptr);
 
           private:
             friend class ReferenceManagerImplTest;
@@ -280,7 +285,8 @@ namespace cppmicroservices
             void BatchNotifyAllListeners(std::vector<RefChangeNotification> const& notification) noexcept;
 
             metadata::ReferenceMetadata const metadata_;   ///< reference information from the component description
-            std::unique_ptr<ServiceTracker<void>> tracker; ///< used to track service availability
+            std::shared_ptr<ReferenceTracker> tracker; ///< used to track service availability
+            std::shared_ptr<ReferenceTracker::Subscription> trackerSubscription; ///< this manager's subscription
             std::shared_ptr<cppmicroservices::logservice::LogService> logger_; ///< logger for this runtime
             std::string const
                 configName_; ///< Keep track of which component configuration object this reference manager belongs to.
@@ -308,8 +314,9 @@ namespace cppmicroservices
             ReferenceManagerImpl(metadata::ReferenceMetadata const& metadata,
                                  cppmicroservices::BundleContext const& bc,
                                  std::shared_ptr<cppmicroservices::logservice::LogService> logger,
-                                 std::string const& configName)
-                : ReferenceManagerBaseImpl(metadata, bc, logger, configName)
+                                 std::string const& configName,
+                                 std::shared_ptr<ReferenceTrackerRegistry> const& trackers = nullptr)
+                : ReferenceManagerBaseImpl(metadata, bc, logger, configName, trackers)
             {
             }
         };
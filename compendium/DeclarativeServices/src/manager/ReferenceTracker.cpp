@@ -0,0 +1,287 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#include "ReferenceTracker.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+
+        /**
+         * The state of one subscriber of a ReferenceTracker
+         */
+        class ReferenceTracker::Subscription
+        {
+          public:
+            Subscription(std::uint64_t id, cppmicroservices::ServiceTrackerCustomizer<void>* subscriber)
+                : id(id)
+                , subscriber(subscriber)
+            {
+            }
+
+            std::uint64_t const id;
+            std::recursive_mutex mutex; ///< held while calling the subscriber, recursive for nested service events
+            cppmicroservices::ServiceTrackerCustomizer<void>* subscriber; ///< nullptr once unsubscribed
+        };
+
+        namespace
+        {
+            struct dummyTrackedObj
+            {
+            };
+        } // namespace
+
+        ReferenceTracker::ReferenceTracker(cppmicroservices::BundleContext const& bc,
+                                           cppmicroservices::LDAPFilter const& filter)
+            : tracker(std::make_unique<ServiceTracker<void>>(bc, filter, this))
+        {
+            tracker->Open();
+        }
+
+        ReferenceTracker::~ReferenceTracker()
+        {
+            try
+            {
+                tracker->Close();
+            }
+            catch (...)
+            {
+                // the bundle context is no longer valid
+            }
+        }
+
+        std::shared_ptr<ReferenceTracker::Subscription>
+        ReferenceTracker::Subscribe(cppmicroservices::ServiceTrackerCustomizer<void>* subscriber)
+        {
+            std::vector<std::pair<ServiceReferenceU, std::uint64_t>> current;
+            std::shared_ptr<Subscription> subscription;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                subscription = std::make_shared<Subscription>(++nextSubscriptionId, subscriber);
+                subscriptions.emplace(subscription->id, subscription);
+                current.assign(tracked.begin(), tracked.end());
+            }
+
+            // events dispatched meanwhile wait for the subscription's mutex, so they are
+            // delivered after the services which matched when subscribing
+            std::lock_guard<std::recursive_mutex> deliveryLock(subscription->mutex);
+            for (auto const& [reference, addedGeneration] : current)
+            {
+                Deliver(*subscription, Event::Adding, reference, addedGeneration);
+            }
+            return subscription;
+        }
+
+        void
+        ReferenceTracker::Unsubscribe(std::shared_ptr<Subscription> const& subscription)
+        {
+            std::lock_guard<std::recursive_mutex> deliveryLock(subscription->mutex);
+            if (!subscription->subscriber)
+            {
+                return;
+            }
+
+            std::vector<ServiceReferenceU> current;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                subscriptions.erase(subscription->id);
+                current.reserve(tracked.size());
+                for (auto const& entry : tracked)
+                {
+                    current.push_back(entry.first);
+                }
+            }
+
+            // like ServiceTracker::Close, report every tracked service as removed
+            auto subscriber = std::exchange(subscription->subscriber, nullptr);
+            for (auto const& reference : current)
+            {
+                subscriber->RemovedService(reference, nullptr);
+            }
+        }
+
+        cppmicroservices::InterfaceMapConstPtr
+        ReferenceTracker::AddingService(cppmicroservices::ServiceReferenceU const& reference)
+        {
+            Dispatch(Event::Adding, reference);
+
+            // A non-null object must be returned to indicate to the ServiceTracker that
+            // we are tracking the service and need to be called back when the service is removed.
+            return MakeInterfaceMap<dummyTrackedObj>(std::make_shared<dummyTrackedObj>());
+        }
+
+        void
+        ReferenceTracker::ModifiedService(cppmicroservices::ServiceReferenceU const& reference,
+                                          cppmicroservices::InterfaceMapConstPtr const& /*service*/)
+        {
+            Dispatch(Event::Modified, reference);
+        }
+
+        void
+        ReferenceTracker::RemovedService(cppmicroservices::ServiceReferenceU const& reference,
+                                         cppmicroservices::InterfaceMapConstPtr const& /*service*/)
+        {
+            Dispatch(Event::Removed, reference);
+        }
+
+        void
+        ReferenceTracker::Dispatch(Event event, cppmicroservices::ServiceReferenceU const& reference)
+        {
+            std::uint64_t eventGeneration = 0;
+            std::vector<std::shared_ptr<Subscription>> current;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (event == Event::Adding)
+                {
+                    eventGeneration = ++generation;
+                    tracked[reference] = eventGeneration;
+                }
+                else if (event == Event::Removed)
+                {
+                    tracked.erase(reference);
+                }
+                current.reserve(subscriptions.size());
+                for (auto const& entry : subscriptions)
+                {
+                    current.push_back(entry.second);
+                }
+            }
+
+            // the subscribers had their own service listeners before, so a failing subscriber
+            // must not keep the others from being notified
+            std::exception_ptr firstException;
+            for (auto const& subscription : current)
+            {
+                try
+                {
+                    Deliver(*subscription, event, reference, eventGeneration);
+                }
+                catch (...)
+                {
+                    if (!firstException)
+                    {
+                        firstException = std::current_exception();
+                    }
+                }
+            }
+            if (firstException)
+            {
+                std::rethrow_exception(firstException);
+            }
+        }
+
+        void
+        ReferenceTracker::Deliver(Subscription& subscription,
+                                  Event event,
+                                  cppmicroservices::ServiceReferenceU const& reference,
+                                  std::uint64_t addedGeneration)
+        {
+            std::lock_guard<std::recursive_mutex> deliveryLock(subscription.mutex);
+            if (!subscription.subscriber)
+            {
+                return;
+            }
+
+            // Events for one service may be dispatched concurrently from different threads. Skip
+            // the ones which are out of date by the time the subscriber can be called, so that the
+            // subscriber does not keep a service which is gone.
+            bool isCurrent = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto const it = tracked.find(reference);
+                switch (event)
+                {
+                    case Event::Adding:
+                        isCurrent = (it != tracked.end() && it->second == addedGeneration);
+                        break;
+                    case Event::Modified:
+                        isCurrent = (it != tracked.end());
+                        break;
+                    case Event::Removed:
+                        isCurrent = (it == tracked.end());
+                        break;
+                }
+            }
+            if (!isCurrent)
+            {
+                return;
+            }
+
+            switch (event)
+            {
+                case Event::Adding:
+                    subscription.subscriber->AddingService(reference);
+                    break;
+                case Event::Modified:
+                    subscription.subscriber->ModifiedService(reference, nullptr);
+                    break;
+                case Event::Removed:
+                    subscription.subscriber->RemovedService(reference, nullptr);
+                    break;
+            }
+        }
+
+        std::shared_ptr<ReferenceTracker>
+        ReferenceTrackerRegistry::GetTracker(cppmicroservices::BundleContext const& bc,
+                                             cppmicroservices::LDAPFilter const& filter)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto const key = std::make_pair(bc, filter.ToString());
+            if (auto it = trackers.find(key); it != trackers.end())
+            {
+                if (auto tracker = it->second.lock())
+                {
+                    return tracker;
+                }
+            }
+
+            // forget the trackers nobody uses anymore once their number has doubled
+            if (trackers.size() >= 2 * lastSweepSize)
+            {
+                for (auto it = trackers.begin(); it != trackers.end();)
+                {
+                    it = it->second.expired() ? trackers.erase(it) : std::next(it);
+                }
+                lastSweepSize = std::max<std::size_t>(trackers.size(), 16);
+            }
+
+            auto tracker = std::make_shared<ReferenceTracker>(bc, filter);
+            trackers[key] = tracker;
+            return tracker;
+        }
+
+        std::size_t
+        ReferenceTrackerRegistry::Count() const
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return static_cast<std::size_t>(std::count_if(trackers.begin(),
+                                                          trackers.end(),
+                                                          [](auto const& entry) { return !entry.second.expired(); }));
+        }
+
+    } // namespace scrimpl
+} // namespace cppmicroservices
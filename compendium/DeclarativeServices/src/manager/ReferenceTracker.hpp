@@ -0,0 +1,163 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  =============================================================================*/
+
+#ifndef REFERENCETRACKER_HPP
+#define REFERENCETRACKER_HPP
+
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/LDAPFilter.h"
+#include "cppmicroservices/ServiceTracker.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppmicroservices
+{
+    namespace scrimpl
+    {
+        /**
+         * This class tracks the services matching an LDAP filter on behalf of any number of
+         * subscribers, typically the reference managers of all component configurations in a
+         * bundle which have a reference with the same interface and target. This way the framework
+         * has one service listener per filter instead of one per reference.
+         *
+         * Subscribers receive the callbacks of a {@link ServiceTrackerCustomizer} as if each of them
+         * had opened its own {@link ServiceTracker}: AddingService for every matching service when
+         * subscribing and when a service starts matching, RemovedService when a service stops
+         * matching and for every matching service when unsubscribing. The callbacks for one
+         * subscriber never run concurrently, while different subscribers are notified independently.
+         */
+        class ReferenceTracker final : public cppmicroservices::ServiceTrackerCustomizer<void>
+        {
+          public:
+            class Subscription;
+
+            /**
+             * Opens a ServiceTracker for the services matching \c filter
+             *
+             * \throws if the ServiceTracker cannot be opened, e.g. because \c bc is invalid
+             */
+            ReferenceTracker(cppmicroservices::BundleContext const& bc, cppmicroservices::LDAPFilter const& filter);
+            ReferenceTracker(ReferenceTracker const&) = delete;
+            ReferenceTracker(ReferenceTracker&&) = delete;
+            ReferenceTracker& operator=(ReferenceTracker const&) = delete;
+            ReferenceTracker& operator=(ReferenceTracker&&) = delete;
+
+            /**
+             * Closes the ServiceTracker. Exceptions from closing it are swallowed since the
+             * bundle context may have become invalid already.
+             */
+            ~ReferenceTracker() override;
+
+            /**
+             * Adds a subscriber and calls its AddingService for every service matching the filter.
+             * \c subscriber must stay valid until it is unsubscribed.
+             *
+             * \return the subscription to pass to #Unsubscribe
+             */
+            std::shared_ptr<Subscription> Subscribe(cppmicroservices::ServiceTrackerCustomizer<void>* subscriber);
+
+            /**
+             * Removes a subscriber and calls its RemovedService for every service matching the
+             * filter. Once this method returns, no more callbacks are made to the subscriber.
+             */
+            void Unsubscribe(std::shared_ptr<Subscription> const& subscription);
+
+            cppmicroservices::InterfaceMapConstPtr AddingService(
+                cppmicroservices::ServiceReferenceU const& reference) override;
+            void ModifiedService(cppmicroservices::ServiceReferenceU const& reference,
+                                 cppmicroservices::InterfaceMapConstPtr const& service) override;
+            void RemovedService(cppmicroservices::ServiceReferenceU const& reference,
+                                cppmicroservices::InterfaceMapConstPtr const& service) override;
+
+          private:
+            enum class Event
+            {
+                Adding,
+                Modified,
+                Removed
+            };
+
+            /**
+             * Calls the subscriber unless the event has been superseded, i.e. a service
+             * which was added has been removed again or the other way round, in which case
+             * the subscriber receives (or has received) the later event instead.
+             */
+            void Deliver(Subscription& subscription,
+                         Event event,
+                         cppmicroservices::ServiceReferenceU const& reference,
+                         std::uint64_t addedGeneration);
+
+            /**
+             * Updates the tracked services and delivers the event to all current subscribers
+             */
+            void Dispatch(Event event, cppmicroservices::ServiceReferenceU const& reference);
+
+            std::mutex mutex; ///< guards the members below, never held while calling a subscriber
+            std::map<cppmicroservices::ServiceReferenceU, std::uint64_t>
+                tracked; ///< services matching the filter, with the generation of their Adding event
+            std::uint64_t generation = 0;
+            std::uint64_t nextSubscriptionId = 0;
+            std::map<std::uint64_t, std::shared_ptr<Subscription>> subscriptions; ///< in the order they subscribed
+
+            std::unique_ptr<cppmicroservices::ServiceTracker<void>> tracker;
+        };
+
+        /**
+         * This class hands out one {@link ReferenceTracker} per bundle context and filter,
+         * shared by all reference managers using that filter. A tracker is closed once its
+         * last user releases it.
+         */
+        class ReferenceTrackerRegistry final
+        {
+          public:
+            ReferenceTrackerRegistry() = default;
+            ReferenceTrackerRegistry(ReferenceTrackerRegistry const&) = delete;
+            ReferenceTrackerRegistry& operator=(ReferenceTrackerRegistry const&) = delete;
+
+            /**
+             * Returns the tracker for \c filter in \c bc, opening a new one if there is none.
+             *
+             * \throws if a new ServiceTracker cannot be opened
+             */
+            std::shared_ptr<ReferenceTracker> GetTracker(cppmicroservices::BundleContext const& bc,
+                                                         cppmicroservices::LDAPFilter const& filter);
+
+            /**
+             * Returns the number of trackers currently in use
+             */
+            std::size_t Count() const;
+
+          private:
+            mutable std::mutex mutex;
+            std::map<std::pair<cppmicroservices::BundleContext, std::string>, std::weak_ptr<ReferenceTracker>> trackers;
+            std::size_t lastSweepSize = 16; ///< number of trackers after expired ones were last removed
+        };
+    } // namespace scrimpl
+} // namespace cppmicroservices
+
+#endif // REFERENCETRACKER_HPP
@@ -0,0 +1,108 @@
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceEvent.h>
+#include <cppmicroservices/asyncworkservice/ThreadPoolAsyncWorkService.hpp>
+
+#include "../TestUtils.hpp"
+#include <TestInterfaces/Interfaces.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace
+{
+    // number of immediate components in the BenchmarkDSActivation bundle
+    constexpr std::size_t componentCount = 10000;
+
+    /*
+     * Counts the test::Interface1 services registered by the components.
+     */
+    class Registrations
+    {
+      public:
+        void
+        ServiceChanged(cppmicroservices::ServiceEvent const& event)
+        {
+            if (event.GetType() == cppmicroservices::ServiceEvent::SERVICE_REGISTERED)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++count;
+                }
+                cv.notify_one();
+            }
+        }
+
+        bool
+        WaitFor(std::size_t expected)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, std::chrono::seconds(120), [this, expected] { return count >= expected; });
+        }
+
+      private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t count = 0;
+    };
+
+    // Measures the time from starting a bundle with 10k immediate components until DS has
+    // registered the services of all of them, with the first argument being the number of
+    // threads of DS's fallback AsyncWorkService and the second one its queue policy
+    // (0 = work stealing, 1 = fifo). Each component is activated by the same task which
+    // registers its service.
+    void
+    ActivateComponents(benchmark::State& state)
+    {
+        using namespace cppmicroservices;
+        using async::ThreadPoolAsyncWorkService;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            FrameworkConfiguration configuration {
+                { ThreadPoolAsyncWorkService::THREADPOOL_SIZE, std::to_string(state.range(0)) },
+                { ThreadPoolAsyncWorkService::THREADPOOL_QUEUE_POLICY,
+                  std::string(state.range(1) == 0 ? "work_stealing" : "fifo") }
+            };
+            auto framework = FrameworkFactory().NewFramework(configuration);
+            framework.Start();
+            auto context = framework.GetBundleContext();
+            test::InstallAndStartDS(context);
+
+            Registrations registrations;
+            context.AddServiceListener(
+                [&registrations](ServiceEvent const& event) { registrations.ServiceChanged(event); },
+                "(" + Constants::OBJECTCLASS + "=" + us_service_interface_iid<test::Interface1>() + ")");
+            state.ResumeTiming();
+
+            test::InstallAndStartBundle(context, "BenchmarkDSActivation");
+            if (!registrations.WaitFor(componentCount))
+            {
+                state.SkipWithError("not all components were activated");
+            }
+
+            state.PauseTiming();
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * componentCount));
+    }
+} // namespace
+
+BENCHMARK(ActivateComponents)
+    ->ArgsProduct({
+        {1, 2, 4, 8},
+        {0, 1}
+})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,145 @@
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+#include <cppmicroservices/ServiceInterface.h>
+
+#include "../../src/SCRLogger.hpp"
+#include "../../src/manager/ReferenceManagerImpl.hpp"
+#include "../../src/manager/ReferenceTracker.hpp"
+#include <TestInterfaces/Interfaces.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using cppmicroservices::scrimpl::ReferenceManagerImpl;
+    using cppmicroservices::scrimpl::ReferenceTrackerRegistry;
+    using cppmicroservices::scrimpl::metadata::ReferenceMetadata;
+
+    class Service1 : public test::Interface1
+    {
+      public:
+        std::string
+        Description() override
+        {
+            return "Service1";
+        }
+    };
+
+    class Service3 : public test::Interface3
+    {
+      public:
+        bool
+        isDependencyInjected() override
+        {
+            return false;
+        }
+    };
+
+    ReferenceMetadata
+    MakeReference(std::string name, std::string interfaceName)
+    {
+        ReferenceMetadata reference;
+        reference.name = std::move(name);
+        reference.interfaceName = std::move(interfaceName);
+        return reference;
+    }
+
+    /*
+     * Creates the reference managers of state.range(0) components with a
+     * test::Interface1 and a test::Interface2 reference each, either sharing their
+     * trackers (state.range(1) == 1) or with one tracker per reference.
+     */
+    class ReferenceTrackingTest : public ::benchmark::Fixture
+    {
+      public:
+        using benchmark::Fixture::SetUp;
+        using benchmark::Fixture::TearDown;
+
+        void
+        SetUp(::benchmark::State const& state)
+        {
+            using namespace cppmicroservices;
+            framework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+            framework->Start();
+            context = framework->GetBundleContext();
+            logger = std::make_shared<scrimpl::SCRLogger>(context);
+
+            auto const trackers = state.range(1) != 0 ? std::make_shared<ReferenceTrackerRegistry>() : nullptr;
+            std::vector<ReferenceMetadata> const references {
+                MakeReference("ref1", us_service_interface_iid<test::Interface1>()),
+                MakeReference("ref2", us_service_interface_iid<test::Interface2>())
+            };
+            for (std::int64_t i = 0; i < state.range(0); ++i)
+            {
+                auto const componentName = "component" + std::to_string(i);
+                for (auto const& reference : references)
+                {
+                    managers.push_back(
+                        std::make_unique<ReferenceManagerImpl>(reference, context, logger, componentName, trackers));
+                }
+            }
+        }
+
+        void
+        TearDown(::benchmark::State const&)
+        {
+            managers.clear();
+            logger.reset();
+            framework->Stop();
+            framework->WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        ~ReferenceTrackingTest() = default;
+
+        std::shared_ptr<cppmicroservices::Framework> framework;
+        cppmicroservices::BundleContext context;
+        std::shared_ptr<cppmicroservices::scrimpl::SCRLogger> logger;
+        std::vector<std::unique_ptr<ReferenceManagerImpl>> managers;
+    };
+
+    // Measures registering and unregistering a service which none of the
+    // components references.
+    BENCHMARK_DEFINE_F(ReferenceTrackingTest, registerUnreferencedService)(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            context.RegisterService<test::Interface3>(std::make_shared<Service3>()).Unregister();
+        }
+    }
+
+    // Measures registering and unregistering a service which one reference of
+    // every component is bound to.
+    BENCHMARK_DEFINE_F(ReferenceTrackingTest, registerReferencedService)(benchmark::State& state)
+    {
+        for (auto _ : state)
+        {
+            context.RegisterService<test::Interface1>(std::make_shared<Service1>()).Unregister();
+        }
+    }
+} // namespace
+
+BENCHMARK_REGISTER_F(ReferenceTrackingTest, registerUnreferencedService)
+    ->Args({ 100, 0 })
+    ->Args({ 100, 1 })
+    ->Args({ 1000, 0 })
+    ->Args({ 1000, 1 })
+    ->Args({ 10000, 0 })
+    ->Args({ 10000, 1 })
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+BENCHMARK_REGISTER_F(ReferenceTrackingTest, registerReferencedService)
+    ->Args({ 100, 0 })
+    ->Args({ 100, 1 })
+    ->Args({ 1000, 0 })
+    ->Args({ 1000, 1 })
+    ->Args({ 10000, 0 })
+    ->Args({ 10000, 1 })
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -722,5 +722,52 @@ namespace cppmicroservices
             reg.Unregister();
         }
 
+        // Reference managers with the same interface and target share one tracker, yet each of
+        // them keeps track of the matching services as if it had its own tracker.
+        TEST_P(ReferenceManagerImplTest, TestSharedTracker)
+        {
+            auto fakeMetadata = GetParam();
+            auto targetMetadata = fakeMetadata;
+            targetMetadata.target = "(foo=bar)";
+            auto bc = GetFramework().GetBundleContext();
+            auto fakeLogger = std::make_shared<FakeLogger>();
+            auto trackers = std::make_shared<ReferenceTrackerRegistry>();
+
+            auto reg1 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>());
+            {
+                ReferenceManagerImpl refManager1 { fakeMetadata, bc, fakeLogger, FakeComponentConfigName, trackers };
+                ReferenceManagerImpl refManager2 { fakeMetadata, bc, fakeLogger, FakeComponentConfigName, trackers };
+                ReferenceManagerImpl targetRefManager {
+                    targetMetadata, bc, fakeLogger, FakeComponentConfigName, trackers
+                };
+                EXPECT_EQ(trackers->Count(), 2u) << "managers with the same filter must share a tracker";
+                EXPECT_EQ(refManager1.GetTargetReferences().size(), 1u);
+                EXPECT_EQ(refManager2.GetTargetReferences().size(), 1u);
+                EXPECT_TRUE(targetRefManager.GetTargetReferences().empty());
+
+                auto reg2 = bc.RegisterService<dummy::Reference1>(std::make_shared<dummy::Reference1>(),
+                                                                  ServiceProperties({
+                                                                      {"foo", std::string("bar")}
+                }));
+                EXPECT_EQ(refManager1.GetTargetReferences().size(), 2u);
+                EXPECT_EQ(refManager2.GetTargetReferences().size(), 2u);
+                EXPECT_EQ(targetRefManager.GetTargetReferences().size(), 1u);
+                EXPECT_TRUE(refManager2.IsSatisfied());
+
+                // a manager which stopped tracking no longer sees any services, the others are unaffected
+                refManager1.StopTracking();
+                EXPECT_TRUE(refManager1.GetTargetReferences().empty());
+                reg1.Unregister();
+                EXPECT_TRUE(refManager1.GetTargetReferences().empty());
+                EXPECT_EQ(refManager2.GetTargetReferences().size(), 1u);
+                EXPECT_EQ(targetRefManager.GetTargetReferences().size(), 1u);
+
+                reg2.Unregister();
+                EXPECT_TRUE(refManager2.GetTargetReferences().empty());
+                EXPECT_TRUE(targetRefManager.GetTargetReferences().empty());
+            }
+            EXPECT_EQ(trackers->Count(), 0u) << "trackers must be closed once no manager uses them";
+        }
+
     } // namespace scrimpl
 } // namespace cppmicroservices
@@ -0,0 +1,10 @@
+#include "ServiceImpl.hpp"
+
+namespace sample
+{
+    std::string
+    DSActivationBenchmarkComponent::Description()
+    {
+        return STRINGIZE(US_BUNDLE_NAME);
+    }
+} // namespace sample
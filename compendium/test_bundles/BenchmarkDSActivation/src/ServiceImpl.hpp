@@ -0,0 +1,17 @@
+#ifndef _SERVICE_IMPL_HPP_
+#define _SERVICE_IMPL_HPP_
+
+#include "TestInterfaces/Interfaces.hpp"
+
+namespace sample
+{
+    class DSActivationBenchmarkComponent : public test::Interface1
+    {
+      public:
+        DSActivationBenchmarkComponent() = default;
+        ~DSActivationBenchmarkComponent() override = default;
+        std::string Description() override;
+    };
+} // namespace sample
+
+#endif // _SERVICE_IMPL_HPP_
@@ -38,14 +38,17 @@ DEALINGS IN THE SOFTWARE.
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <list>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <sstream>
+#include <string>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
@@ -113,6 +116,7 @@ namespace cppmicroservices
     \brief The Any class and related functions.
 
     */
+
     class Any;
 
     US_Framework_EXPORT std::ostream& newline_and_indent(std::ostream& os,
@@ -153,6 +157,12 @@ namespace cppmicroservices
         return os;
     }
 
+    template <typename ValueType>
+    ValueType* any_cast(Any* operand);
+
+    template <typename ValueType>
+    ValueType* unsafe_any_cast(Any* operand);
+
     template <typename ValueType>
     ValueType& ref_any_cast(Any& operand);
 
@@ -399,6 +409,10 @@ namespace cppmicroservices
      * of the internally stored data.
      *
      * Code taken from the Boost 1.46.1 library. Original copyright by Kevlin Henney. Modified for CppMicroServices.
+     *
+     * Values of small types which can be moved without throwing, e.g. integral types,
+     * \c bool, \c double, pointers and \c std::string, are stored inside the Any itself.
+     * Other values are allocated on the heap.
      */
     class US_Framework_EXPORT Any
     {
@@ -408,6 +422,8 @@ namespace cppmicroservices
          */
         Any();
 
+        ~Any() { Reset(); }
+
         /**
          * Creates an Any which stores the init parameter inside.
          *
@@ -420,7 +436,7 @@ namespace cppmicroservices
          * \endcode
          */
         template <typename ValueType>
-        Any(ValueType const& value) : _content(new Holder<ValueType>(value))
+        Any(ValueType const& value) : _content(Emplace<ValueType>(value))
         {
         }
 
@@ -433,7 +449,7 @@ namespace cppmicroservices
         template <typename ValueType,
                   typename
                   = std::enable_if_t<!std::is_same_v<Any, std::decay_t<ValueType>> && !std::is_reference_v<ValueType>>>
-        Any(ValueType&& value) : _content(new Holder<std::decay_t<ValueType>>(std::forward<ValueType>(value)))
+        Any(ValueType&& value) : _content(Emplace<std::decay_t<ValueType>>(std::forward<ValueType>(value)))
         {
         }
 
@@ -442,14 +458,14 @@ namespace cppmicroservices
          *
          * \param other The Any to copy
          */
-        Any(Any const& other) : _content(other._content ? other._content->Clone() : nullptr) {}
+        Any(Any const& other) : _content(other._content ? other._content->Clone(&_storage) : nullptr) {}
 
         /**
          * Move constructor.
          *
          * @param other The Any to move
          */
-        Any(Any&& other) noexcept : _content(std::move(other._content)) {}
+        Any(Any&& other) noexcept : _content(nullptr) { MoveFrom(other); }
 
         /**
          * Swaps the content of the two Anys.
@@ -459,7 +475,12 @@ namespace cppmicroservices
         Any&
         Swap(Any& rhs)
         {
-            std::swap(_content, rhs._content);
+            if (this != &rhs)
+            {
+                Any tmp(std::move(rhs));
+                rhs.MoveFrom(*this);
+                MoveFrom(tmp);
+            }
             return *this;
         }
 
@@ -547,9 +568,11 @@ namespace cppmicroservices
         Any&
         operator=(ValueType&& rhs)
         {
-            // Create a new Holder with rhs moved into its storage and store a unique_ptr to it in
-            // _content replacing the previously held value
-            _content = std::unique_ptr<Placeholder>(new Holder<ValueType>(std::forward<ValueType>(rhs)));
+            // rhs may refer to the currently held value, so create the new value
+            // before releasing the old one.
+            Any tmp(std::forward<ValueType>(rhs));
+            Reset();
+            MoveFrom(tmp);
             return *this;
         }
 
@@ -574,7 +597,11 @@ namespace cppmicroservices
         Any&
         operator=(Any&& rhs) noexcept
         {
-            _content = std::move(rhs._content);
+            if (this != &rhs)
+            {
+                Reset();
+                MoveFrom(rhs);
+            }
             return *this;
         }
 
@@ -671,7 +698,17 @@ namespace cppmicroservices
             virtual std::string ToCPP(uint8_t const increment = 0, int32_t const indent = 0) const = 0;
 
             virtual std::type_info const& Type() const = 0;
-            virtual std::unique_ptr<Placeholder> Clone() const = 0;
+
+            /**
+             * Copies this holder, into <code>storage</code> if its value type is small.
+             */
+            virtual Placeholder* Clone(void* storage) const = 0;
+
+            /**
+             * Moves this holder into <code>storage</code>. Only called for small value types.
+             */
+            virtual Placeholder* MoveTo(void* storage) noexcept = 0;
+
             virtual bool compare(Any const& lhs) const = 0;
         };
 
@@ -713,10 +750,32 @@ namespace cppmicroservices
                 return typeid(ValueType);
             }
 
-            std::unique_ptr<Placeholder>
-            Clone() const override
+            Placeholder*
+            Clone(void* storage) const override
+            {
+                if constexpr (IsSmall<ValueType>())
+                {
+                    return new (storage) Holder(_held);
+                }
+                else
+                {
+                    US_UNUSED(storage);
+                    return new Holder(_held);
+                }
+            }
+
+            Placeholder*
+            MoveTo(void* storage) noexcept override
             {
-                return std::unique_ptr<Placeholder>(new Holder(_held));
+                if constexpr (IsSmall<ValueType>())
+                {
+                    return new (storage) Holder(std::move(_held));
+                }
+                else
+                {
+                    US_UNUSED(storage);
+                    return nullptr;
+                }
             }
 
             ValueType _held;
@@ -738,12 +797,83 @@ namespace cppmicroservices
 
       private:
         template <typename ValueType>
-        friend ValueType* any_cast(Any*);
+        friend ValueType* cppmicroservices::any_cast(Any*);
+
+        template <typename ValueType>
+        friend ValueType* cppmicroservices::unsafe_any_cast(Any*);
+
+        /**
+         * Size of the inline storage, large enough for a holder of a std::string:
+         * the holder's vtable pointer plus the string.
+         */
+        static constexpr std::size_t SmallStorageSize = sizeof(void*) + sizeof(std::string);
+        static constexpr std::size_t SmallStorageAlignment
+            = alignof(void*) > alignof(double) ? alignof(void*) : alignof(double);
 
         template <typename ValueType>
-        friend ValueType* unsafe_any_cast(Any*);
+        static constexpr bool
+        IsSmall()
+        {
+            return sizeof(Holder<ValueType>) <= SmallStorageSize
+                   && alignof(Holder<ValueType>) <= SmallStorageAlignment
+                   && std::is_nothrow_move_constructible_v<ValueType>;
+        }
+
+        template <typename ValueType, typename... Args>
+        Placeholder*
+        Emplace(Args&&... args)
+        {
+            if constexpr (IsSmall<ValueType>())
+            {
+                return new (&_storage) Holder<ValueType>(std::forward<Args>(args)...);
+            }
+            else
+            {
+                return new Holder<ValueType>(std::forward<Args>(args)...);
+            }
+        }
+
+        bool
+        IsInline() const noexcept
+        {
+            return static_cast<void const*>(_content) == static_cast<void const*>(&_storage);
+        }
+
+        void
+        Reset() noexcept
+        {
+            if (IsInline())
+            {
+                _content->~Placeholder();
+            }
+            else
+            {
+                delete _content;
+            }
+            _content = nullptr;
+        }
+
+        /**
+         * Takes over the content of <code>other</code>, which is left empty.
+         * This Any must be empty.
+         */
+        void
+        MoveFrom(Any& other) noexcept
+        {
+            if (other.IsInline())
+            {
+                _content = other._content->MoveTo(&_storage);
+                other.Reset();
+            }
+            else
+            {
+                _content = other._content;
+                other._content = nullptr;
+            }
+        }
 
-        std::unique_ptr<Placeholder> _content;
+        Placeholder* _content = nullptr;
+        alignas(SmallStorageAlignment) unsigned char _storage[SmallStorageSize];
     };
 
     /**
@@ -810,7 +940,7 @@ namespace cppmicroservices
     any_cast(Any* operand)
     {
         return operand && operand->Type() == typeid(ValueType)
-                   ? &static_cast<Any::Holder<ValueType>*>(operand->_content.get())->_held
+                   ? &static_cast<Any::Holder<ValueType>*>(operand->_content)->_held
                    : nullptr;
     }
 
@@ -950,7 +1080,7 @@ namespace cppmicroservices
     ValueType*
     unsafe_any_cast(Any* operand)
     {
-        return &static_cast<Any::Holder<ValueType>*>(operand->_content.get())->_held;
+        return &static_cast<Any::Holder<ValueType>*>(operand->_content)->_held;
     }
 
     /**
@@ -27,6 +27,7 @@
 #include <initializer_list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -46,6 +47,132 @@ namespace cppmicroservices
             bool operator()(std::string const& l, std::string const& r) const;
         };
 
+        /**
+         * The container used by \c any_map::FLAT_MAP maps.
+         *
+         * Entries are stored contiguously in insertion order. A separate index of
+         * entry positions is kept sorted by a precomputed case-insensitive hash of
+         * the key, and then by the key itself. Lookups in small maps compare keys one
+         * by one, in larger maps they are binary searches over the index which mostly
+         * compare hashes. Keys which only differ in case are adjacent in the index, so
+         * case-insensitive lookups need no additional index.
+         *
+         * Building a map is cheap as long as entries are only added, copying one
+         * needs two allocations plus the ones of its keys and values. Erasing an
+         * entry other than the last one added is linear in the size of the map.
+         */
+        class US_Framework_EXPORT flat_any_map
+        {
+          public:
+            using key_type = std::string;
+            using mapped_type = Any;
+            using value_type = std::pair<key_type const, mapped_type>;
+            using size_type = std::size_t;
+            using iterator = value_type*;
+            using const_iterator = value_type const*;
+
+            iterator
+            begin() noexcept
+            {
+                return entries.data();
+            }
+            const_iterator
+            begin() const noexcept
+            {
+                return entries.data();
+            }
+            iterator
+            end() noexcept
+            {
+                return entries.data() + entries.size();
+            }
+            const_iterator
+            end() const noexcept
+            {
+                return entries.data() + entries.size();
+            }
+
+            bool
+            empty() const noexcept
+            {
+                return entries.empty();
+            }
+            size_type
+            size() const noexcept
+            {
+                return entries.size();
+            }
+
+            void clear() noexcept;
+            void reserve(size_type count);
+
+            /**
+             * Find the entry with exactly the given key.
+             */
+            iterator find(key_type const& key);
+            const_iterator find(key_type const& key) const;
+
+            /**
+             * Find an entry whose key equals the given key ignoring case. If several
+             * entries match, it is unspecified which one is returned.
+             */
+            const_iterator find_ci(key_type const& key) const;
+
+            /**
+             * The case-insensitive hash under which keys are indexed. It is the same
+             * for keys which only differ in case.
+             */
+            static std::size_t hash_key(key_type const& key) noexcept;
+
+            /**
+             * Like find() and find_ci(), for callers which look up the same key
+             * repeatedly and computed <code>hash == hash_key(key)</code> once
+             * beforehand. Keys are then mostly compared by their hashes.
+             */
+            const_iterator find(key_type const& key, std::size_t hash) const;
+            const_iterator find_ci(key_type const& key, std::size_t hash) const;
+
+            /**
+             * Check if two keys only differ in case, which is cheap to answer for
+             * a flat map.
+             */
+            bool has_case_variants() const;
+
+            template <class... Args>
+            std::pair<iterator, bool>
+            emplace(Args&&... args)
+            {
+                entries.emplace_back(std::forward<Args>(args)...);
+                return index_last();
+            }
+
+            size_type erase(key_type const& key);
+
+            bool operator==(flat_any_map const& rhs) const;
+
+          private:
+            // Up to this size, comparing keys one by one is faster than hashing the
+            // key for a binary search.
+            static constexpr size_type linear_search_limit = 16;
+
+            struct index_entry
+            {
+                std::size_t hash; // case-insensitive hash of the key
+                uint32_t pos;     // position of the entry in entries
+            };
+            using index_type = std::vector<index_entry>;
+
+            index_type::const_iterator lower_bound(std::size_t hash, key_type const& key, bool matchCase) const;
+            const_iterator find(key_type const& key, std::size_t hash, bool matchCase) const;
+
+            // Adds the last entry to the index, or removes it again if an entry
+            // with the same key already exists.
+            std::pair<iterator, bool> index_last();
+
+            std::vector<value_type> entries;
+            index_type sorted;
+        };
+
     } // namespace detail
 
     /**
@@ -59,6 +186,7 @@ namespace cppmicroservices
      * - \c any_map::ordered_any_map (a STL map)
      * - \c any_map::unordered_any_map (a STL unordered map)
      * - \c any_map::unordered_any_cimap (a STL unordered map with case insensitive key comparison)
+     * - \c any_map::flat_any_map (a vector of entries with a sorted index, see \c detail::flat_any_map)
      *
      * This class provides most of the STL functions for associated containers,
      * including forward iterators. It is typically not instantiated by clients
@@ -84,11 +212,13 @@ namespace cppmicroservices
         using unordered_any_map = std::unordered_map<std::string, Any>;
         using unordered_any_cimap
             = std::unordered_map<std::string, Any, detail::any_map_cihash, detail::any_map_ciequal>;
+        using flat_any_map = detail::flat_any_map;
         enum map_type : uint8_t
         {
             ORDERED_MAP,
             UNORDERED_MAP,
-            UNORDERED_MAP_CASEINSENSITIVE_KEYS
+            UNORDERED_MAP_CASEINSENSITIVE_KEYS,
+            FLAT_MAP
         };
 
       private:
@@ -102,7 +232,8 @@ namespace cppmicroservices
                 NONE,
                 ORDERED,
                 UNORDERED,
-                UNORDERED_CI
+                UNORDERED_CI,
+                FLAT
             };
 
             iter_type type { NONE };
@@ -129,6 +260,7 @@ namespace cppmicroservices
             using ociter = ordered_any_map::const_iterator;
             using uociter = unordered_any_map::const_iterator;
             using uocciiter = unordered_any_cimap::const_iterator;
+            using fciter = flat_any_map::const_iterator;
 
           public:
             using reference = any_map::const_reference;
@@ -143,6 +275,7 @@ namespace cppmicroservices
 
             const_iter(ociter&& it);
             const_iter(uociter&& it, iter_type type);
+            const_iter(fciter it);
 
             iterator& operator=(iterator const& x);
 
@@ -168,6 +301,7 @@ namespace cppmicroservices
                 ociter* o;
                 uociter* uo;
                 uocciiter* uoci;
+                fciter f;
             } it;
         };
 
@@ -177,6 +311,7 @@ namespace cppmicroservices
             using oiter = ordered_any_map::iterator;
             using uoiter = unordered_any_map::iterator;
             using uociiter = unordered_any_cimap::iterator;
+            using fiter = flat_any_map::iterator;
 
           public:
             using reference = any_map::reference;
@@ -190,6 +325,7 @@ namespace cppmicroservices
 
             iter(oiter&& it);
             iter(uoiter&& it, iter_type type);
+            iter(fiter it);
 
             reference operator*() const;
             pointer operator->() const;
@@ -215,6 +351,7 @@ namespace cppmicroservices
                 oiter* o;
                 uoiter* uo;
                 uociiter* uoci;
+                fiter f;
             } it;
         };
 
@@ -249,6 +386,8 @@ namespace cppmicroservices
         any_map(unordered_any_map&& m);
         any_map(unordered_any_cimap const& m);
         any_map(unordered_any_cimap&& m);
+        any_map(flat_any_map const& m);
+        any_map(flat_any_map&& m);
 
         any_map(any_map const& m);
         any_map& operator=(any_map const& m);
@@ -270,6 +409,12 @@ namespace cppmicroservices
         size_type count(key_type const& key) const;
         void clear();
 
+        /**
+         * Reserve space for at least \c count entries. Has no effect on
+         * \c ORDERED_MAP maps.
+         */
+        void reserve(size_type count);
+
         mapped_type& at(key_type const& key);
         mapped_type const& at(key_type const& key) const;
 
@@ -298,6 +443,11 @@ namespace cppmicroservices
                     auto p = uoci_m().emplace(std::forward<Args>(args)...);
                     return { iterator(std::move(p.first), iterator::UNORDERED_CI), p.second };
                 }
+                case map_type::FLAT_MAP:
+                {
+                    auto p = f_m().emplace(std::forward<Args>(args)...);
+                    return { iterator(p.first), p.second };
+                }
                 default:
                     throw std::logic_error("invalid map type");
             }
@@ -351,6 +501,7 @@ namespace cppmicroservices
         unordered_any_cimap::const_iterator beginUOCI_TypeChecked() const;
         unordered_any_cimap::const_iterator endUOCI_TypeChecked() const;
         unordered_any_cimap::const_iterator findUOCI_TypeChecked(key_type const& key) const;
+        flat_any_map const& f_m_TypeChecked() const;
         // =========================================================================
 
         ordered_any_map const& o_m() const;
@@ -359,6 +510,8 @@ namespace cppmicroservices
         unordered_any_map& uo_m();
         unordered_any_cimap const& uoci_m() const;
         unordered_any_cimap& uoci_m();
+        flat_any_map const& f_m() const;
+        flat_any_map& f_m();
 
         inline void copy_from(any_map const& m);
         inline void move_from(any_map&& m) noexcept;
@@ -369,6 +522,7 @@ namespace cppmicroservices
             ordered_any_map* o;
             unordered_any_map* uo;
             unordered_any_cimap* uoci;
+            flat_any_map* f;
         } map;
     };
 
@@ -427,6 +581,8 @@ namespace cppmicroservices
         AnyMap(unordered_any_map&& m);
         AnyMap(unordered_any_cimap const& m);
         AnyMap(unordered_any_cimap&& m);
+        AnyMap(flat_any_map const& m);
+        AnyMap(flat_any_map&& m);
 
         /**
          * Get the underlying STL container type.
@@ -220,7 +220,6 @@ namespace cppmicroservices
              *
              * @see Constants#BUNDLE_ACTIVATIONPOLICY
              * @see #Start(uint32_t)
-             * @note This option is reserved for future use and not supported yet.
              */
             START_ACTIVATION_POLICY = 0x00000002
         };
@@ -391,7 +390,9 @@ namespace cppmicroservices
          * @throws std::invalid_argument if handle or symname is empty
          * @throws std::invalid_argument if this bundle is not initialized
          *
-         * @pre  Bundle is already started and active
+         * @pre  Bundle is already started and active, or was started according to its
+         *       {@link Constants#ACTIVATION_LAZY lazy activation policy}. In the latter
+         *       case the bundle is activated first.
          *
          * @post The symbol(s) associated with the bundle gets fetched if the library is loaded
          * @post If the symbol does not exist, the API returns nullptr
@@ -1122,6 +1122,28 @@ namespace cppmicroservices
                                            cppmicroservices::AnyMap const& bundleManifest = cppmicroservices::AnyMap(
                                                cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
 
+        /**
+         * Installs all bundles from the bundle libraries at the specified locations.
+         *
+         * The bundle libraries which are not installed yet are opened and their manifests are read
+         * concurrently. The bundles are then installed one location after the other, in the order of
+         * \c locations, as if InstallBundles(std::string const&, cppmicroservices::AnyMap const&) was
+         * called for each location. In particular, the <code>BundleEvent::BUNDLE_INSTALLED</code> events
+         * are fired in this order.
+         *
+         * If the installation of a bundle library fails, the bundles from the preceding locations stay
+         * installed and the following locations are not installed.
+         *
+         * @param locations The locations of the bundle libraries to install.
+         * @return The Bundle objects of the installed bundle libraries, in the order of \c locations.
+         * @throws std::runtime_error If the BundleContext is no longer valid, or if the installation failed.
+         * @throws std::logic_error If the framework instance is no longer active
+         * @throws std::invalid_argument If a location is not a valid UTF8 string
+         *
+         * @see InstallBundles(std::string const&, cppmicroservices::AnyMap const&)
+         */
+        std::vector<Bundle> InstallBundles(std::vector<std::string> const& locations);
+
       private:
         friend US_Framework_EXPORT BundleContext MakeBundleContext(BundleContextPrivate*);
         friend BundleContext MakeBundleContext(std::shared_ptr<BundleContextPrivate> const&);
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <string_view>
 #include <vector>
 
 namespace cppmicroservices
@@ -298,6 +299,22 @@ namespace cppmicroservices
          */
         uint32_t GetCrc32() const;
 
+        /**
+         * Returns a view of the resource data which points directly into the
+         * memory mapped bundle, without copying or decompressing it.
+         *
+         * Only resources which were embedded uncompressed (e.g. by using a
+         * compression level of 0) can be accessed this way. The returned view
+         * stays valid as long as a %BundleResource object referring to this
+         * resource exists, even if the bundle is uninstalled in the meantime.
+         *
+         * @return A view of the uncompressed resource data or an empty view if
+         *         the resource is invalid, a directory, compressed, or if the
+         *         bundle's resources are not memory mapped.
+         * @see BundleResourceStream
+         */
+        std::string_view GetMappedData() const;
+
       private:
         BundleResource(std::string const& file, std::shared_ptr<BundleArchive const> const& archive);
 
@@ -317,6 +334,10 @@ namespace cppmicroservices
 
         std::unique_ptr<void, void (*)(void*)> GetData() const;
 
+        /// Returns the mapped resource data if available, otherwise the
+        /// uncompressed data as returned by GetData().
+        std::shared_ptr<void const> GetSharedData() const;
+
         std::shared_ptr<BundleResourcePrivate> d;
     };
 
@@ -183,8 +183,14 @@ namespace cppmicroservices
          *
          * A bundle with the lazy activation policy that is started with the
          * {@link Bundle#START_ACTIVATION_POLICY START_ACTIVATION_POLICY} option
-         * will wait in the {@link Bundle#STATE_STARTING STATE_STARTING} state until its
-         * library is loaded. The bundle will then be activated.
+         * will wait in the {@link Bundle#STATE_STARTING STATE_STARTING} state, without
+         * its library being loaded, until its activation is triggered. The bundle is
+         * then activated. The activation is triggered by:
+         * - Looking up a symbol of the bundle with Bundle::GetSymbol.
+         * - Getting a service which a ServiceFactory registered with the bundle's
+         *   context provides, for example a Declarative Services component of the
+         *   bundle.
+         * - Starting the bundle without the START_ACTIVATION_POLICY option.
          *
          * The activation policy value is specified as in the
          * bundle.activation_policy manifest header like:
@@ -199,6 +205,39 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern const std::string ACTIVATION_LAZY; // = "lazy";
 
+        /**
+         * Manifest header listing the symbolic names of the bundles which must be
+         * started before this bundle, and stopped after it, when the framework
+         * starts and stops the bundles concurrently. The value is either a string
+         * or an array of strings. Bundles which are not started or stopped
+         * together with this bundle are ignored.
+         *
+         * <pre>
+         *       bundle: { start_after: [ "ConfigurationBundle", "LoggingBundle" ] }
+         * </pre>
+         *
+         * @see #FRAMEWORK_BUNDLE_ACTIVATION_THREADS
+         */
+        US_Framework_EXPORT extern const std::string BUNDLE_STARTAFTER; // = "bundle.start_after";
+
+        /**
+         * Manifest header specifying the start level of a bundle. The value must be
+         * a positive <code>int</code> and defaults to 1.
+         *
+         * A bundle is only activated while the active start level of the framework
+         * is greater than or equal to its start level. Starting a bundle
+         * persistently before then marks it to be activated when the framework
+         * reaches its start level.
+         *
+         * <pre>
+         *       bundle: { start_level: 3 }
+         * </pre>
+         *
+         * @see #FRAMEWORK_BEGINNING_STARTLEVEL
+         * @see Framework#SetStartLevel(uint32_t)
+         */
+        US_Framework_EXPORT extern const std::string BUNDLE_STARTLEVEL; // = "bundle.start_level";
+
         /**
          * Framework environment property identifying the Framework version.
          *
@@ -246,6 +285,22 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern const std::string FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT; // = "onFirstInit";
 
+        /**
+         * Framework launching property specifying if installed bundles are
+         * recorded in the persistent storage area of the framework. If set to
+         * <code>true</code>, the installed bundles, their manifests and their
+         * autostart settings are restored when the framework is initialized
+         * again, without re-reading bundles whose files did not change.
+         *
+         * The value must be a <code>bool</code>. By default, installed bundles
+         * are only kept in memory.
+         *
+         * @see #FRAMEWORK_STORAGE
+         * @see #FRAMEWORK_STORAGE_CLEAN
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_STORAGE_PERSISTENT; // = "org.cppmicroservices.framework.storage.persistent";
+
         /**
          * The framework's threading support property key name.
          * This property's default value is "single".
@@ -317,6 +372,36 @@ namespace cppmicroservices
         US_Framework_EXPORT extern const std::string
             FRAMEWORK_BUNDLE_VALIDATION_FUNC; // = "org.cppmicroservices.framework.bundle.validation.function"
 
+        /**
+         * Framework launching property specifying the number of threads used to
+         * start the bundles marked to be started when the framework starts, and to
+         * stop the active bundles when the framework stops.
+         *
+         * If this property is set, bundles are started concurrently, except that a
+         * bundle is started after the bundles listed in its
+         * {@link #BUNDLE_STARTAFTER bundle.start_after} manifest header and stopped
+         * before them. The time taken to start or stop each bundle is reported with
+         * a FrameworkEvent::FRAMEWORK_INFO event. A value less than one uses the
+         * number of hardware threads.
+         *
+         * The value must be an <code>int</code>. By default, bundles are started in
+         * bundle id order and stopped in reverse bundle id order, one at a time.
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BUNDLE_ACTIVATION_THREADS; // = "org.cppmicroservices.framework.bundle.activation.threads"
+
+        /**
+         * Framework launching property specifying the active start level of the
+         * framework after it is launched. Only the bundles whose
+         * {@link #BUNDLE_STARTLEVEL bundle.start_level} is less than or equal to
+         * this value are started by Framework::Start(). The start level can be
+         * raised or lowered afterwards with Framework::SetStartLevel(uint32_t).
+         *
+         * The value must be a positive <code>int</code> and defaults to 1.
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_BEGINNING_STARTLEVEL; // = "org.cppmicroservices.framework.startlevel.beginning"
+
         /**
          * Framework property specifying a shutdown callback invoked after
          * waitForStop() completes.
@@ -331,6 +416,19 @@ namespace cppmicroservices
          */
         US_Framework_EXPORT extern std::string const FRAMEWORK_EXTRA_SHUTDOWN_FUNC; // = "org.cppmicroservices.framework.shutdown.function"
 
+        /**
+         * Framework launching property specifying the service property keys for
+         * which the service registry maintains a secondary index. Service lookups
+         * whose filter requires one of these keys to equal a value (possibly as a
+         * term of an AND filter) only evaluate the filter against the services
+         * with a matching value instead of all candidate services.
+         *
+         * The value must be a <code>std::vector<std::string></code>. By default,
+         * no service properties are indexed.
+         */
+        US_Framework_EXPORT extern const std::string
+            FRAMEWORK_SERVICE_INDEXED_PROPERTIES; // = "org.cppmicroservices.framework.service.indexed.properties"
+
         /*
          * Service properties.
          */
@@ -30,6 +30,7 @@
 #include <map>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -172,6 +173,70 @@ namespace cppmicroservices
         void Start(uint32_t options);
 #endif
 
+        /**
+         * Start several bundles of this Framework.
+         *
+         * <p>
+         * Calling this method is the same as calling Bundle::Start(uint32_t) on each
+         * bundle, in the order of \c bundles, unless the framework property
+         * {@link Constants#FRAMEWORK_BUNDLE_ACTIVATION_THREADS} is set. In that case
+         * the bundles are started concurrently, honoring their
+         * {@link Constants#BUNDLE_STARTAFTER bundle.start_after} manifest headers, and the
+         * time taken to start each bundle is reported with a
+         * {@link FrameworkEvent#FRAMEWORK_INFO} event.
+         *
+         * <p>
+         * All bundles are started even if one of them fails to start. The first failure,
+         * in the order of \c bundles, is then rethrown.
+         *
+         * @param bundles The bundles to start.
+         * @param options The options passed to Bundle::Start(uint32_t) for each bundle.
+         * @throws std::invalid_argument If one of the bundles is invalid.
+         * @throws std::runtime_error If a bundle could not be started.
+         * @see Bundle#Start(uint32_t)
+         */
+        void StartBundles(std::vector<Bundle> const& bundles, uint32_t options = 0);
+
+        /**
+         * Returns the active start level of this Framework.
+         *
+         * <p>
+         * Only bundles whose {@link Constants#BUNDLE_STARTLEVEL bundle.start_level}
+         * manifest header is less than or equal to the active start level are
+         * activated. When the Framework is initialized, the active start level is set
+         * to the value of the {@link Constants#FRAMEWORK_BEGINNING_STARTLEVEL}
+         * launching property.
+         *
+         * @return The active start level of this Framework.
+         * @see #SetStartLevel(uint32_t)
+         */
+        uint32_t GetStartLevel() const;
+
+        /**
+         * Changes the active start level of this Framework.
+         *
+         * <p>
+         * This method returns immediately. The active start level is then moved
+         * towards \c startLevel one level at a time, in a background thread:
+         * <ul>
+         * <li>When raising the start level, the bundles of the next level which are
+         * marked to be started are started. The bundles of one level are started
+         * concurrently if the {@link Constants#FRAMEWORK_BUNDLE_ACTIVATION_THREADS}
+         * property is set.</li>
+         * <li>When lowering the start level, the active bundles of the current level
+         * are stopped without changing their autostart setting.</li>
+         * </ul>
+         * A {@link FrameworkEvent#FRAMEWORK_STARTLEVEL_CHANGED} event is fired each
+         * time a level is reached. Calling this method again while a change is in
+         * progress redirects it to the new start level.
+         *
+         * @param startLevel The new active start level.
+         * @throws std::invalid_argument If \c startLevel is zero.
+         * @throws std::logic_error If this Framework is not starting or active.
+         * @see #GetStartLevel()
+         */
+        void SetStartLevel(uint32_t startLevel);
+
         /**
          * Stop this Framework.
          *
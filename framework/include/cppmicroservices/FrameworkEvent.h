@@ -88,6 +88,17 @@ namespace cppmicroservices
              */
             FRAMEWORK_ERROR = 0x00000002,
 
+            /**
+             * The active start level of the Framework has changed.
+             *
+             * <p>
+             * This event is fired by Framework::SetStartLevel(uint32_t) each time
+             * the Framework has reached the next start level, after the bundles of
+             * that level have been started or stopped. The source of this event is
+             * the System Bundle.
+             */
+            FRAMEWORK_STARTLEVEL_CHANGED = 0x00000008,
+
             /**
              * A warning has occurred.
              *
@@ -187,6 +198,7 @@ namespace cppmicroservices
          * <ul>
          * <li>{@link #FRAMEWORK_STARTED}
          * <li>{@link #FRAMEWORK_ERROR}
+         * <li>{@link #FRAMEWORK_STARTLEVEL_CHANGED}
          * <li>{@link #FRAMEWORK_WARNING}
          * <li>{@link #FRAMEWORK_INFO}
          * <li>{@link #FRAMEWORK_STOPPED}
@@ -25,6 +25,8 @@
 
 #include "cppmicroservices/AnyMap.h"
 
+#include <cstdint>
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4251)
@@ -108,6 +110,35 @@ namespace cppmicroservices
     {
 
       public:
+        /**
+         * Counters describing the framework-wide cache of parsed filter
+         * expressions.
+         *
+         * Filter strings are parsed once and the resulting expression is
+         * shared by every <code>LDAPFilter</code>, service listener and
+         * service lookup using the same string, until it is evicted as
+         * the least recently used entry.
+         *
+         * @see GetCacheStatistics()
+         */
+        struct CacheStatistics
+        {
+            std::uint64_t hits;      ///< Lookups answered by an already parsed expression.
+            std::uint64_t misses;    ///< Lookups which required parsing the filter string.
+            std::uint64_t evictions; ///< Expressions dropped to stay within the capacity.
+            std::size_t size;        ///< Number of currently cached expressions.
+            std::size_t capacity;    ///< Maximum number of cached expressions.
+        };
+
+        /**
+         * Returns a snapshot of the counters of the parsed filter cache.
+         *
+         * The cache is shared by all frameworks in the process.
+         *
+         * @return The current cache statistics.
+         */
+        static CacheStatistics GetCacheStatistics();
+
         /**
          * Creates a valid <code>LDAPFilter</code> object that
          * matches nothing.
@@ -47,6 +47,10 @@ namespace cppmicroservices
                                           std::size_t size,
                                           std::ios_base::openmode mode);
 
+            explicit BundleResourceBuffer(std::shared_ptr<void const> data,
+                                          std::size_t size,
+                                          std::ios_base::openmode mode);
+
             ~BundleResourceBuffer() override;
 
           private:
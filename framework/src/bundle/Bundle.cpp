@@ -351,6 +351,8 @@ namespace cppmicroservices
             throw std::invalid_argument("Error : Either bundle or inputs supplied are invalid!");
         }
 
+        // Looking up a symbol triggers the activation of a lazily started bundle
+        d->TriggerLazyActivation();
         if (STATE_ACTIVE != GetState())
         {
             throw std::runtime_error("Bundle is not started and active!");
@@ -0,0 +1,263 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "BundleActivationScheduler.h"
+
+#include "cppmicroservices/Constants.h"
+#include "cppmicroservices/FrameworkEvent.h"
+
+#include "BundlePrivate.h"
+#include "CoreBundleContext.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace cppmicroservices
+{
+
+    namespace
+    {
+
+        /*
+          Returns, for each bundle, the indices of the bundles in the set which are
+          listed in its bundle.start_after manifest header. The header is either a
+          single symbolic name or a list of symbolic names; names of bundles which
+          are not in the set are ignored.
+        */
+        std::vector<std::vector<std::size_t>>
+        GetStartAfter(std::vector<std::shared_ptr<BundlePrivate>> const& bundles)
+        {
+            std::unordered_map<std::string, std::vector<std::size_t>> indicesByName;
+            for (std::size_t i = 0; i < bundles.size(); ++i)
+            {
+                indicesByName[bundles[i]->symbolicName].push_back(i);
+            }
+
+            std::vector<std::vector<std::size_t>> startAfter(bundles.size());
+            for (std::size_t i = 0; i < bundles.size(); ++i)
+            {
+                auto const& headers = bundles[i]->GetHeaders();
+                auto header = headers.find(Constants::BUNDLE_STARTAFTER);
+                if (header == headers.end())
+                {
+                    continue;
+                }
+
+                std::vector<std::string> names;
+                if (header->second.Type() == typeid(std::string))
+                {
+                    names.push_back(ref_any_cast<std::string>(header->second));
+                }
+                else if (header->second.Type() == typeid(std::vector<Any>))
+                {
+                    for (auto const& name : ref_any_cast<std::vector<Any>>(header->second))
+                    {
+                        if (name.Type() == typeid(std::string))
+                        {
+                            names.push_back(ref_any_cast<std::string>(name));
+                        }
+                    }
+                }
+
+                for (auto const& name : names)
+                {
+                    auto indices = indicesByName.find(name);
+                    if (indices == indicesByName.end())
+                    {
+                        continue;
+                    }
+                    for (auto j : indices->second)
+                    {
+                        if (j != i)
+                        {
+                            startAfter[i].push_back(j);
+                        }
+                    }
+                }
+            }
+            return startAfter;
+        }
+
+    } // namespace
+
+    BundleActivationScheduler::BundleActivationScheduler(CoreBundleContext* coreCtx, unsigned int numThreads)
+        : coreCtx(coreCtx)
+        , numThreads(std::max(numThreads, 1u))
+    {
+    }
+
+    void
+    BundleActivationScheduler::Start(std::vector<std::shared_ptr<BundlePrivate>> const& bundles,
+                                     Action const& start) const
+    {
+        Run(bundles, GetStartAfter(bundles), start, "started");
+    }
+
+    void
+    BundleActivationScheduler::Stop(std::vector<std::shared_ptr<BundlePrivate>> const& bundles,
+                                    Action const& stop) const
+    {
+        // A bundle is stopped after the bundles which start after it
+        auto startAfter = GetStartAfter(bundles);
+        std::vector<std::vector<std::size_t>> stopAfter(bundles.size());
+        for (std::size_t i = 0; i < startAfter.size(); ++i)
+        {
+            for (auto j : startAfter[i])
+            {
+                stopAfter[j].push_back(i);
+            }
+        }
+        Run(bundles, stopAfter, stop, "stopped");
+    }
+
+    void
+    BundleActivationScheduler::Run(std::vector<std::shared_ptr<BundlePrivate>> const& bundles,
+                                   std::vector<std::vector<std::size_t>> const& waitFor,
+                                   Action const& action,
+                                   std::string const& operation) const
+    {
+        auto const count = bundles.size();
+
+        // For each bundle, the number of bundles it still waits for and the
+        // bundles waiting for it.
+        std::vector<std::size_t> pending(count);
+        std::vector<std::vector<std::size_t>> waiting(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            pending[i] = waitFor[i].size();
+            for (auto j : waitFor[i])
+            {
+                waiting[j].push_back(i);
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::size_t> ready;
+        std::vector<bool> scheduled(count, false);
+        std::vector<bool> cyclic(count, false);
+        std::size_t running = 0;
+        std::size_t done = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (pending[i] == 0)
+            {
+                scheduled[i] = true;
+                ready.push_back(i);
+            }
+        }
+
+        auto worker = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cv.wait(lock, [&] { return !ready.empty() || done == count || running == 0; });
+                if (done == count)
+                {
+                    return;
+                }
+                if (ready.empty())
+                {
+                    // Nothing runs and nothing is ready: the remaining bundles wait for
+                    // each other. Break the cycle at the first of them.
+                    auto next = static_cast<std::size_t>(std::find(scheduled.begin(), scheduled.end(), false)
+                                                         - scheduled.begin());
+                    scheduled[next] = true;
+                    cyclic[next] = true;
+                    ready.push_back(next);
+                }
+
+                auto const i = ready.front();
+                ready.pop_front();
+                ++running;
+                lock.unlock();
+
+                auto const& b = bundles[i];
+                if (cyclic[i])
+                {
+                    coreCtx->listeners.SendFrameworkEvent(
+                        FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_WARNING,
+                                       MakeBundle(b),
+                                       "Bundle " + b->symbolicName + " is part of a cycle of "
+                                           + Constants::BUNDLE_STARTAFTER + " dependencies"));
+                }
+
+                auto const begin = std::chrono::steady_clock::now();
+                try
+                {
+                    action(b);
+                }
+                catch (...)
+                {
+                    coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                                         MakeBundle(b),
+                                                                         std::string(),
+                                                                         std::current_exception()));
+                }
+                std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - begin;
+
+                std::ostringstream msg;
+                msg << "Bundle " << b->symbolicName << " " << operation << " in " << std::fixed
+                    << std::setprecision(3) << elapsed.count() << " ms";
+                coreCtx->listeners.SendFrameworkEvent(
+                    FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_INFO, MakeBundle(b), msg.str()));
+
+                lock.lock();
+                --running;
+                ++done;
+                for (auto j : waiting[i])
+                {
+                    if (--pending[j] == 0 && !scheduled[j])
+                    {
+                        scheduled[j] = true;
+                        ready.push_back(j);
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < std::min<std::size_t>(numThreads, count); ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+#else
+        worker();
+#endif
+    }
+
+} // namespace cppmicroservices
@@ -0,0 +1,88 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_BUNDLEACTIVATIONSCHEDULER_H
+#define CPPMICROSERVICES_BUNDLEACTIVATIONSCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    class CoreBundleContext;
+    class BundlePrivate;
+
+    /**
+     * Starts or stops a set of bundles on several threads.
+     *
+     * A bundle listing other bundles of the set in its
+     * Constants::BUNDLE_STARTAFTER manifest header is started after them and
+     * stopped before them. Bundles which do not depend on each other are
+     * processed concurrently. The time taken by each bundle is reported with a
+     * FrameworkEvent::FRAMEWORK_INFO event.
+     *
+     * @remarks This class is thread-safe.
+     */
+    class BundleActivationScheduler
+    {
+      public:
+        using Action = std::function<void(std::shared_ptr<BundlePrivate> const&)>;
+
+        /**
+         * @param coreCtx The framework the bundles belong to.
+         * @param numThreads The number of threads processing the bundles,
+         *        including the calling thread.
+         */
+        BundleActivationScheduler(CoreBundleContext* coreCtx, unsigned int numThreads);
+
+        /**
+         * Call start for each bundle, after it was called for the bundles it
+         * starts after. Returns when all bundles have been processed.
+         */
+        void Start(std::vector<std::shared_ptr<BundlePrivate>> const& bundles, Action const& start) const;
+
+        /**
+         * Call stop for each bundle, after it was called for the bundles which
+         * start after it. Returns when all bundles have been processed.
+         */
+        void Stop(std::vector<std::shared_ptr<BundlePrivate>> const& bundles, Action const& stop) const;
+
+      private:
+        /**
+         * Run action on the bundles, where waitFor[i] holds the indices of the
+         * bundles which must be processed before bundles[i].
+         */
+        void Run(std::vector<std::shared_ptr<BundlePrivate>> const& bundles,
+                 std::vector<std::vector<std::size_t>> const& waitFor,
+                 Action const& action,
+                 std::string const& operation) const;
+
+        CoreBundleContext* const coreCtx;
+        unsigned int const numThreads;
+    };
+
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_BUNDLEACTIVATIONSCHEDULER_H
@@ -170,7 +170,15 @@ namespace cppmicroservices
     void
     BundleArchive::SetAutostartSetting(int32_t setting)
     {
+        if (autostartSetting == setting)
+        {
+            return;
+        }
         autostartSetting = setting;
+        if (storage)
+        {
+            storage->AutostartSettingChanged(this);
+        }
     }
 
     std::shared_ptr<BundleResourceContainer>
@@ -185,4 +193,14 @@ namespace cppmicroservices
         return manifest;
     }
 
+    void
+    BundleArchive::CacheManifest(AnyMap const& bundleManifest)
+    {
+        if (storage && storage->KeepsManifests())
+        {
+            manifest = bundleManifest;
+            storage->ManifestCached(this);
+        }
+    }
+
 } // namespace cppmicroservices
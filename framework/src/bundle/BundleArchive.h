@@ -157,6 +157,14 @@ namespace cppmicroservices
          */
         AnyMap const& GetInjectedManifest() const;
 
+        /**
+         * Keep the manifest read from the bundle if the storage persists it,
+         * so that it can be injected when the archive is restored.
+         *
+         * @param bundleManifest The parsed manifest.
+         */
+        void CacheManifest(AnyMap const& bundleManifest);
+
       private:
         BundleStorage* const storage;
         const std::shared_ptr<BundleResourceContainer> resourceContainer;
@@ -475,4 +475,18 @@ namespace cppmicroservices
         return b->coreCtx->bundleRegistry.Install(location, b.get(), bundleManifest);
     }
 
+    std::vector<Bundle>
+    BundleContext::InstallBundles(std::vector<std::string> const& locations)
+    {
+        if (!d)
+        {
+            throw cppmicroservices::IllegalStateException("The bundle context is no longer valid");
+        }
+
+        d->CheckValid();
+        auto b = GetAndCheckBundlePrivate(d);
+
+        return b->coreCtx->bundleRegistry.Install(locations, b.get());
+    }
+
 } // namespace cppmicroservices
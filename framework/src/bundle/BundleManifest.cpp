@@ -22,10 +22,15 @@
 
 #include "BundleManifest.h"
 
+#include "cppmicroservices/util/BinaryManifest.h"
+
+#include "BundleResourceContainer.h"
+
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
 
+#include <sstream>
 #include <stdexcept>
 #include <typeinfo>
 
@@ -161,6 +166,252 @@ namespace cppmicroservices
             }
         }
 
+        bool
+        ParseBinaryValue(binarymanifest::Reader& reader, int depth, Any& any)
+        {
+            using binarymanifest::Tag;
+
+            Tag tag = Tag::Null;
+            if (depth > binarymanifest::MAX_DEPTH || !reader.ReadTag(tag))
+            {
+                return false;
+            }
+
+            // mirrors ParseJsonValue
+            switch (tag)
+            {
+                case Tag::Null:
+                    any = Any();
+                    return true;
+                case Tag::False:
+                case Tag::True:
+                    any = (tag == Tag::True);
+                    return true;
+                case Tag::Int:
+                {
+                    int32_t value = 0;
+                    if (!reader.ReadInt32(value))
+                    {
+                        return false;
+                    }
+                    any = static_cast<int>(value);
+                    return true;
+                }
+                case Tag::Double:
+                {
+                    double value = 0;
+                    if (!reader.ReadDouble(value))
+                    {
+                        return false;
+                    }
+                    any = value;
+                    return true;
+                }
+                case Tag::String:
+                {
+                    std::string_view value;
+                    if (!reader.ReadString(value))
+                    {
+                        return false;
+                    }
+                    if (!value.empty() && value[0] == '%')
+                    {
+                        value.remove_prefix(1);
+                    }
+                    any = std::string(value);
+                    return true;
+                }
+                case Tag::Array:
+                {
+                    uint32_t count = 0;
+                    if (!reader.ReadUInt32(count) || count > reader.Remaining())
+                    {
+                        return false;
+                    }
+                    any = AnyVector();
+                    auto& anyVector = ref_any_cast<AnyVector>(any);
+                    anyVector.reserve(count);
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        Any value;
+                        if (!ParseBinaryValue(reader, depth + 1, value))
+                        {
+                            return false;
+                        }
+                        if (!value.Empty())
+                        {
+                            anyVector.emplace_back(std::move(value));
+                        }
+                    }
+                    return true;
+                }
+                case Tag::Long:
+                {
+                    int64_t value = 0;
+                    if (!reader.ReadInt64(value))
+                    {
+                        return false;
+                    }
+                    any = static_cast<long>(value);
+                    return true;
+                }
+                case Tag::Object:
+                case Tag::TypedObject:
+                {
+                    uint8_t type = AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS;
+                    uint32_t count = 0;
+                    if ((tag == Tag::TypedObject && (!reader.ReadUInt8(type) || type > AnyMap::FLAT_MAP))
+                        || !reader.ReadUInt32(count) || count > reader.Remaining())
+                    {
+                        return false;
+                    }
+                    any = AnyMap(static_cast<AnyMap::map_type>(type));
+                    auto& anyMap = ref_any_cast<AnyMap>(any);
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        std::string_view key;
+                        Any value;
+                        if (!reader.ReadString(key) || !ParseBinaryValue(reader, depth + 1, value))
+                        {
+                            return false;
+                        }
+                        if (!value.Empty())
+                        {
+                            anyMap.emplace(std::string(key), std::move(value));
+                        }
+                    }
+                    return true;
+                }
+                case Tag::OrderedObject:
+                {
+                    uint32_t count = 0;
+                    if (!reader.ReadUInt32(count) || count > reader.Remaining())
+                    {
+                        return false;
+                    }
+                    any = AnyOrderedMap();
+                    auto& orderedMap = ref_any_cast<AnyOrderedMap>(any);
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        std::string_view key;
+                        Any value;
+                        if (!reader.ReadString(key) || !ParseBinaryValue(reader, depth + 1, value))
+                        {
+                            return false;
+                        }
+                        if (!value.Empty())
+                        {
+                            orderedMap.emplace(std::string(key), std::move(value));
+                        }
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool WriteBinaryValue(Any const& any, int depth, binarymanifest::Writer& writer);
+
+        template <typename Map>
+        bool
+        WriteBinaryMembers(Map const& map, int depth, binarymanifest::Writer& writer)
+        {
+            writer.WriteUInt32(static_cast<uint32_t>(map.size()));
+            for (auto const& member : map)
+            {
+                writer.WriteString(member.first);
+                if (!WriteBinaryValue(member.second, depth + 1, writer))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool
+        WriteBinaryMap(AnyMap const& map, int depth, binarymanifest::Writer& writer)
+        {
+            using binarymanifest::Tag;
+
+            if (map.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            {
+                writer.WriteTag(Tag::Object);
+            }
+            else
+            {
+                writer.WriteTag(Tag::TypedObject);
+                writer.WriteUInt8(static_cast<uint8_t>(map.GetType()));
+            }
+            return WriteBinaryMembers(map, depth, writer);
+        }
+
+        // The inverse of ParseBinaryValue, for the types it creates. Empty values
+        // are not written, because ParseBinaryValue drops them.
+        bool
+        WriteBinaryValue(Any const& any, int depth, binarymanifest::Writer& writer)
+        {
+            using binarymanifest::Tag;
+
+            auto const& type = any.Type();
+            if (depth > binarymanifest::MAX_DEPTH)
+            {
+                return false;
+            }
+            if (type == typeid(std::string))
+            {
+                // ParseBinaryValue removes a leading '%', like ParseJsonValue
+                auto const& value = ref_any_cast<std::string>(any);
+                writer.WriteTag(Tag::String);
+                writer.WriteString(!value.empty() && value[0] == '%' ? "%" + value : value);
+            }
+            else if (type == typeid(bool))
+            {
+                writer.WriteTag(ref_any_cast<bool>(any) ? Tag::True : Tag::False);
+            }
+            else if (type == typeid(int))
+            {
+                writer.WriteTag(Tag::Int);
+                writer.WriteInt32(static_cast<int32_t>(ref_any_cast<int>(any)));
+            }
+            else if (type == typeid(long))
+            {
+                writer.WriteTag(Tag::Long);
+                writer.WriteInt64(static_cast<int64_t>(ref_any_cast<long>(any)));
+            }
+            else if (type == typeid(double))
+            {
+                writer.WriteTag(Tag::Double);
+                writer.WriteDouble(ref_any_cast<double>(any));
+            }
+            else if (type == typeid(AnyVector))
+            {
+                auto const& values = ref_any_cast<AnyVector>(any);
+                writer.WriteTag(Tag::Array);
+                writer.WriteUInt32(static_cast<uint32_t>(values.size()));
+                for (auto const& value : values)
+                {
+                    if (!WriteBinaryValue(value, depth + 1, writer))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (type == typeid(AnyMap))
+            {
+                return WriteBinaryMap(ref_any_cast<AnyMap>(any), depth, writer);
+            }
+            else if (type == typeid(AnyOrderedMap))
+            {
+                writer.WriteTag(Tag::OrderedObject);
+                return WriteBinaryMembers(ref_any_cast<AnyOrderedMap>(any), depth, writer);
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
     } // namespace
 
     BundleManifest::BundleManifest() : m_Headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS) {}
@@ -185,6 +436,75 @@ namespace cppmicroservices
         ParseJsonObject(root, m_Headers);
     }
 
+    bool
+    BundleManifest::Load(BundleResourceContainer& container, std::string const& symbolicName)
+    {
+        // Prefer the precompiled manifest written by the resource compiler
+        BundleResourceContainer::Stat binaryStat;
+        binaryStat.filePath = symbolicName + "/" + binarymanifest::ENTRY_NAME;
+        if (container.GetStat(binaryStat) && !binaryStat.isDir)
+        {
+            auto data = container.GetData(binaryStat.index);
+            if (data
+                && ParseBinary(std::string_view(static_cast<char const*>(data.get()), binaryStat.uncompressedSize)))
+            {
+                return true;
+            }
+        }
+
+        BundleResourceContainer::Stat stat;
+        stat.filePath = symbolicName + "/manifest.json";
+        if (!container.GetStat(stat) || stat.isDir)
+        {
+            return false;
+        }
+        auto data = container.GetData(stat.index);
+        if (!data)
+        {
+            throw std::runtime_error("Could not read " + stat.filePath);
+        }
+        std::istringstream manifestStream(std::string(static_cast<char const*>(data.get()), stat.uncompressedSize));
+        Parse(manifestStream);
+        return true;
+    }
+
+    bool
+    BundleManifest::ParseBinary(std::string_view data)
+    {
+        binarymanifest::Reader reader(data);
+        Any root;
+        if (!reader.ReadHeader() || !ParseBinaryValue(reader, 0, root) || reader.Remaining() != 0
+            || root.Type() != typeid(AnyMap))
+        {
+            return false;
+        }
+
+        // like Parse(), add to the existing headers
+        for (auto& header : ref_any_cast<AnyMap>(root))
+        {
+            m_Headers.emplace(header.first, std::move(header.second));
+        }
+        return true;
+    }
+
+    bool
+    BundleManifest::EncodeBinaryHeaders(AnyMap const& headers, binarymanifest::Writer& writer)
+    {
+        return WriteBinaryMap(headers, 0, writer);
+    }
+
+    bool
+    BundleManifest::DecodeBinaryHeaders(binarymanifest::Reader& reader, AnyMap& headers)
+    {
+        Any root;
+        if (!ParseBinaryValue(reader, 0, root) || root.Type() != typeid(AnyMap))
+        {
+            return false;
+        }
+        headers = std::move(ref_any_cast<AnyMap>(root));
+        return true;
+    }
+
     AnyMap const&
     BundleManifest::GetHeaders() const
     {
@@ -26,10 +26,19 @@
 #include "cppmicroservices/Any.h"
 #include "cppmicroservices/AnyMap.h"
 #include <mutex>
+#include <string_view>
 
 namespace cppmicroservices
 {
 
+    namespace binarymanifest
+    {
+        class Reader;
+        class Writer;
+    } // namespace binarymanifest
+
+    class BundleResourceContainer;
+
     class BundleManifest
     {
 
@@ -39,6 +48,45 @@ namespace cppmicroservices
 
         void Parse(std::istream& is);
 
+        /**
+         * Loads the headers of a bundle from its resource container, from the
+         * manifest.bin written by the resource compiler if the bundle has a
+         * valid one, and from its manifest.json otherwise.
+         *
+         * @param container The resource container of the bundle.
+         * @param symbolicName The symbolic name of the bundle, which prefixes
+         *        its entries in the container.
+         * @return false if the bundle has no manifest.
+         * @throws std::runtime_error if manifest.json cannot be parsed.
+         */
+        bool Load(BundleResourceContainer& container, std::string const& symbolicName);
+
+        /**
+         * Loads the headers from a manifest encoded by the resource compiler
+         * (see cppmicroservices/util/BinaryManifest.h), yielding the same
+         * headers as Parse() for the corresponding manifest.json.
+         *
+         * @return false, leaving the headers unchanged, if the data is not a
+         *         valid encoded manifest of a supported version.
+         */
+        bool ParseBinary(std::string_view data);
+
+        /**
+         * Appends headers to writer in the value encoding of manifest.bin, so
+         * that DecodeBinaryHeaders() reads back equal headers of the same types.
+         *
+         * @return false if one of the header values is empty or of a type which
+         *         cannot be encoded. The writer then holds a partial encoding.
+         */
+        static bool EncodeBinaryHeaders(AnyMap const& headers, binarymanifest::Writer& writer);
+
+        /**
+         * Reads headers written by EncodeBinaryHeaders().
+         *
+         * @return false if the data is truncated or malformed.
+         */
+        static bool DecodeBinaryHeaders(binarymanifest::Reader& reader, AnyMap& headers);
+
         AnyMap const& GetHeaders() const;
 
         bool Contains(std::string const& key) const;
@@ -29,7 +29,6 @@
 #include "cppmicroservices/BundleContext.h"
 #include "cppmicroservices/BundleEvent.h"
 #include "cppmicroservices/BundleResource.h"
-#include "cppmicroservices/BundleResourceStream.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
@@ -46,6 +45,7 @@
 #include "BundleResourceContainer.h"
 #include "BundleUtils.h"
 #include "CoreBundleContext.h"
+#include "FrameworkPrivate.h"
 #include "ServiceReferenceBasePrivate.h"
 
 #include <algorithm>
@@ -441,10 +441,89 @@ namespace cppmicroservices
             SetAutostartSetting(options);
         }
 
+        auto const activeStartLevel = coreCtx->systemBundle->GetActiveStartLevel();
+        if (startLevel > activeStartLevel)
+        {
+            if ((options & Bundle::START_TRANSIENT) != 0)
+            {
+                throw std::runtime_error("Bundle " + symbolicName + " (location=" + location + ") has start level "
+                                         + std::to_string(startLevel) + ", above the active start level "
+                                         + std::to_string(activeStartLevel) + " of the framework");
+            }
+            // Activated by the framework when its active start level reaches startLevel.
+            return;
+        }
+
+        if ((options & Bundle::START_ACTIVATION_POLICY) != 0 && HasLazyActivationPolicy())
+        {
+            if (GetUpdatedState() == Bundle::STATE_RESOLVED)
+            {
+                // Wait in STATE_STARTING, without loading the bundle's library, until
+                // TriggerLazyActivation() is called.
+                state = Bundle::STATE_STARTING;
+                std::shared_ptr<BundleContextPrivate> null_expected;
+                std::shared_ptr<BundleContextPrivate> ctx(new BundleContextPrivate(this));
+                bundleContext.CompareExchange(null_expected, ctx);
+                coreCtx->listeners.BundleChanged(
+                    BundleEvent(BundleEvent::BUNDLE_LAZY_ACTIVATION, MakeBundle(this->shared_from_this())));
+                return;
+            }
+            if (state == Bundle::STATE_STARTING)
+            {
+                return;
+            }
+        }
+
         FinalizeActivation();
         return;
     }
 
+    void
+    BundlePrivate::TriggerLazyActivation()
+    {
+        // A lazily started bundle waits in STATE_STARTING with no operation in
+        // progress. If the bundle is being activated, possibly by this thread,
+        // there is nothing to do.
+        if (state != Bundle::STATE_STARTING || operation != OP_IDLE)
+        {
+            return;
+        }
+
+        try
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            // Like Start(), do not load and activate the bundle while the
+            // framework is shutting down.
+            auto frameworkBlock = coreCtx->GetFrameworkStateAndBlock();
+            if (frameworkBlock->frameworkHasStopped)
+            {
+                throw std::runtime_error("Bundle " + symbolicName + " (location=" + location
+                                         + ") belongs to a stopped framework");
+            }
+            if (state != Bundle::STATE_STARTING || operation != OP_IDLE)
+            {
+                return;
+            }
+            FinalizeActivation();
+        }
+        catch (...)
+        {
+            coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                                 MakeBundle(this->shared_from_this()),
+                                                                 "Lazy activation of bundle " + symbolicName
+                                                                     + " (location=" + location + ") failed",
+                                                                 std::current_exception()));
+        }
+    }
+
+    bool
+    BundlePrivate::HasLazyActivationPolicy() const
+    {
+        auto policy = bundleManifest.GetValue(Constants::BUNDLE_ACTIVATIONPOLICY);
+        return policy.Type() == typeid(std::string) && ref_any_cast<std::string>(policy) == Constants::ACTIVATION_LAZY;
+    }
+
     AnyMap const&
     BundlePrivate::GetHeaders() const
     {
@@ -692,6 +771,7 @@ namespace cppmicroservices
         , aborted(static_cast<uint8_t>(Aborted::NONE))
         , symbolicName(Constants::SYSTEM_BUNDLE_SYMBOLICNAME)
         , version(CppMicroServices_VERSION_MAJOR, CppMicroServices_VERSION_MINOR, CppMicroServices_VERSION_PATCH)
+        , startLevel(0)
         , timeStamp(std::chrono::steady_clock::now())
         , bundleManifest()
         , lib()
@@ -715,6 +795,7 @@ namespace cppmicroservices
         , aborted(static_cast<uint8_t>(Aborted::NONE))
         , symbolicName(ba->GetResourcePrefix())
         , version()
+        , startLevel(1)
         , timeStamp(ba->GetLastModified())
         , bundleManifest(ba->GetInjectedManifest())
         , lib(location)
@@ -727,20 +808,20 @@ namespace cppmicroservices
             // Check if the bundle provides a manifest.json file and if yes, parse it.
             if (ba->IsValid())
             {
-                auto manifestRes = ba->GetResource("/manifest.json");
-                if (manifestRes)
+                bool hasManifest = false;
+                try
                 {
-                    BundleResourceStream manifestStream(manifestRes);
-                    try
-                    {
-                        bundleManifest.Parse(manifestStream);
-                    }
-                    catch (...)
-                    {
-                        throw std::runtime_error(std::string("Parsing of manifest.json for bundle ")
-                                                 + ba->GetResourcePrefix() + " at " + location
-                                                 + " failed: " + util::GetLastExceptionStr());
-                    }
+                    hasManifest = bundleManifest.Load(*ba->GetResourceContainer(), ba->GetResourcePrefix());
+                }
+                catch (...)
+                {
+                    throw std::runtime_error(std::string("Parsing of manifest.json for bundle ")
+                                             + ba->GetResourcePrefix() + " at " + location
+                                             + " failed: " + util::GetLastExceptionStr());
+                }
+                if (hasManifest)
+                {
+                    ba->CacheManifest(bundleManifest.GetHeaders());
                     // It is unlikely that clients will access bundle resources
                     // if the only resource is the manifest file. On this assumption,
                     // close the open file handle to the zip file to improve performance
@@ -779,6 +860,18 @@ namespace cppmicroservices
             }
         }
 
+        if (bundleManifest.Contains(Constants::BUNDLE_STARTLEVEL))
+        {
+            Any startLevelAny = bundleManifest.GetValue(Constants::BUNDLE_STARTLEVEL);
+            if (startLevelAny.Type() != typeid(int) || any_cast<int>(startLevelAny) < 1)
+            {
+                throw std::invalid_argument(std::string("The Json value for ") + Constants::BUNDLE_STARTLEVEL
+                                            + " for bundle " + symbolicName + " (location=" + location
+                                            + ") is not valid: the start level must be a positive integer");
+            }
+            startLevel = static_cast<uint32_t>(any_cast<int>(startLevelAny));
+        }
+
         if (!bundleManifest.Contains(Constants::BUNDLE_SYMBOLICNAME))
         {
             throw std::invalid_argument(Constants::BUNDLE_SYMBOLICNAME
@@ -145,6 +145,18 @@ namespace cppmicroservices
         // Performs the actual activation.
         void FinalizeActivation();
 
+        /**
+         * Activate this bundle if it was started according to a lazy activation
+         * policy and is still waiting in STATE_STARTING. Activation failures are
+         * reported as FRAMEWORK_ERROR events.
+         */
+        void TriggerLazyActivation();
+
+        /**
+         * Returns true if the bundle.activation_policy manifest header is "lazy".
+         */
+        bool HasLazyActivationPolicy() const;
+
         virtual void Uninstall();
 
         virtual std::string GetLocation() const;
@@ -252,6 +264,12 @@ namespace cppmicroservices
         // Does not need to be locked by "this" when accessed.
         BundleVersion version;
 
+        /**
+         * Bundle start level, read from the bundle.start_level manifest header.
+         */
+        // Does not need to be locked by "this" when accessed.
+        uint32_t startLevel;
+
         /**
          * Time when bundle was last modified.
          *
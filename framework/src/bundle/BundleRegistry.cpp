@@ -32,16 +32,24 @@
 #include "cppmicroservices/util/String.h"
 
 #include "BundleContextPrivate.h"
+#include "BundleManifest.h"
 #include "BundlePrivate.h"
 #include "BundleResourceContainer.h"
 #include "BundleStorage.h"
 #include "CoreBundleContext.h"
 #include "FrameworkPrivate.h"
+#include "Utils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <deque>
 #include <functional>
+#include <future>
 #include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 
 namespace
 {
@@ -62,9 +70,71 @@ namespace
 namespace cppmicroservices
 {
 
+    namespace
+    {
+
+        /*
+          Opens the bundle library at location and reads the manifest.json file of
+          each bundle in it. The result maps the symbolic name of each bundle to its
+          manifest and can be used as the injected manifest of BundleRegistry::Install,
+          together with the opened resource container.
+
+          Errors are not reported here: an empty manifest is returned for the bundle,
+          or for the whole library, so that the install reads the bundle library
+          again and reports the error as usual.
+        */
+        AnyMap
+        ReadBundleManifests(std::string const& location, std::shared_ptr<BundleResourceContainer>& resCont)
+        {
+            AnyMap manifests(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            try
+            {
+                resCont = std::make_shared<BundleResourceContainer>(
+                    location,
+                    AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                for (auto const& symbolicName : resCont->GetTopLevelDirs())
+                {
+                    try
+                    {
+                        BundleManifest bundleManifest;
+                        if (bundleManifest.Load(*resCont, symbolicName))
+                        {
+                            manifests.emplace(symbolicName, bundleManifest.GetHeaders());
+                            continue;
+                        }
+                    }
+                    catch (...)
+                    {
+                        // reported when the bundle is installed
+                    }
+                    manifests.emplace(symbolicName, AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                }
+
+                // Like a bundle reading its own manifest, do not keep the file
+                // open if nothing else is in it.
+                if (OnlyContainsManifest(resCont))
+                {
+                    resCont->CloseContainer();
+                }
+            }
+            catch (...)
+            {
+                resCont.reset();
+                return AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            }
+            return manifests;
+        }
+
+
+        // The least number of bundle libraries a batch install reads concurrently.
+        // Handing fewer libraries to other threads costs more than it saves.
+        constexpr std::size_t MinConcurrentManifestReads = 8;
+
+    } // namespace
+
     BundleRegistry::BundleRegistry(CoreBundleContext* coreCtx) : coreCtx(coreCtx) {}
 
-    BundleRegistry::~BundleRegistry() = default;
+    BundleRegistry::~BundleRegistry() { StopManifestReaders(); }
 
     void
     BundleRegistry::Init()
@@ -75,11 +145,81 @@ namespace cppmicroservices
     void
     BundleRegistry::Clear()
     {
+        StopManifestReaders();
         auto l = bundles.Lock();
         US_UNUSED(l);
         bundles.v.clear();
     }
 
+    void
+    BundleRegistry::RunOnManifestReaders(std::vector<std::packaged_task<void()>>& tasks)
+    {
+        std::vector<std::future<void>> results;
+        {
+            auto l = manifestReaders.Lock();
+            US_UNUSED(l);
+            // The first task runs on the calling thread
+            while (manifestReaders.threads.size() + 1 < tasks.size())
+            {
+                manifestReaders.threads.emplace_back(
+                    [this]
+                    {
+                        auto readerLock = manifestReaders.Lock();
+                        for (;;)
+                        {
+                            manifestReaders.Wait(readerLock,
+                                                 [this]
+                                                 { return manifestReaders.stopped || !manifestReaders.tasks.empty(); });
+                            if (manifestReaders.tasks.empty())
+                            {
+                                return;
+                            }
+                            auto task = std::move(manifestReaders.tasks.front());
+                            manifestReaders.tasks.pop_front();
+                            readerLock.UnLock();
+                            task();
+                            readerLock.Lock();
+                        }
+                    });
+            }
+            for (std::size_t i = 1; i < tasks.size(); ++i)
+            {
+                results.push_back(tasks[i].get_future());
+                manifestReaders.tasks.push_back(std::move(tasks[i]));
+            }
+            manifestReaders.NotifyAll();
+        }
+        if (!tasks.empty())
+        {
+            tasks.front()();
+            results.push_back(tasks.front().get_future());
+        }
+        for (auto& result : results)
+        {
+            result.get();
+        }
+    }
+
+    void
+    BundleRegistry::StopManifestReaders()
+    {
+        std::vector<std::thread> threads;
+        {
+            auto l = manifestReaders.Lock();
+            US_UNUSED(l);
+            manifestReaders.stopped = true;
+            threads.swap(manifestReaders.threads);
+            manifestReaders.NotifyAll();
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        auto l = manifestReaders.Lock();
+        US_UNUSED(l);
+        manifestReaders.stopped = false;
+    }
+
     /*
       This function acquires a lock and decrements the reference count
       for the specified bundle. If this decrement causes the count to be
@@ -153,7 +293,8 @@ namespace cppmicroservices
     std::vector<Bundle>
     BundleRegistry::Install(std::string const& location,
                             BundlePrivate* installingBundle,
-                            cppmicroservices::AnyMap const& bundleManifest)
+                            cppmicroservices::AnyMap const& bundleManifest,
+                            std::shared_ptr<BundleResourceContainer> const& openedResCont)
     {
         using namespace std::chrono_literals;
 
@@ -257,7 +398,8 @@ namespace cppmicroservices
                         });
 
                     // Perform the install
-                    auto resCont = std::make_shared<BundleResourceContainer>(location, bundleManifest);
+                    auto resCont = openedResCont ? openedResCont
+                                                 : std::make_shared<BundleResourceContainer>(location, bundleManifest);
                     installedBundles = Install0(location, resCont, {}, bundleManifest);
                 }
                 return installedBundles;
@@ -309,6 +451,73 @@ namespace cppmicroservices
         }
     }
 
+    std::vector<Bundle>
+    BundleRegistry::Install(std::vector<std::string> const& locations, BundlePrivate* installingBundle)
+    {
+        CheckIllegalState();
+
+        // Find the locations which are not installed yet. Only the first occurrence
+        // of a location gets its manifests, the others find it installed.
+        std::vector<std::size_t> toRead;
+        {
+            std::unordered_set<std::string> seen;
+            auto l = bundles.Lock();
+            US_UNUSED(l);
+            for (std::size_t i = 0; i < locations.size(); ++i)
+            {
+                if (seen.insert(locations[i]).second && bundles.v.count(locations[i]) == 0)
+                {
+                    toRead.push_back(i);
+                }
+            }
+        }
+
+        // Opening a bundle library and reading its manifests is dominated by file I/O
+        // and does not touch the registry, so it is done concurrently if there are
+        // enough libraries to read and more than one core to read them with.
+#ifdef US_ENABLE_THREADING_SUPPORT
+        std::size_t const numReaders = std::min<std::size_t>(std::thread::hardware_concurrency(), toRead.size());
+#else
+        std::size_t const numReaders = 1;
+#endif
+        std::vector<Bundle> installedBundles;
+        if (toRead.size() < MinConcurrentManifestReads || numReaders < 2)
+        {
+            for (auto const& location : locations)
+            {
+                auto b = Install(location, installingBundle);
+                installedBundles.insert(installedBundles.end(), b.begin(), b.end());
+            }
+            return installedBundles;
+        }
+
+        std::vector<AnyMap> manifests(locations.size(), AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+        std::vector<std::shared_ptr<BundleResourceContainer>> resConts(locations.size());
+        std::atomic<std::size_t> next { 0 };
+        std::vector<std::packaged_task<void()>> tasks;
+        for (std::size_t i = 0; i < numReaders; ++i)
+        {
+            tasks.emplace_back(
+                [&locations, &manifests, &resConts, &toRead, &next]
+                {
+                    for (auto j = next++; j < toRead.size(); j = next++)
+                    {
+                        manifests[toRead[j]] = ReadBundleManifests(locations[toRead[j]], resConts[toRead[j]]);
+                    }
+                });
+        }
+        RunOnManifestReaders(tasks);
+
+        // Install in the given order, so that the bundle ids and the
+        // BUNDLE_INSTALLED events do not depend on the thread scheduling.
+        for (std::size_t i = 0; i < locations.size(); ++i)
+        {
+            auto b = Install(locations[i], installingBundle, manifests[i], resConts[i]);
+            installedBundles.insert(installedBundles.end(), b.begin(), b.end());
+        }
+        return installedBundles;
+    }
+
     std::vector<Bundle>
     BundleRegistry::Install0(std::string const& location,
                              std::shared_ptr<BundleResourceContainer> const& resCont,
@@ -323,6 +532,7 @@ namespace cppmicroservices
         std::vector<Bundle> installedBundles;
         std::vector<std::shared_ptr<BundleArchive>> barchives;
         std::unordered_set<std::string> exclude { alreadyInstalled.begin(), alreadyInstalled.end() };
+        AnyMap const emptyManifest(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
         try
         {
             // Create a BundleArchive for each entry in the resource container... that is, top level entries
@@ -346,10 +556,10 @@ namespace cppmicroservices
 #endif
 
                     // Either use the manifest found in the passed in bundleManifest list for the current entry,
-                    // or construct an empty one
-                    auto manifest = (0 != bundleManifest.count(symbolicName)
-                                         ? any_cast<AnyMap>(bundleManifest.at(symbolicName))
-                                         : AnyMap(any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                    // or an empty one
+                    auto const& manifest = (0 != bundleManifest.count(symbolicName)
+                                                ? cppms::ref_any_cast<AnyMap>(bundleManifest.at(symbolicName))
+                                                : emptyManifest);
 
                     // Now, create a BundleArchive with the given manifest at 'entry' in the
                     // BundleResourceContainer, and remember the created BundleArchive here for later
@@ -519,6 +729,7 @@ namespace cppmicroservices
             catch (...)
             {
                 ba->SetAutostartSetting(-1); // Do not start on launch
+                ba->Purge();
                 std::cerr << "Failed to load bundle " << util::ToString(ba->GetBundleId())
                           << " (" + ba->GetBundleLocation() + ") uninstalled it!"
                           << " (exception: " << util::GetExceptionStr(std::current_exception()) << ")" << std::endl;
@@ -25,11 +25,15 @@
 
 #include "cppmicroservices/AnyMap.h"
 #include "cppmicroservices/detail/Threads.h"
+#include "cppmicroservices/detail/WaitCondition.h"
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "BundleResourceContainer.h"
@@ -64,12 +68,26 @@ namespace cppmicroservices
          *
          * @param location The location to be installed
          * @param caller The bundle performing the install
+         * @param bundleManifest The manifests of the bundles at location, if already known
+         * @param resCont A resource container already created for location, or null
          * @return A vector of bundles installed
          */
         std::vector<Bundle> Install(std::string const& location,
                                     BundlePrivate* caller,
                                     cppmicroservices::AnyMap const& bundleManifest = cppmicroservices::AnyMap(
-                                        cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                                        cppmicroservices::any_map::UNORDERED_MAP_CASEINSENSITIVE_KEYS),
+                                    std::shared_ptr<BundleResourceContainer> const& resCont = nullptr);
+
+        /**
+         * Install several bundle libraries. If there are enough libraries which
+         * are not installed yet, their manifests are read concurrently by the
+         * manifest reader threads. The libraries are installed in the given order.
+         *
+         * @param locations The locations to be installed
+         * @param caller The bundle performing the install
+         * @return A vector of bundles installed
+         */
+        std::vector<Bundle> Install(std::vector<std::string> const& locations, BundlePrivate* caller);
 
         /**
          * Remove bundle registration.
@@ -143,6 +161,18 @@ namespace cppmicroservices
 
         void CheckIllegalState() const;
 
+        /**
+         * Runs the given tasks on the manifest reader threads and on the
+         * calling thread, starting the reader threads if needed, and waits
+         * until all of them finished.
+         */
+        void RunOnManifestReaders(std::vector<std::packaged_task<void()>>& tasks);
+
+        /**
+         * Stops the manifest reader threads and waits until they finished.
+         */
+        void StopManifestReaders();
+
         /** This function populates the res and alreadyInstalled vectors with the appropriate entries so
          * that they can be used by the Install0 call. This was extracted from Install() for convenience.
          *
@@ -195,6 +225,18 @@ namespace cppmicroservices
         {
             BundleMap v;
         } bundles;
+
+        /**
+         * Threads reading the manifests of the bundle libraries installed in
+         * a batch. They are started by the first batch large enough, and kept
+         * until the registry is cleared.
+         */
+        struct : detail::MultiThreaded<detail::MutexLockingStrategy<>, detail::WaitCondition>
+        {
+            std::vector<std::thread> threads;
+            std::deque<std::packaged_task<void()>> tasks;
+            bool stopped = false;
+        } manifestReaders;
     };
 } // namespace cppmicroservices
 
@@ -29,6 +29,7 @@
 #include "BundleResourceContainer.h"
 
 #include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -52,6 +53,9 @@ namespace cppmicroservices
 
         mutable std::vector<std::string> children;
         mutable std::vector<uint32_t> childNodes;
+
+        mutable std::once_flag mappedDataFlag;
+        mutable std::shared_ptr<void const> mappedData;
     };
 
     void
@@ -291,6 +295,34 @@ namespace cppmicroservices
         return d->archive->GetResourceContainer()->GetData(d->stat.index);
     }
 
+    std::string_view
+    BundleResource::GetMappedData() const
+    {
+        if (!IsValid() || IsDir())
+        {
+            return {};
+        }
+
+        std::call_once(d->mappedDataFlag,
+                       [this] { d->mappedData = d->archive->GetResourceContainer()->GetMappedData(d->stat.index); });
+
+        if (!d->mappedData)
+        {
+            return {};
+        }
+        return { static_cast<char const*>(d->mappedData.get()), static_cast<std::size_t>(d->stat.uncompressedSize) };
+    }
+
+    std::shared_ptr<void const>
+    BundleResource::GetSharedData() const
+    {
+        if (!GetMappedData().empty())
+        {
+            return d->mappedData;
+        }
+        return GetData();
+    }
+
     std::ostream&
     operator<<(std::ostream& os, BundleResource const& resource)
     {
@@ -45,7 +45,7 @@ namespace cppmicroservices
         class BundleResourceBufferPrivate
         {
           public:
-            BundleResourceBufferPrivate(std::unique_ptr<void, void (*)(void*)> data,
+            BundleResourceBufferPrivate(std::shared_ptr<void const> data,
                                         std::size_t size,
                                         char const* begin,
                                         std::ios_base::openmode mode)
@@ -53,7 +53,7 @@ namespace cppmicroservices
                 , end(begin + size)
                 , current(begin)
                 , mode(mode)
-                , uncompressedData(reinterpret_cast<unsigned char*>(data.release()), data.get_deleter())
+                , data(std::move(data))
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
                 , pos(0)
 #endif
@@ -66,7 +66,8 @@ namespace cppmicroservices
 
             const std::ios_base::openmode mode;
 
-            std::unique_ptr<unsigned char, void (*)(void*)> uncompressedData;
+            // either the uncompressed heap data or a view into the mapped bundle
+            std::shared_ptr<void const> data;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
             // records the stream position ignoring CR characters
@@ -75,13 +76,20 @@ namespace cppmicroservices
         };
 
         BundleResourceBuffer::BundleResourceBuffer(std::unique_ptr<void, void (*)(void*)> data,
+                                                   std::size_t size,
+                                                   std::ios_base::openmode mode)
+            : BundleResourceBuffer(std::shared_ptr<void const>(std::move(data)), size, mode)
+        {
+        }
+
+        BundleResourceBuffer::BundleResourceBuffer(std::shared_ptr<void const> data,
                                                    std::size_t _size,
                                                    std::ios_base::openmode mode)
             : d(nullptr)
         {
             assert(_size < static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()));
 
-            auto* begin = reinterpret_cast<char*>(data.get());
+            auto const* begin = static_cast<char const*>(data.get());
             std::size_t size = begin ? _size : 0;
 
 #ifdef DATA_NEEDS_NEWLINE_CONVERSION
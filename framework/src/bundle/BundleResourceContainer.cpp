@@ -29,21 +29,59 @@
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/detail/Log.h"
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <cstring>
 #include <exception>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 
+#ifdef US_PLATFORM_POSIX
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 namespace cppmicroservices
 {
 
+#ifdef US_PLATFORM_POSIX
+    namespace
+    {
+        // miniz read callback which reads from the file descriptor passed as
+        // opaque data without touching the file position.
+        size_t
+        PositionalRead(void* opaque, mz_uint64 fileOffset, void* buffer, size_t n)
+        {
+            int const fd = *static_cast<int const*>(opaque);
+            auto* out = static_cast<char*>(buffer);
+            size_t total = 0;
+            while (total < n)
+            {
+                ssize_t const bytesRead = ::pread(fd, out + total, n - total, static_cast<off_t>(fileOffset + total));
+                if (bytesRead < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (bytesRead <= 0)
+                {
+                    break;
+                }
+                total += static_cast<size_t>(bytesRead);
+            }
+            return total;
+        }
+    } // namespace
+#endif
+
     BundleResourceContainer::BundleResourceContainer(std::string const& location, ManifestT const& bundleManifest)
         : m_Location(location)
         , m_ZipArchive()
         , m_ObjFile()
+        , m_SerializeReads(false)
+        , m_FileDescriptor(-1)
         , m_ZipFileMutex()
         , m_IsContainerOpen(false)
     {
@@ -100,6 +138,13 @@ namespace cppmicroservices
     BundleResourceContainer::GetStat(BundleResourceContainer::Stat& stat)
     {
         OpenAndInitializeContainer();
+        if (auto const* node = FindIndexNode(stat.filePath))
+        {
+            stat = node->stat;
+            return true;
+        }
+
+        // miniz matches names case-insensitively
         int fileIndex
             = mz_zip_reader_locate_file(const_cast<mz_zip_archive*>(&m_ZipArchive), stat.filePath.c_str(), nullptr, 0);
         if (fileIndex >= 0)
@@ -113,6 +158,18 @@ namespace cppmicroservices
     BundleResourceContainer::GetStat(int index, BundleResourceContainer::Stat& stat)
     {
         OpenAndInitializeContainer();
+        if (index >= 0 && static_cast<std::size_t>(index) < m_IndexByZipIndex.size()
+            && m_IndexByZipIndex[index] != UINT32_MAX)
+        {
+            stat = m_Index[m_IndexByZipIndex[index]].stat;
+            return true;
+        }
+        return ReadStat(index, stat);
+    }
+
+    bool
+    BundleResourceContainer::ReadStat(int index, BundleResourceContainer::Stat& stat) const
+    {
         if (index >= 0)
         {
             mz_zip_archive_file_stat zipStat;
@@ -142,45 +199,98 @@ namespace cppmicroservices
     BundleResourceContainer::GetData(int index)
     {
         OpenAndInitializeContainer();
-        std::unique_lock<std::mutex> l(m_ZipFileStreamMutex);
+        std::unique_lock<std::mutex> l(m_ZipFileStreamMutex, std::defer_lock);
+        if (m_SerializeReads)
+        {
+            l.lock();
+        }
         void* data = mz_zip_reader_extract_to_heap(const_cast<mz_zip_archive*>(&m_ZipArchive), index, nullptr, 0);
         return { data, ::free };
     }
 
+    std::shared_ptr<void const>
+    BundleResourceContainer::GetMappedData(int index)
+    {
+        // Size and field offsets of a zip local file header
+        constexpr std::size_t localHeaderSize = 30;
+        constexpr std::size_t localHeaderNameLenOffset = 26;
+        constexpr std::size_t localHeaderExtraLenOffset = 28;
+        constexpr uint32_t localHeaderSignature = 0x04034b50;
+
+        OpenAndInitializeContainer();
+
+        std::shared_ptr<RawBundleResources> rawData;
+        {
+            std::lock_guard<std::mutex> lock(m_ZipFileMutex);
+            rawData = m_RawData;
+        }
+        if (!rawData || index < 0)
+        {
+            return nullptr;
+        }
+
+        mz_zip_archive_file_stat zipStat;
+        if (!mz_zip_reader_file_stat(&m_ZipArchive, static_cast<mz_uint>(index), &zipStat) || zipStat.m_is_directory
+            || zipStat.m_is_encrypted || zipStat.m_method != 0 || zipStat.m_comp_size != zipStat.m_uncomp_size)
+        {
+            return nullptr;
+        }
+
+        auto const* base = static_cast<unsigned char const*>(rawData->GetData());
+        std::size_t const size = rawData->GetSize();
+        if (zipStat.m_local_header_ofs + localHeaderSize > size)
+        {
+            return nullptr;
+        }
+
+        unsigned char const* localHeader = base + zipStat.m_local_header_ofs;
+        auto readLE16 = [localHeader](std::size_t offset)
+        { return static_cast<std::size_t>(localHeader[offset] | (localHeader[offset + 1] << 8)); };
+        uint32_t const signature = static_cast<uint32_t>(localHeader[0]) | (static_cast<uint32_t>(localHeader[1]) << 8)
+                                   | (static_cast<uint32_t>(localHeader[2]) << 16)
+                                   | (static_cast<uint32_t>(localHeader[3]) << 24);
+        if (signature != localHeaderSignature)
+        {
+            return nullptr;
+        }
+
+        uint64_t const dataOffset = zipStat.m_local_header_ofs + localHeaderSize + readLE16(localHeaderNameLenOffset)
+                                    + readLE16(localHeaderExtraLenOffset);
+        if (dataOffset + zipStat.m_comp_size > size)
+        {
+            return nullptr;
+        }
+
+        // share ownership of the mapping with the returned pointer
+        return { rawData, base + dataOffset };
+    }
+
     void
     BundleResourceContainer::GetChildren(std::string const& resourcePath,
                                          bool relativePaths,
                                          std::vector<std::string>& names,
                                          std::vector<uint32_t>& indices) const
     {
-        auto iter = m_SortedEntries.find(std::make_pair(resourcePath, 0));
-        if (iter == m_SortedEntries.end())
+        auto const* dir = FindIndexNode(resourcePath);
+        if (dir == nullptr)
         {
             return;
         }
 
-        for (++iter; iter != m_SortedEntries.end(); ++iter)
+        names.reserve(names.size() + dir->childCount);
+        indices.reserve(indices.size() + dir->childCount);
+        for (uint32_t i = dir->firstChild, end = dir->firstChild + dir->childCount; i < end; ++i)
         {
-            if (resourcePath.size() > iter->first.size())
+            auto const& child = m_Index[m_IndexChildren[i]];
+            if (relativePaths)
             {
-                break;
+                names.push_back(child.stat.filePath.substr(child.nameOffset));
             }
-            if (iter->first.compare(0, resourcePath.size(), resourcePath) == 0)
+            else
             {
-                std::size_t pos = iter->first.find_first_of('/', resourcePath.size());
-                if (pos == std::string::npos || pos == iter->first.size() - 1)
-                {
-                    if (relativePaths)
-                    {
-                        names.push_back(iter->first.substr(resourcePath.size()));
-                    }
-                    else
-                    {
-                        names.push_back(iter->first);
-                    }
-                    indices.push_back(iter->second);
-                }
+                names.push_back(child.stat.filePath);
             }
+            indices.push_back(child.stat.index);
         }
     }
 
@@ -191,22 +301,34 @@ namespace cppmicroservices
                                        bool recurse,
                                        std::vector<BundleResource>& resources) const
     {
-        std::vector<std::string> names;
-        std::vector<uint32_t> indices;
-
         OpenAndInitializeContainer();
 
-        this->GetChildren(path, true, names, indices);
+        if (auto const* dir = FindIndexNode(path))
+        {
+            this->FindNodes(archive, *dir, filePattern, recurse, resources);
+        }
+    }
 
-        for (std::size_t i = 0, s = names.size(); i < s; ++i)
+    void
+    BundleResourceContainer::FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                                       IndexNode const& dir,
+                                       std::string_view filePattern,
+                                       bool recurse,
+                                       std::vector<BundleResource>& resources) const
+    {
+        for (uint32_t i = dir.firstChild, end = dir.firstChild + dir.childCount; i < end; ++i)
         {
-            if (*names[i].rbegin() == '/' && recurse)
+            auto const& child = m_Index[m_IndexChildren[i]];
+            std::string_view name(child.stat.filePath);
+            name.remove_prefix(child.nameOffset);
+
+            if (recurse && name.back() == '/')
             {
-                this->FindNodes(archive, path + names[i], filePattern, recurse, resources);
+                this->FindNodes(archive, child, filePattern, recurse, resources);
             }
-            if (this->Matches(names[i], filePattern))
+            if (this->Matches(name, filePattern))
             {
-                resources.push_back(BundleResource(indices[i], archive));
+                resources.push_back(BundleResource(child.stat.index, archive));
             }
         }
     }
@@ -227,41 +349,164 @@ namespace cppmicroservices
         {
         }
 
-        if (!rawBundleResourceData || !rawBundleResourceData->GetData()
-            || !mz_zip_reader_init_mem(&m_ZipArchive,
-                                       rawBundleResourceData->GetData(),
-                                       rawBundleResourceData->GetSize(),
-                                       0))
+        if (rawBundleResourceData && rawBundleResourceData->GetData()
+            && mz_zip_reader_init_mem(&m_ZipArchive,
+                                      rawBundleResourceData->GetData(),
+                                      rawBundleResourceData->GetSize(),
+                                      0))
+        {
+            m_RawData = std::move(rawBundleResourceData);
+        }
+        else if (!InitMinizWithPositionalReader())
         {
             if (!mz_zip_reader_init_file(&m_ZipArchive, m_Location.c_str(), 0))
             {
                 throw std::runtime_error("Could not init zip archive for bundle at " + m_Location);
             }
+            m_SerializeReads = true;
         }
     }
 
+    bool
+    BundleResourceContainer::InitMinizWithPositionalReader() const
+    {
+#ifdef US_PLATFORM_POSIX
+        int const fd = ::open(m_Location.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStat;
+        if (::fstat(fd, &fileStat) == 0)
+        {
+            m_FileDescriptor = fd;
+            m_ZipArchive.m_pRead = &PositionalRead;
+            m_ZipArchive.m_pIO_opaque = &m_FileDescriptor;
+            if (mz_zip_reader_init(&m_ZipArchive, static_cast<mz_uint64>(fileStat.st_size), 0))
+            {
+                return true;
+            }
+        }
+
+        m_ZipArchive.m_pRead = nullptr;
+        m_ZipArchive.m_pIO_opaque = nullptr;
+        m_FileDescriptor = -1;
+        ::close(fd);
+#endif
+        return false;
+    }
+
     void
-    BundleResourceContainer::InitSortedEntries() const
+    BundleResourceContainer::CloseFileDescriptor() const
     {
-        mz_uint numFiles = mz_zip_reader_get_num_files(const_cast<mz_zip_archive*>(&m_ZipArchive));
+#ifdef US_PLATFORM_POSIX
+        if (m_FileDescriptor >= 0)
+        {
+            ::close(m_FileDescriptor);
+            m_FileDescriptor = -1;
+        }
+#endif
+        m_SerializeReads = false;
+    }
+
+    void
+    BundleResourceContainer::InitIndex() const
+    {
+        if (!m_Index.empty())
+        {
+            return;
+        }
+
+        mz_uint numFiles = mz_zip_reader_get_num_files(&m_ZipArchive);
+        std::vector<IndexNode> nodes;
+        nodes.reserve(numFiles);
         for (mz_uint fileIndex = 0; fileIndex < numFiles; ++fileIndex)
         {
-            char fileName[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
-            if (mz_zip_reader_get_filename(&m_ZipArchive, fileIndex, fileName, MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE))
+            IndexNode node {};
+            if (ReadStat(static_cast<int>(fileIndex), node.stat))
             {
-                std::string strFileName = fileName;
-                m_SortedEntries.insert(std::make_pair(strFileName, fileIndex));
-                std::size_t pos = strFileName.find_first_of('/');
+                std::size_t pos = node.stat.filePath.find_first_of('/');
                 if (pos != std::string::npos)
                 {
-                    m_SortedToplevelDirs.insert(strFileName.substr(0, pos));
+                    m_SortedToplevelDirs.insert(node.stat.filePath.substr(0, pos));
                 }
+                nodes.push_back(std::move(node));
             }
         }
+
+        // Sort by path and drop duplicate names, keeping the first entry
+        std::stable_sort(nodes.begin(),
+                         nodes.end(),
+                         [](IndexNode const& n1, IndexNode const& n2) { return n1.stat.filePath < n2.stat.filePath; });
+        nodes.erase(std::unique(nodes.begin(),
+                                nodes.end(),
+                                [](IndexNode const& n1, IndexNode const& n2)
+                                { return n1.stat.filePath == n2.stat.filePath; }),
+                    nodes.end());
+
+        // The map keys refer to the strings in m_Index, so it must not be
+        // modified after this point.
+        m_Index = std::move(nodes);
+        m_IndexByPath.reserve(m_Index.size());
+        m_IndexByZipIndex.assign(numFiles, UINT32_MAX);
+        for (uint32_t i = 0; i < m_Index.size(); ++i)
+        {
+            m_IndexByPath.emplace(m_Index[i].stat.filePath, i);
+            m_IndexByZipIndex[m_Index[i].stat.index] = i;
+        }
+
+        // Link each entry to its parent directory entry, if there is one.
+        // Iterating in path order keeps the children of a directory sorted.
+        std::vector<uint32_t> parents(m_Index.size(), UINT32_MAX);
+        for (uint32_t i = 0; i < m_Index.size(); ++i)
+        {
+            std::string_view path(m_Index[i].stat.filePath);
+            if (path.back() == '/')
+            {
+                path.remove_suffix(1);
+            }
+            std::size_t pos = path.find_last_of('/');
+            if (pos == std::string_view::npos)
+            {
+                continue;
+            }
+            m_Index[i].nameOffset = pos + 1;
+            auto parent = m_IndexByPath.find(path.substr(0, pos + 1));
+            if (parent != m_IndexByPath.end())
+            {
+                parents[i] = parent->second;
+                ++m_Index[parent->second].childCount;
+            }
+        }
+
+        uint32_t firstChild = 0;
+        for (auto& node : m_Index)
+        {
+            node.firstChild = firstChild;
+            firstChild += node.childCount;
+            node.childCount = 0;
+        }
+        m_IndexChildren.resize(firstChild);
+        for (uint32_t i = 0; i < m_Index.size(); ++i)
+        {
+            if (parents[i] != UINT32_MAX)
+            {
+                auto& parent = m_Index[parents[i]];
+                m_IndexChildren[parent.firstChild + parent.childCount++] = i;
+            }
+        }
+    }
+
+    BundleResourceContainer::IndexNode const*
+    BundleResourceContainer::FindIndexNode(std::string_view path) const
+    {
+        auto iter = m_IndexByPath.find(path);
+        return iter == m_IndexByPath.end() ? nullptr : &m_Index[iter->second];
     }
 
     bool
-    BundleResourceContainer::Matches(std::string const& name, std::string const& filePattern) const
+    BundleResourceContainer::Matches(std::string_view name, std::string_view filePattern) const
     {
         // short-cut
         if (filePattern == "*")
@@ -269,17 +514,24 @@ namespace cppmicroservices
             return true;
         }
 
-        std::stringstream ss(filePattern);
-        std::string tok;
+        // each '*' separated token must appear in order
         std::size_t pos = 0;
-        while (std::getline(ss, tok, '*'))
+        std::size_t tokenStart = 0;
+        while (tokenStart <= filePattern.size())
         {
+            std::size_t tokenEnd = filePattern.find('*', tokenStart);
+            if (tokenEnd == std::string_view::npos)
+            {
+                tokenEnd = filePattern.size();
+            }
+            std::string_view tok = filePattern.substr(tokenStart, tokenEnd - tokenStart);
             std::size_t index = name.find(tok, pos);
-            if (index == std::string::npos)
+            if (index == std::string_view::npos)
             {
                 return false;
             }
             pos = index + tok.size();
+            tokenStart = tokenEnd + 1;
         }
         return true;
     }
@@ -292,13 +544,15 @@ namespace cppmicroservices
         {
             InitMiniz();
 
-            InitSortedEntries();
+            InitIndex();
             if (m_SortedToplevelDirs.empty())
             {
                 // This is not a file containing a valid bundle
                 // so make sure we clean up and close the file handle.
                 mz_zip_reader_end(&m_ZipArchive);
+                CloseFileDescriptor();
                 m_ObjFile.reset();
+                m_RawData.reset();
                 throw std::runtime_error("Invalid zip archive layout for bundle at " + m_Location);
             }
             m_IsContainerOpen = true;
@@ -312,7 +566,9 @@ namespace cppmicroservices
         if (m_IsContainerOpen)
         {
             mz_zip_reader_end(&m_ZipArchive);
+            CloseFileDescriptor();
             m_ObjFile.reset();
+            m_RawData.reset();
             m_IsContainerOpen = false;
         }
     }
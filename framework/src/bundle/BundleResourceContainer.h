@@ -42,6 +42,8 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace cppmicroservices
@@ -80,6 +82,12 @@ namespace cppmicroservices
 
         std::unique_ptr<void, void (*)(void*)> GetData(int index);
 
+        /// Returns a pointer to the data of an uncompressed (stored) entry,
+        /// pointing directly into the memory mapped bundle. The returned
+        /// pointer keeps the mapping alive. Returns nullptr if the entry is
+        /// compressed or the container is not backed by a memory mapping.
+        std::shared_ptr<void const> GetMappedData(int index);
+
         void GetChildren(std::string const& resourcePath,
                          bool relativePaths,
                          std::vector<std::string>& names,
@@ -98,25 +106,46 @@ namespace cppmicroservices
         void CloseContainer();
 
       private:
-        using NameIndexPair = std::pair<std::string, int>;
-
-        struct PairComp
+        /// A node of the resource index. Nodes are sorted by their full path
+        /// and the children of a directory node are the m_IndexChildren
+        /// elements in the range [firstChild, firstChild + childCount).
+        struct IndexNode
         {
-            inline bool
-            operator()(NameIndexPair const& p1, NameIndexPair const& p2) const
-            {
-                return p1.first < p2.first;
-            }
+            Stat stat;
+            std::size_t nameOffset; // start of the entry name in stat.filePath
+            uint32_t firstChild;
+            uint32_t childCount;
         };
 
-        void InitSortedEntries() const;
+        /// Builds the resource index from the zip central directory. The
+        /// index is built once and kept for the lifetime of the container.
+        void InitIndex() const;
+
+        /// Returns the index node for the full resource path or nullptr.
+        IndexNode const* FindIndexNode(std::string_view path) const;
+
+        bool ReadStat(int index, Stat& stat) const;
+
+        void FindNodes(std::shared_ptr<BundleArchive const> const& archive,
+                       IndexNode const& dir,
+                       std::string_view filePattern,
+                       bool recurse,
+                       std::vector<BundleResource>& resources) const;
 
-        bool Matches(std::string const& name, std::string const& filePattern) const;
+        bool Matches(std::string_view name, std::string_view filePattern) const;
 
         /// Initialize miniz with the resource zip file information.
         /// throws std::runtime_error if the underlying zip file cannot be opened or read.
         void InitMiniz() const;
 
+        /// Initialize miniz with a reader which uses positional reads on the
+        /// bundle file, so that concurrent reads do not share a file position.
+        /// Returns false if the platform or the file does not support it.
+        bool InitMinizWithPositionalReader() const;
+
+        /// Closes the file descriptor of the positional reader, if any.
+        void CloseFileDescriptor() const;
+
         /// Opens the zip file so that data can be accessed.
         /// This function is thread-safe.
         /// Throws std::runtime_error if the underlying zip file cannot be opened.
@@ -126,13 +155,26 @@ namespace cppmicroservices
         mutable mz_zip_archive m_ZipArchive;
         mutable std::unique_ptr<BundleObjFile> m_ObjFile;
 
-        mutable std::set<NameIndexPair, PairComp> m_SortedEntries;
+        // The memory mapped resource zip, if miniz was initialized from memory.
+        mutable std::shared_ptr<RawBundleResources> m_RawData;
+
+        mutable std::vector<IndexNode> m_Index;
+        mutable std::vector<uint32_t> m_IndexChildren;
+        // keys are views of the stat.filePath strings in m_Index
+        mutable std::unordered_map<std::string_view, uint32_t> m_IndexByPath;
+        // zip file index to m_Index position
+        mutable std::vector<uint32_t> m_IndexByZipIndex;
         mutable std::set<std::string> m_SortedToplevelDirs;
 
-        // This is used to synchronize miniz file stream API calls.
-        // Working with file streams is stateful (e.g. current read position)
-        // and hence not thread-safe.
+        // Reads from a memory mapped archive or through the positional file
+        // reader are stateless and may run concurrently. Only miniz's own
+        // file stream reader, which is used as a fallback, is stateful (e.g.
+        // current read position) and needs these calls to be synchronized.
         mutable std::mutex m_ZipFileStreamMutex;
+        mutable bool m_SerializeReads;
+
+        // The file descriptor used by the positional file reader, or -1.
+        mutable int m_FileDescriptor;
 
         // Synchronize opening/closing the underlying zip file. Only one thread
         // should open the underlying zip file.
@@ -74,6 +74,12 @@ namespace cppmicroservices
          */
         virtual std::vector<long> GetStartOnLaunchBundles() const = 0;
 
+        /**
+         * Whether bundle archives keep the manifest parsed from their bundle,
+         * so that the storage can persist it.
+         */
+        virtual bool KeepsManifests() const = 0;
+
         /**
          * Close this bundle storage and all bundles in it.
          */
@@ -88,6 +94,20 @@ namespace cppmicroservices
          * @return true if element was removed.
          */
         virtual bool RemoveArchive(BundleArchive const* ba) = 0;
+
+        /**
+         * Called when the autostart setting of a bundle archive changed.
+         *
+         * @param ba The changed bundle archive.
+         */
+        virtual void AutostartSettingChanged(BundleArchive const*) {}
+
+        /**
+         * Called when a bundle archive cached the manifest read from its bundle.
+         *
+         * @param ba The changed bundle archive.
+         */
+        virtual void ManifestCached(BundleArchive const*) {}
     };
 } // namespace cppmicroservices
 
@@ -22,46 +22,693 @@
 
 #include "BundleStorageFile.h"
 
+#include "cppmicroservices/GlobalConfig.h"
+#include "cppmicroservices/util/BinaryManifest.h"
+#include "cppmicroservices/util/FileSystem.h"
+
 #include "BundleArchive.h"
+#include "BundleManifest.h"
+#include "BundleResourceContainer.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
 #include <stdexcept>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef US_PLATFORM_WINDOWS
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
 
 namespace cppmicroservices
 {
 
-    BundleStorageFile::BundleStorageFile() : BundleStorage() { throw std::logic_error("not implemented"); }
+    namespace
+    {
+
+        std::string const STORAGE_FILE_NAME = "archives.dat";
+
+        char const STORAGE_MAGIC[8] = { 'U', 'S', 'B', 'S', 'T', 'O', 'R', 'E' };
+        uint32_t const STORAGE_FORMAT_VERSION = 3;
+
+        // The file is rewritten once it holds this many more records than
+        // twice the number of archives.
+        std::size_t const COMPACTION_SLACK = 64;
+
+        enum class RecordType : uint8_t
+        {
+            Insert = 1,
+            Remove = 2,
+            AutostartSetting = 3
+        };
+
+        // magic, version, next free bundle id
+        std::size_t const FILE_HEADER_SIZE = sizeof(STORAGE_MAGIC) + sizeof(uint32_t) + sizeof(int64_t);
+        // payload size, checksum
+        std::size_t const RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+
+#ifdef US_PLATFORM_WINDOWS
+        int const WRITE_FLAGS = _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY;
+        int const APPEND_FLAGS = _O_WRONLY | _O_APPEND | _O_BINARY;
+#else
+        int const WRITE_FLAGS = O_WRONLY | O_CREAT | O_TRUNC;
+        int const APPEND_FLAGS = O_WRONLY | O_APPEND;
+#endif
+
+        uint64_t
+        Checksum(std::string_view data)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ull;
+            for (auto c : data)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::string
+        FrameRecord(std::string const& payload)
+        {
+            binarymanifest::Writer record;
+            record.WriteUInt32(static_cast<uint32_t>(payload.size()));
+            record.WriteUInt64(Checksum(payload));
+            record.WriteBytes(payload);
+            return record.Data();
+        }
+
+        bool
+        GetFileInfo(std::string const& path, int64_t& size, int64_t& modifiedTime)
+        {
+            try
+            {
+                return util::GetFileSizeAndModifiedTime(path, size, modifiedTime);
+            }
+            catch (std::exception const&)
+            {
+                return false;
+            }
+        }
+
+        [[noreturn]] void
+        ThrowFileError(std::string const& action, std::string const& path)
+        {
+            throw std::runtime_error("Could not " + action + " bundle storage file " + path + ": "
+                                     + std::strerror(errno));
+        }
+
+        /**
+         * Writes data to a file and closes it, syncing it to disk first if
+         * sync is true.
+         */
+        void
+        WriteFile(std::string const& path, int flags, std::string const& data, bool sync)
+        {
+#ifdef US_PLATFORM_WINDOWS
+            int const fd = _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+            int const fd = open(path.c_str(), flags, 0644);
+#endif
+            if (fd < 0)
+            {
+                ThrowFileError("open", path);
+            }
+            std::size_t written = 0;
+            bool ok = true;
+            while (ok && written < data.size())
+            {
+#ifdef US_PLATFORM_WINDOWS
+                auto result = _write(fd,
+                                     data.data() + written,
+                                     static_cast<unsigned int>(std::min<std::size_t>(data.size() - written, 1u << 30)));
+#else
+                auto result = write(fd, data.data() + written, data.size() - written);
+#endif
+                if (result < 0 && errno != EINTR)
+                {
+                    ok = false;
+                }
+                else if (result > 0)
+                {
+                    written += static_cast<std::size_t>(result);
+                }
+            }
+#ifdef US_PLATFORM_WINDOWS
+            ok = ok && (!sync || _commit(fd) == 0);
+            _close(fd);
+#else
+            ok = ok && (!sync || fsync(fd) == 0);
+            close(fd);
+#endif
+            if (!ok)
+            {
+                ThrowFileError("write", path);
+            }
+        }
+
+        // Makes a rename within the directory durable.
+        void
+        SyncDirectory(std::string const& directory)
+        {
+#ifndef US_PLATFORM_WINDOWS
+            int const fd = open(directory.c_str(), O_RDONLY);
+            if (fd >= 0)
+            {
+                fsync(fd);
+                close(fd);
+            }
+#else
+            US_UNUSED(directory);
+#endif
+        }
+
+    } // namespace
+
+    BundleStorageFile::BundleStorageFile(std::string const& storageDir, bool clean)
+        : BundleStorage()
+        , storageDir(storageDir)
+        , storageFile(storageDir + util::DIR_SEP + STORAGE_FILE_NAME)
+        , nextFreeId(1)
+    {
+        if (clean)
+        {
+            std::remove(storageFile.c_str());
+        }
+        else
+        {
+            Restore();
+        }
+
+        // Start from a file holding exactly one record per archive
+        auto fl = file.Lock();
+        US_UNUSED(fl);
+        if (!file.valid || file.records > archives.v.size())
+        {
+            try
+            {
+                Compact_unlocked();
+            }
+            catch (std::exception const&)
+            {
+                // Retried on the next change, see TryFlush()
+            }
+        }
+    }
 
     std::shared_ptr<BundleArchive>
-    BundleStorageFile::CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& /*resCont*/
-                                              ,
-                                              std::string const& /*topLevelEntries*/
-                                              ,
-                                              ManifestT const&)
+    BundleStorageFile::CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& resCont,
+                                              std::string const& prefix,
+                                              ManifestT const& bundleManifest)
     {
-        throw std::logic_error("not implemented");
+        auto const& location = resCont->GetLocation();
+        FileInfo info { -1, -1 };
+        GetFileInfo(location, info.size, info.modifiedTime);
+
+        std::shared_ptr<BundleArchive> ba;
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            // Keep the state of the file when it was first read; a later change
+            // is detected when the archive is restored.
+            archives.files.emplace(location, info);
+            auto id = nextFreeId++;
+            ba = std::make_shared<BundleArchive>(this, resCont, prefix, location, id, bundleManifest);
+            archives.v.emplace(id, ba);
+            archives.pending.push_back(FrameRecord(EncodeInsert_unlocked(*ba)));
+        }
+        TryFlush();
+        return ba;
     }
 
     bool
-    BundleStorageFile::RemoveArchive(BundleArchive const* /*ba*/)
+    BundleStorageFile::RemoveArchive(BundleArchive const* ba)
+    {
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            auto iter = archives.v.find(ba->GetBundleId());
+            if (iter == archives.v.end())
+            {
+                return false;
+            }
+            auto location = iter->second->GetBundleLocation();
+            archives.v.erase(iter);
+            if (std::none_of(archives.v.begin(),
+                             archives.v.end(),
+                             [&location](auto const& a) { return a.second->GetBundleLocation() == location; }))
+            {
+                archives.files.erase(location);
+            }
+            binarymanifest::Writer record;
+            record.WriteUInt8(static_cast<uint8_t>(RecordType::Remove));
+            record.WriteInt64(ba->GetBundleId());
+            archives.pending.push_back(FrameRecord(record.Data()));
+        }
+        TryFlush();
+        return true;
+    }
+
+    void
+    BundleStorageFile::AutostartSettingChanged(BundleArchive const* ba)
     {
-        throw std::logic_error("not implemented");
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            // Archives are also changed while they are restored, before
+            // they are inserted.
+            auto iter = archives.v.find(ba->GetBundleId());
+            if (iter == archives.v.end() || iter->second.get() != ba)
+            {
+                return;
+            }
+            binarymanifest::Writer record;
+            record.WriteUInt8(static_cast<uint8_t>(RecordType::AutostartSetting));
+            record.WriteInt64(ba->GetBundleId());
+            record.WriteInt32(ba->GetAutostartSetting());
+            archives.pending.push_back(FrameRecord(record.Data()));
+        }
+        TryFlush();
+    }
+
+    void
+    BundleStorageFile::ManifestCached(BundleArchive const* ba)
+    {
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            auto iter = archives.v.find(ba->GetBundleId());
+            if (iter == archives.v.end() || iter->second.get() != ba)
+            {
+                return;
+            }
+            // Replaces the archive's record when the file is restored
+            archives.pending.push_back(FrameRecord(EncodeInsert_unlocked(*ba)));
+        }
+        TryFlush();
     }
 
     std::vector<std::shared_ptr<BundleArchive>>
     BundleStorageFile::GetAllBundleArchives() const
     {
-        throw std::logic_error("not implemented");
+        std::vector<std::shared_ptr<BundleArchive>> res;
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        for (auto const& v : archives.v)
+        {
+            res.emplace_back(v.second);
+        }
+        return res;
     }
 
     std::vector<long>
     BundleStorageFile::GetStartOnLaunchBundles() const
     {
-        throw std::logic_error("not implemented");
+        std::vector<long> res;
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        for (auto& v : archives.v)
+        {
+            if (v.second->GetAutostartSetting() != -1)
+            {
+                res.emplace_back(v.second->GetBundleId());
+            }
+        }
+        return res;
+    }
+
+    bool
+    BundleStorageFile::KeepsManifests() const
+    {
+        return true;
     }
 
     void
     BundleStorageFile::Close()
     {
-        throw std::logic_error("not implemented");
+        try
+        {
+            Flush(true);
+        }
+        catch (std::exception const&)
+        {
+            // See TryFlush()
+        }
+
+        auto l = archives.Lock();
+        US_UNUSED(l);
+        archives.v.clear();
+        archives.files.clear();
+        archives.pending.clear();
+    }
+
+    void
+    BundleStorageFile::Restore()
+    {
+        std::string data;
+        {
+            std::ifstream in(storageFile, std::ios_base::in | std::ios_base::binary);
+            if (!in)
+            {
+                return;
+            }
+            data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        struct ArchiveRecord
+        {
+            std::string location;
+            FileInfo info;
+            std::vector<std::string> topLevelDirs;
+            std::string prefix;
+            int32_t autostartSetting;
+            AnyMap manifest { AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS };
+        };
+
+        if (data.size() < FILE_HEADER_SIZE || std::memcmp(data.data(), STORAGE_MAGIC, sizeof(STORAGE_MAGIC)) != 0)
+        {
+            return;
+        }
+        binarymanifest::Reader header(std::string_view(data).substr(sizeof(STORAGE_MAGIC)));
+        uint32_t version = 0;
+        int64_t storedNextFreeId = 0;
+        if (!header.ReadUInt32(version) || version != STORAGE_FORMAT_VERSION || !header.ReadInt64(storedNextFreeId))
+        {
+            return;
+        }
+
+        // Replay the records. A record torn by a crash, and anything after
+        // it, is ignored; the file is then rewritten by the constructor.
+        std::map<long, ArchiveRecord> records;
+        std::size_t recordCount = 0;
+        std::string_view remaining = std::string_view(data).substr(FILE_HEADER_SIZE);
+        while (!remaining.empty())
+        {
+            binarymanifest::Reader frame(remaining);
+            uint32_t size = 0;
+            uint64_t checksum = 0;
+            if (!frame.ReadUInt32(size) || !frame.ReadUInt64(checksum) || frame.Remaining() < size)
+            {
+                break;
+            }
+            auto payload = remaining.substr(RECORD_HEADER_SIZE, size);
+            if (Checksum(payload) != checksum)
+            {
+                break;
+            }
+
+            binarymanifest::Reader reader(payload);
+            uint8_t type = 0;
+            int64_t id = 0;
+            if (!reader.ReadUInt8(type) || !reader.ReadInt64(id) || id <= 0)
+            {
+                break;
+            }
+            storedNextFreeId = std::max(storedNextFreeId, id + 1);
+            if (type == static_cast<uint8_t>(RecordType::Insert))
+            {
+                ArchiveRecord record;
+                uint32_t dirCount = 0;
+                uint8_t hasManifest = 0;
+                bool ok = reader.ReadString(record.location) && reader.ReadInt64(record.info.size)
+                          && reader.ReadInt64(record.info.modifiedTime) && reader.ReadUInt32(dirCount);
+                for (uint32_t i = 0; ok && i < dirCount; ++i)
+                {
+                    std::string dir;
+                    ok = reader.ReadString(dir);
+                    record.topLevelDirs.push_back(std::move(dir));
+                }
+                if (!ok || !reader.ReadString(record.prefix) || !reader.ReadInt32(record.autostartSetting)
+                    || !reader.ReadUInt8(hasManifest)
+                    || (hasManifest != 0 && !BundleManifest::DecodeBinaryHeaders(reader, record.manifest)))
+                {
+                    break;
+                }
+                records[static_cast<long>(id)] = std::move(record);
+            }
+            else if (type == static_cast<uint8_t>(RecordType::Remove))
+            {
+                records.erase(static_cast<long>(id));
+            }
+            else if (type == static_cast<uint8_t>(RecordType::AutostartSetting))
+            {
+                int32_t setting = 0;
+                if (!reader.ReadInt32(setting))
+                {
+                    break;
+                }
+                auto iter = records.find(static_cast<long>(id));
+                if (iter != records.end())
+                {
+                    iter->second.autostartSetting = setting;
+                }
+            }
+            else
+            {
+                break;
+            }
+            ++recordCount;
+            remaining.remove_prefix(RECORD_HEADER_SIZE + size);
+        }
+
+        {
+            auto fl = file.Lock();
+            US_UNUSED(fl);
+            file.records = recordCount;
+            file.valid = remaining.empty();
+        }
+
+        // The state of each bundle file is the one recorded with its first
+        // archive, and its top level entries those of all its archives.
+        struct LocationState
+        {
+            FileInfo info;
+            std::set<std::string> topLevelDirs;
+            std::shared_ptr<BundleResourceContainer> container;
+            bool unchanged = false;
+        };
+        std::unordered_map<std::string, LocationState> locations;
+        for (auto const& record : records)
+        {
+            auto iter = locations.emplace(record.second.location, LocationState { record.second.info, {}, {}, false })
+                            .first;
+            iter->second.topLevelDirs.insert(record.second.topLevelDirs.begin(), record.second.topLevelDirs.end());
+        }
+
+        // Bundles whose file did not change share a resource container which
+        // is only opened when a resource is accessed. The others are re-read.
+        for (auto& location : locations)
+        {
+            auto& state = location.second;
+            FileInfo current { -1, -1 };
+            if (!GetFileInfo(location.first, current.size, current.modifiedTime))
+            {
+                continue;
+            }
+            state.unchanged = current.size == state.info.size && current.modifiedTime == state.info.modifiedTime
+                              && !state.topLevelDirs.empty();
+            try
+            {
+                if (state.unchanged)
+                {
+                    AnyMap topLevelDirs(AnyMap::UNORDERED_MAP);
+                    for (auto const& dir : state.topLevelDirs)
+                    {
+                        topLevelDirs.emplace(dir, Any());
+                    }
+                    state.container = std::make_shared<BundleResourceContainer>(location.first, topLevelDirs);
+                }
+                else
+                {
+                    state.container = std::make_shared<BundleResourceContainer>(
+                        location.first,
+                        AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS));
+                }
+                archives.files.emplace(location.first, current);
+            }
+            catch (std::exception const&)
+            {
+                // The file is no longer a valid bundle; drop its archives.
+            }
+        }
+
+        for (auto& record : records)
+        {
+            auto const& state = locations.at(record.second.location);
+            if (!state.container)
+            {
+                continue;
+            }
+            auto manifest = state.unchanged ? std::move(record.second.manifest)
+                                            : AnyMap(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+            auto ba = std::make_shared<BundleArchive>(this,
+                                                      state.container,
+                                                      record.second.prefix,
+                                                      record.second.location,
+                                                      record.first,
+                                                      std::move(manifest));
+            ba->SetAutostartSetting(record.second.autostartSetting);
+            archives.v.emplace(record.first, std::move(ba));
+        }
+        nextFreeId = std::max(static_cast<long>(storedNextFreeId), 1L);
+    }
+
+    std::string
+    BundleStorageFile::EncodeInsert_unlocked(BundleArchive const& ba) const
+    {
+        auto const& location = ba.GetBundleLocation();
+        auto fileIter = archives.files.find(location);
+        FileInfo info = fileIter != archives.files.end() ? fileIter->second : FileInfo { -1, -1 };
+        // The top level entries of the container, plus the bundle itself in
+        // case the container only knows the injected ones.
+        std::set<std::string> topLevelDirs;
+        auto dirs = ba.GetResourceContainer()->GetTopLevelDirs();
+        topLevelDirs.insert(dirs.begin(), dirs.end());
+        topLevelDirs.insert(ba.GetResourcePrefix());
+
+        binarymanifest::Writer writer;
+        writer.WriteUInt8(static_cast<uint8_t>(RecordType::Insert));
+        writer.WriteInt64(ba.GetBundleId());
+        writer.WriteString(location);
+        writer.WriteInt64(info.size);
+        writer.WriteInt64(info.modifiedTime);
+        writer.WriteUInt32(static_cast<uint32_t>(topLevelDirs.size()));
+        for (auto const& dir : topLevelDirs)
+        {
+            writer.WriteString(dir);
+        }
+        writer.WriteString(ba.GetResourcePrefix());
+        writer.WriteInt32(ba.GetAutostartSetting());
+        auto const& manifest = ba.GetInjectedManifest();
+        auto manifestPos = writer.Size();
+        writer.WriteUInt8(manifest.empty() ? 0 : 1);
+        if (!manifest.empty() && !BundleManifest::EncodeBinaryHeaders(manifest, writer))
+        {
+            // Store the archive without its manifest, which is then read
+            // from the bundle when the archive is restored.
+            writer.Truncate(manifestPos);
+            writer.WriteUInt8(0);
+        }
+        return writer.Data();
+    }
+
+    void
+    BundleStorageFile::Flush(bool sync)
+    {
+        auto fl = file.Lock();
+        US_UNUSED(fl);
+
+        std::string data;
+        std::size_t count = 0;
+        std::size_t liveCount = 0;
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            for (auto const& record : archives.pending)
+            {
+                data += record;
+            }
+            count = archives.pending.size();
+            archives.pending.clear();
+            liveCount = archives.v.size();
+        }
+
+        // Rewrite the file once most of its records are superseded, which
+        // keeps the cost of a change constant on average.
+        if (!file.valid || file.records + count > 2 * liveCount + COMPACTION_SLACK)
+        {
+            Compact_unlocked();
+            return;
+        }
+        if (count == 0 && !sync)
+        {
+            return;
+        }
+        try
+        {
+            WriteFile(storageFile, APPEND_FLAGS, data, sync);
+        }
+        catch (...)
+        {
+            // The changes are lost from the file; rewrite it with the next one.
+            file.valid = false;
+            throw;
+        }
+        file.records += count;
+    }
+
+    void
+    BundleStorageFile::TryFlush()
+    {
+        try
+        {
+            Flush(false);
+        }
+        catch (std::exception const&)
+        {
+            // The stored records only speed up and restore later launches;
+            // failing to write them must not fail installing, uninstalling,
+            // starting or stopping bundles, nor stopping the framework.
+        }
+    }
+
+    void
+    BundleStorageFile::Compact_unlocked()
+    {
+        std::string data;
+        std::size_t count = 0;
+        {
+            auto l = archives.Lock();
+            US_UNUSED(l);
+            // The records of all changes made so far are superseded
+            archives.pending.clear();
+
+            binarymanifest::Writer header;
+            header.WriteBytes(std::string_view(STORAGE_MAGIC, sizeof(STORAGE_MAGIC)));
+            header.WriteUInt32(STORAGE_FORMAT_VERSION);
+            header.WriteInt64(nextFreeId);
+            data = header.Data();
+            for (auto const& a : archives.v)
+            {
+                data += FrameRecord(EncodeInsert_unlocked(*a.second));
+            }
+            count = archives.v.size();
+        }
+
+        // Write and sync a temporary file before replacing the storage file,
+        // so that a crash never leaves a truncated or empty file behind.
+        file.valid = false;
+        std::string const tmpFile = storageFile + ".tmp";
+        try
+        {
+            WriteFile(tmpFile, WRITE_FLAGS, data, true);
+        }
+        catch (...)
+        {
+            std::remove(tmpFile.c_str());
+            throw;
+        }
+        if (std::rename(tmpFile.c_str(), storageFile.c_str()) != 0)
+        {
+            std::remove(storageFile.c_str());
+            if (std::rename(tmpFile.c_str(), storageFile.c_str()) != 0)
+            {
+                std::remove(tmpFile.c_str());
+                ThrowFileError("replace", storageFile);
+            }
+        }
+        SyncDirectory(storageDir);
+        file.records = count;
+        file.valid = true;
     }
 } // namespace cppmicroservices
@@ -23,20 +23,52 @@
 #ifndef CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 #define CPPMICROSERVICES_BUNDLESTORAGEFILE_H
 
+#include "cppmicroservices/detail/Threads.h"
+
 #include "BundleStorage.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace cppmicroservices
 {
 
+    /**
+     * Bundle storage which records the installed bundle archives in a file,
+     * so that they can be restored when the framework is initialized again.
+     *
+     * Besides the bundle id, location and autostart setting, each record
+     * holds the manifest and the top level entries read from the bundle, and
+     * the size and modification time of the bundle file. Archives whose file
+     * did not change are restored without opening the file; the others are
+     * re-read from the file.
+     *
+     * The file is a journal: inserting or removing an archive, caching its
+     * manifest or changing its autostart setting appends a record of the
+     * change, so that it survives a crash of the process. Each record carries a checksum, so
+     * that a record torn by a crash is detected and ignored, together with
+     * anything after it. Once most records are superseded, the file is
+     * rewritten with one record per archive, to a temporary file which is
+     * synced to disk and renamed into place. Appended records are synced to
+     * disk when the storage is closed.
+     */
     class BundleStorageFile : public BundleStorage
     {
 
       public:
-        BundleStorageFile();
+        /**
+         * @param storageDir The directory holding the storage file.
+         * @param clean If true, the stored records are discarded instead of restored.
+         */
+        BundleStorageFile(std::string const& storageDir, bool clean);
 
         std::shared_ptr<BundleArchive> CreateAndInsertArchive(std::shared_ptr<BundleResourceContainer> const& resCont,
                                                               std::string const& topLevelEntry,
-                                                              ManifestT const&) override;
+                                                              ManifestT const& bundleManifest) override;
 
         bool RemoveArchive(BundleArchive const* ba) override;
 
@@ -44,7 +76,72 @@ namespace cppmicroservices
 
         std::vector<long> GetStartOnLaunchBundles() const override;
 
+        bool KeepsManifests() const override;
+
         void Close() override;
+
+      private:
+        struct FileInfo
+        {
+            int64_t size;
+            int64_t modifiedTime;
+        };
+
+        void AutostartSettingChanged(BundleArchive const* ba) override;
+
+        void ManifestCached(BundleArchive const* ba) override;
+
+        void Restore();
+
+        /**
+         * Returns the record inserting the archive. Must be called with the
+         * archives lock held.
+         */
+        std::string EncodeInsert_unlocked(BundleArchive const& ba) const;
+
+        /**
+         * Appends the records of the changes made so far to the file, or
+         * rewrites it when most of its records are superseded.
+         *
+         * @param sync If true, the file is synced to disk.
+         */
+        void Flush(bool sync);
+
+        /**
+         * Flushes the records, ignoring any failure to write them.
+         */
+        void TryFlush();
+
+        /**
+         * Rewrites the file with one record per archive. Must be called with
+         * the file lock held.
+         */
+        void Compact_unlocked();
+
+        std::string const storageDir;
+        std::string const storageFile;
+        long nextFreeId;
+        /**
+         * Bundle id sorted list of all active bundle archives, the state of
+         * the bundle files at the time they were read, and the records of the
+         * changes not yet written to the file.
+         */
+        struct : detail::MultiThreaded<>
+        {
+            std::map<long, std::shared_ptr<BundleArchive>> v;
+            std::unordered_map<std::string, FileInfo> files;
+            std::vector<std::string> pending;
+        } archives;
+        /**
+         * The number of records in the file, and whether it can be appended
+         * to. When both are needed, this lock is taken before the archives
+         * lock, and it is held while the file is written.
+         */
+        struct : detail::MultiThreaded<>
+        {
+            std::size_t records = 0;
+            bool valid = false;
+        } file;
     };
 } // namespace cppmicroservices
 
@@ -92,6 +92,12 @@ namespace cppmicroservices
         return res;
     }
 
+    bool
+    BundleStorageMemory::KeepsManifests() const
+    {
+        return false;
+    }
+
     void
     BundleStorageMemory::Close()
     {
@@ -49,6 +49,8 @@ namespace cppmicroservices
 
         std::vector<long> GetStartOnLaunchBundles() const override;
 
+        bool KeepsManifests() const override;
+
         void Close() override;
 
       private:
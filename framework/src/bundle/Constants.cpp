@@ -44,11 +44,14 @@ namespace cppmicroservices
         const std::string BUNDLE_MANIFESTVERSION = "bundle.manifest_version";
         const std::string BUNDLE_ACTIVATIONPOLICY = "bundle.activation_policy";
         const std::string ACTIVATION_LAZY = "lazy";
+        const std::string BUNDLE_STARTAFTER = "bundle.start_after";
+        const std::string BUNDLE_STARTLEVEL = "bundle.start_level";
         const std::string FRAMEWORK_VERSION = "org.cppmicroservices.framework.version";
         const std::string FRAMEWORK_VENDOR = "org.cppmicroservices.framework.vendor";
         const std::string FRAMEWORK_STORAGE = "org.cppmicroservices.framework.storage";
         const std::string FRAMEWORK_STORAGE_CLEAN = "org.cppmicroservices.framework.storage.clean";
         const std::string FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT = "onFirstInit";
+        const std::string FRAMEWORK_STORAGE_PERSISTENT = "org.cppmicroservices.framework.storage.persistent";
         const std::string FRAMEWORK_THREADING_SUPPORT = "org.cppmicroservices.framework.threading.support";
         const std::string FRAMEWORK_THREADING_SINGLE = "single";
         const std::string FRAMEWORK_THREADING_MULTI = "multi";
@@ -57,8 +60,14 @@ namespace cppmicroservices
         const std::string FRAMEWORK_WORKING_DIR = "org.cppmicroservices.framework.working.dir";
         const std::string FRAMEWORK_BUNDLE_VALIDATION_FUNC
             = "org.cppmicroservices.framework.bundle.validation.function";
+        const std::string FRAMEWORK_BUNDLE_ACTIVATION_THREADS
+            = "org.cppmicroservices.framework.bundle.activation.threads";
+        const std::string FRAMEWORK_BEGINNING_STARTLEVEL
+            = "org.cppmicroservices.framework.startlevel.beginning";
         const std::string FRAMEWORK_EXTRA_SHUTDOWN_FUNC
             = "org.cppmicroservices.framework.shutdown.function";
+        const std::string FRAMEWORK_SERVICE_INDEXED_PROPERTIES
+            = "org.cppmicroservices.framework.service.indexed.properties";
         const std::string OBJECTCLASS = "objectclass";
         const std::string SERVICE_ID = "service.id";
         const std::string SERVICE_PID = "service.pid";
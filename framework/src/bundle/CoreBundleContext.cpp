@@ -35,6 +35,7 @@ US_MSVC_DISABLE_WARNING(4355)
 #include "cppmicroservices/util/String.h"
 
 #include "BundleContextPrivate.h"
+#include "BundleStorageFile.h"
 #include "BundleStorageMemory.h"
 #include "FrameworkPrivate.h"
 
@@ -123,11 +124,13 @@ namespace cppmicroservices
         DIAG_LOG(*sink) << "initializing";
         initCount++;
 
+        bool cleanStorage = false;
         auto storageCleanProp = frameworkProperties.find(Constants::FRAMEWORK_STORAGE_CLEAN);
         if (firstInit && storageCleanProp != frameworkProperties.end()
             && storageCleanProp->second == Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT)
         {
             // DeleteFWDir();
+            cleanStorage = true;
             firstInit = false;
         }
 
@@ -138,8 +141,18 @@ namespace cppmicroservices
 
         frameworkProperties[Constants::FRAMEWORK_UUID] = ss.str();
 
-        // $TODO we only support non-persistent (main memory) storage yet
-        storage = std::make_unique<BundleStorageMemory>();
+        auto storagePersistentProp = frameworkProperties.find(Constants::FRAMEWORK_STORAGE_PERSISTENT);
+        if (storagePersistentProp != frameworkProperties.end()
+            && storagePersistentProp->second.Type() == typeid(bool)
+            && any_cast<bool>(storagePersistentProp->second))
+        {
+            storage = std::make_unique<BundleStorageFile>(GetPersistentStoragePath(this, "bundles", /*create=*/true),
+                                                          cleanStorage);
+        }
+        else
+        {
+            storage = std::make_unique<BundleStorageMemory>();
+        }
         //  if (frameworkProperties[FWProps::READ_ONLY_PROP] == true)
         //  {
         //    dataStorage.clear();
@@ -146,6 +146,14 @@ namespace cppmicroservices
         }
     }
 
+    bool
+    ServiceHooks::HasServiceEventListenerHooks() const
+    {
+        std::vector<ServiceRegistrationBase> eventListenerHooks;
+        coreCtx->services.Get(us_service_interface_iid<ServiceEventListenerHook>(), eventListenerHooks);
+        return !eventListenerHooks.empty();
+    }
+
     void
     ServiceHooks::FilterServiceEventReceivers(ServiceEvent const& evt,
                                               ServiceListeners::ServiceListenerEntries& receivers)
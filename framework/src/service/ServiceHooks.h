@@ -66,6 +66,11 @@ namespace cppmicroservices
                                      std::string const& filter,
                                      std::vector<ServiceReferenceBase>& refs);
 
+        /**
+         * Returns true if at least one ServiceEventListenerHook is registered.
+         */
+        bool HasServiceEventListenerHooks() const;
+
         void FilterServiceEventReceivers(ServiceEvent const& evt, ServiceListeners::ServiceListenerEntries& receivers);
 
         void HandleServiceListenerReg(ServiceListenerEntry const& sle);
@@ -61,10 +61,12 @@ namespace cppmicroservices
             auto l = this->Lock();
             US_UNUSED(l);
             serviceSet.clear();
+            serviceSetSnapshot.reset();
             hashedServiceKeys.clear();
             complicatedListeners.clear();
             cache[0].clear();
             cache[1].clear();
+            objectClassCache.clear();
         }
 
         frameworkListenerMap.Lock(), frameworkListenerMap.value.clear();
@@ -95,6 +97,7 @@ namespace cppmicroservices
             auto l = this->Lock();
             US_UNUSED(l);
             serviceSet.insert(sle);
+            serviceSetSnapshot.reset();
             CheckSimple_unlocked(sle);
         }
         coreCtx->serviceHooks.HandleServiceListenerReg(sle);
@@ -124,6 +127,7 @@ namespace cppmicroservices
                     it->SetRemoved(true);
                     RemoveFromCache_unlocked(*it);
                     serviceSet.erase(it);
+                    serviceSetSnapshot.reset();
                 }
             }
             if (!sle.IsNull())
@@ -152,6 +156,7 @@ namespace cppmicroservices
                 it->SetRemoved(true);
                 RemoveFromCache_unlocked(*it);
                 serviceSet.erase(it);
+                serviceSetSnapshot.reset();
             }
         }
         if (!sle.IsNull())
@@ -366,6 +371,7 @@ namespace cppmicroservices
                 {
                     RemoveFromCache_unlocked(*it);
                     serviceSet.erase(it++);
+                    serviceSetSnapshot.reset();
                 }
                 else
                 {
@@ -449,10 +455,17 @@ namespace cppmicroservices
     void
     ServiceListeners::GetMatchingServiceListeners(ServiceEvent const& evt, ServiceListenerEntries& set)
     {
-        // Filter the original set of listeners
-        ServiceListenerEntries receivers = (this->Lock(), serviceSet);
-        // This must not be called with any locks held
-        coreCtx->serviceHooks.FilterServiceEventReceivers(evt, receivers);
+        // Only service event listener hooks can restrict the receivers of an event,
+        // so the set of listeners is copied only if such hooks exist.
+        ServiceListenerEntries filteredReceivers;
+        ServiceListenerEntries const* receivers = nullptr;
+        if (coreCtx->serviceHooks.HasServiceEventListenerHooks())
+        {
+            filteredReceivers = *GetServiceSetSnapshot();
+            // This must not be called with any locks held
+            coreCtx->serviceHooks.FilterServiceEventReceivers(evt, filteredReceivers);
+            receivers = &filteredReceivers;
+        }
 
         // Get a copy of the service reference and keep it until we are
         // done with its properties.
@@ -465,7 +478,7 @@ namespace cppmicroservices
             // Check complicated or empty listener filters
             for (auto& sse : complicatedListeners)
             {
-                if (receivers.count(sse) == 0)
+                if (receivers && receivers->count(sse) == 0)
                 {
                     continue;
                 }
@@ -481,6 +494,23 @@ namespace cppmicroservices
             for (auto& objClass : c)
             {
                 AddToSet_unlocked(set, receivers, OBJECTCLASS_IX, objClass);
+
+                // Evaluate the filters of listeners cached by object class
+                auto const cacheItr = objectClassCache.find(objClass);
+                if (cacheItr != objectClassCache.end())
+                {
+                    for (auto const& sse : cacheItr->second)
+                    {
+                        if ((receivers && receivers->count(sse) == 0) || set.count(sse) != 0)
+                        {
+                            continue;
+                        }
+                        if (sse.GetLDAPExpr().Evaluate(props, false))
+                        {
+                            set.insert(sse);
+                        }
+                    }
+                }
             }
 
             auto service_id = any_cast<long>(props->Value_unlocked(Constants::SERVICE_ID).first);
@@ -488,6 +518,18 @@ namespace cppmicroservices
         }
     }
 
+    std::shared_ptr<ServiceListeners::ServiceListenerEntries const>
+    ServiceListeners::GetServiceSetSnapshot() const
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        if (!serviceSetSnapshot)
+        {
+            serviceSetSnapshot = std::make_shared<ServiceListenerEntries const>(serviceSet);
+        }
+        return serviceSetSnapshot;
+    }
+
     std::vector<ServiceListenerHook::ListenerInfo>
     ServiceListeners::GetListenerInfoCollection() const
     {
@@ -524,7 +566,26 @@ namespace cppmicroservices
         }
         else
         {
-            complicatedListeners.remove(sle);
+            LDAPExpr::ObjectClassSet objClasses;
+            if (!sle.GetLDAPExpr().IsNull() && sle.GetLDAPExpr().GetMatchedObjectClasses(objClasses))
+            {
+                for (auto const& objClass : objClasses)
+                {
+                    auto cacheItr = objectClassCache.find(objClass);
+                    if (cacheItr != objectClassCache.end())
+                    {
+                        cacheItr->second.erase(sle);
+                        if (cacheItr->second.empty())
+                        {
+                            objectClassCache.erase(cacheItr);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                complicatedListeners.remove(sle);
+            }
         }
     }
 
@@ -554,26 +615,37 @@ namespace cppmicroservices
             }
             else
             {
-                complicatedListeners.push_back(sle);
+                LDAPExpr::ObjectClassSet objClasses;
+                if (sle.GetLDAPExpr().GetMatchedObjectClasses(objClasses))
+                {
+                    for (auto const& objClass : objClasses)
+                    {
+                        objectClassCache[objClass].insert(sle);
+                    }
+                }
+                else
+                {
+                    complicatedListeners.push_back(sle);
+                }
             }
         }
     }
 
     void
     ServiceListeners::AddToSet_unlocked(ServiceListenerEntries& set,
-                                        ServiceListenerEntries const& receivers,
+                                        ServiceListenerEntries const* receivers,
                                         int cache_ix,
                                         std::string const& val)
     {
         auto const cacheItr = cache[cache_ix].find(val);
         if (cacheItr != cache[cache_ix].end())
         {
-            std::set<ServiceListenerEntry>& l = cache[cache_ix][val];
+            std::set<ServiceListenerEntry>& l = cacheItr->second;
             if (!l.empty())
             {
                 for (ServiceListenerEntry const& entry : l)
                 {
-                    if (receivers.count(entry))
+                    if (!receivers || receivers->count(entry))
                     {
                         set.insert(entry);
                     }
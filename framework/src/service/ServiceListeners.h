@@ -29,6 +29,7 @@
 #include "ServiceListenerEntry.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
@@ -84,8 +85,22 @@ namespace cppmicroservices
         /* Service listeners with "simple" filters are cached. */
         CacheType cache[2];
 
+        /*
+         * Service listeners whose filters are not simple but only match services
+         * of certain object classes, e.g. "(&(objectclass=Foo)(target=bar))", are
+         * cached by these object classes. Their filters still have to be evaluated.
+         */
+        CacheType objectClassCache;
+
         ServiceListenerEntries serviceSet;
 
+        /**
+         * Read-only copy of serviceSet, only needed when service event listener
+         * hooks filter the receivers of an event. It is reset whenever a listener
+         * is added or removed and rebuilt on demand.
+         */
+        mutable std::shared_ptr<ServiceListenerEntries const> serviceSetSnapshot;
+
         CoreBundleContext* coreCtx;
 
       public:
@@ -237,8 +252,18 @@ namespace cppmicroservices
          */
         void CheckSimple_unlocked(ServiceListenerEntry const& sle);
 
+        /**
+         * Returns the current snapshot of serviceSet.
+         */
+        std::shared_ptr<ServiceListenerEntries const> GetServiceSetSnapshot() const;
+
+        /**
+         * Adds the cached listeners for the given key value to <code>set</code>.
+         *
+         * @param receivers If not null, only listeners contained in it are added.
+         */
         void AddToSet_unlocked(ServiceListenerEntries& set,
-                               ServiceListenerEntries const& receivers,
+                               ServiceListenerEntries const* receivers,
                                int cache_ix,
                                std::string const& val);
 
@@ -0,0 +1,230 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ServicePropertyIndex.h"
+
+#include "LDAPExpr.h"
+#include "Properties.h"
+
+#include <algorithm>
+
+namespace cppmicroservices
+{
+
+    void
+    ServicePropertyIndex::SetIndexedKeys(std::vector<std::string> const& keys)
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        indexedKeys = keys;
+        keyIndexes.clear();
+        keyIndexes.resize(indexedKeys.size());
+        entries.clear();
+    }
+
+    void
+    ServicePropertyIndex::Add(ServiceRegistrationBase const& sr, Properties const& props)
+    {
+        if (Empty())
+        {
+            return;
+        }
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        Add_unlocked(sr, props);
+    }
+
+    void
+    ServicePropertyIndex::Update(ServiceRegistrationBase const& sr, Properties const& props)
+    {
+        if (Empty())
+        {
+            return;
+        }
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        Remove_unlocked(sr);
+        Add_unlocked(sr, props);
+    }
+
+    void
+    ServicePropertyIndex::Remove(ServiceRegistrationBase const& sr)
+    {
+        if (Empty())
+        {
+            return;
+        }
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        Remove_unlocked(sr);
+    }
+
+    void
+    ServicePropertyIndex::Clear()
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        for (auto& keyIndex : keyIndexes)
+        {
+            keyIndex.byValue.clear();
+            keyIndex.unindexed.clear();
+        }
+        entries.clear();
+    }
+
+    bool
+    ServicePropertyIndex::GetCandidates(LDAPExpr const& filter, std::vector<ServiceRegistrationBase>& candidates) const
+    {
+        if (Empty())
+        {
+            return false;
+        }
+
+        std::vector<std::string> values(indexedKeys.size());
+        std::vector<std::size_t> matchedKeys;
+        for (std::size_t i = 0; i < indexedKeys.size(); ++i)
+        {
+            if (filter.GetMatchedAttributeValue(indexedKeys[i], values[i]))
+            {
+                matchedKeys.push_back(i);
+            }
+        }
+        if (matchedKeys.empty())
+        {
+            return false;
+        }
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        std::vector<ServiceRegistrationBase> const* bestValues = nullptr;
+        std::vector<ServiceRegistrationBase> const* bestUnindexed = nullptr;
+        std::size_t bestCount = 0;
+        for (auto i : matchedKeys)
+        {
+            auto const& keyIndex = keyIndexes[i];
+            auto iter = keyIndex.byValue.find(values[i]);
+            auto const* valueRegs = iter != keyIndex.byValue.end() ? &iter->second : nullptr;
+            std::size_t count = keyIndex.unindexed.size() + (valueRegs ? valueRegs->size() : 0);
+            if (bestUnindexed == nullptr || count < bestCount)
+            {
+                bestValues = valueRegs;
+                bestUnindexed = &keyIndex.unindexed;
+                bestCount = count;
+            }
+        }
+
+        candidates.clear();
+        candidates.reserve(bestCount);
+        if (bestValues)
+        {
+            candidates.insert(candidates.end(), bestValues->begin(), bestValues->end());
+        }
+        candidates.insert(candidates.end(), bestUnindexed->begin(), bestUnindexed->end());
+        return true;
+    }
+
+    void
+    ServicePropertyIndex::Add_unlocked(ServiceRegistrationBase const& sr, Properties const& props)
+    {
+        std::vector<Entry> srEntries(indexedKeys.size());
+        {
+            PropertiesHandle propsHandle(props, true);
+            for (std::size_t i = 0; i < indexedKeys.size(); ++i)
+            {
+                auto const& key = indexedKeys[i];
+                auto& entry = srEntries[i];
+                auto const& value = propsHandle->ValueByRef_unlocked(key);
+                if (!value.Empty() && value.Type() == typeid(std::string))
+                {
+                    entry.kind = EntryKind::Value;
+                    entry.value = ref_any_cast<std::string>(value);
+                }
+                else if (!value.Empty() || key.find('.') != std::string::npos)
+                {
+                    // Non-string values have type specific comparison rules and dotted
+                    // keys may be resolved against nested maps, so neither can be looked
+                    // up by value.
+                    entry.kind = EntryKind::Unindexed;
+                }
+                else
+                {
+                    entry.kind = EntryKind::Absent;
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < srEntries.size(); ++i)
+        {
+            auto& keyIndex = keyIndexes[i];
+            auto const& entry = srEntries[i];
+            if (entry.kind == EntryKind::Value)
+            {
+                keyIndex.byValue[entry.value].push_back(sr);
+            }
+            else if (entry.kind == EntryKind::Unindexed)
+            {
+                keyIndex.unindexed.push_back(sr);
+            }
+        }
+        entries[sr] = std::move(srEntries);
+    }
+
+    void
+    ServicePropertyIndex::Remove_unlocked(ServiceRegistrationBase const& sr)
+    {
+        auto iter = entries.find(sr);
+        if (iter == entries.end())
+        {
+            return;
+        }
+
+        auto const& srEntries = iter->second;
+        for (std::size_t i = 0; i < srEntries.size(); ++i)
+        {
+            auto& keyIndex = keyIndexes[i];
+            auto const& entry = srEntries[i];
+            if (entry.kind == EntryKind::Value)
+            {
+                auto valueIter = keyIndex.byValue.find(entry.value);
+                if (valueIter != keyIndex.byValue.end())
+                {
+                    auto& regs = valueIter->second;
+                    regs.erase(std::remove(regs.begin(), regs.end(), sr), regs.end());
+                    if (regs.empty())
+                    {
+                        keyIndex.byValue.erase(valueIter);
+                    }
+                }
+            }
+            else if (entry.kind == EntryKind::Unindexed)
+            {
+                auto& regs = keyIndex.unindexed;
+                regs.erase(std::remove(regs.begin(), regs.end(), sr), regs.end());
+            }
+        }
+        entries.erase(iter);
+    }
+} // namespace cppmicroservices
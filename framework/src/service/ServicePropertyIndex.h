@@ -0,0 +1,126 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CPPMICROSERVICES_SERVICEPROPERTYINDEX_H
+#define CPPMICROSERVICES_SERVICEPROPERTYINDEX_H
+
+#include "cppmicroservices/ServiceRegistration.h"
+#include "cppmicroservices/detail/Threads.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cppmicroservices
+{
+
+    class LDAPExpr;
+    class Properties;
+
+    /**
+     * A secondary index of service registrations by the values of a
+     * configurable set of service property keys.
+     *
+     * Only string property values are indexed. Registrations whose value for
+     * an indexed key is of another type are kept in a separate list which is
+     * always part of the candidates for that key, so the candidates returned
+     * by GetCandidates are a superset of the registrations matching the filter.
+     *
+     * Add, Update and Remove are called by the service registry while holding
+     * its lock. GetCandidates may be called concurrently without it.
+     */
+    class ServicePropertyIndex : private detail::MultiThreaded<>
+    {
+      public:
+        /**
+         * Set the property keys to index. Must be called before any
+         * registration is added.
+         */
+        void SetIndexedKeys(std::vector<std::string> const& keys);
+
+        bool
+        Empty() const
+        {
+            return indexedKeys.empty();
+        }
+
+        void Add(ServiceRegistrationBase const& sr, Properties const& props);
+
+        /**
+         * Re-index a registration after its properties were modified.
+         */
+        void Update(ServiceRegistrationBase const& sr, Properties const& props);
+
+        void Remove(ServiceRegistrationBase const& sr);
+
+        void Clear();
+
+        /**
+         * Get the registrations which can possibly match the given filter,
+         * using the indexed key with the fewest candidates.
+         *
+         * @param filter The filter to match.
+         * @param candidates Receives the candidate registrations, in no particular order.
+         * @return <code>false</code> if the filter does not require any indexed key
+         *         to equal a value, <code>true</code> otherwise.
+         */
+        bool GetCandidates(LDAPExpr const& filter, std::vector<ServiceRegistrationBase>& candidates) const;
+
+      private:
+        struct KeyIndex
+        {
+            std::unordered_map<std::string, std::vector<ServiceRegistrationBase>> byValue;
+
+            /**
+             * Registrations with a non-string value for the key.
+             */
+            std::vector<ServiceRegistrationBase> unindexed;
+        };
+
+        enum class EntryKind
+        {
+            Absent,
+            Value,
+            Unindexed
+        };
+
+        /**
+         * Where a registration is stored for the key at the same
+         * position in indexedKeys.
+         */
+        struct Entry
+        {
+            EntryKind kind;
+            std::string value;
+        };
+
+        std::vector<std::string> indexedKeys;
+        std::vector<KeyIndex> keyIndexes;
+        std::unordered_map<ServiceRegistrationBase, std::vector<Entry>> entries;
+
+        void Add_unlocked(ServiceRegistrationBase const& sr, Properties const& props);
+        void Remove_unlocked(ServiceRegistrationBase const& sr);
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_SERVICEPROPERTYINDEX_H
@@ -74,6 +74,14 @@ namespace cppmicroservices
                                                        std::shared_ptr<ServiceFactory> const& factory)
     {
         assert(factory && "Factory service pointer is nullptr");
+
+        // A service factory registered on behalf of a lazily started bundle, for
+        // example by Declarative Services, triggers the activation of that bundle.
+        if (auto owner = SafelyGetBundle())
+        {
+            owner->TriggerLazyActivation();
+        }
+
         try
         {
             InterfaceMapConstPtr smap = factory->GetService(MakeBundle(bundle->shared_from_this()),
@@ -167,8 +175,15 @@ namespace cppmicroservices
             {
                 auto factory
                     = std::static_pointer_cast<ServiceFactory>(reg->GetService("org.cppmicroservices.factory"));
-                s = GetServiceFromFactory(GetPrivate(bundle).get(), factory);
-                LockServiceRegistration(), coreInfo->prototypeServiceInstances[GetPrivate(bundle).get()].push_back(s);
+                auto bundlePrivate = GetPrivate(bundle).get();
+                s = GetServiceFromFactory(bundlePrivate, factory);
+                auto l = LockServiceRegistration();
+                US_UNUSED(l);
+                coreInfo->prototypeServiceInstances[bundlePrivate].push_back(s);
+                if (coreInfo->available)
+                {
+                    bundlePrivate->coreCtx->services.AddServiceUsage(bundlePrivate, ServiceRegistrationBase(reg));
+                }
             }
         }
         return s;
@@ -238,6 +253,10 @@ namespace cppmicroservices
 
             auto res = coreInfo->dependents.insert(std::make_pair(bundle, 0));
             auto& depCounter = res.first->second;
+            if (res.second)
+            {
+                bundle->coreCtx->services.AddServiceUsage(bundle, ServiceRegistrationBase(reg));
+            }
 
             // No service factory, just return the registered service directly.
             if (!serviceFactory)
@@ -299,10 +318,15 @@ namespace cppmicroservices
         s = GetServiceFromFactory(bundle, serviceFactory);
 
         {
+            auto reg = registration.lock();
             auto l = LockServiceRegistration();
             US_UNUSED(l);
 
-            coreInfo->dependents.insert(std::make_pair(bundle, 0));
+            // The service may have been unregistered while the factory was called.
+            if (coreInfo->dependents.insert(std::make_pair(bundle, 0)).second && coreInfo->available && reg)
+            {
+                bundle->coreCtx->services.AddServiceUsage(bundle, ServiceRegistrationBase(reg));
+            }
 
             if (s && !s->empty())
             {
@@ -383,6 +407,11 @@ namespace cppmicroservices
                 if (iter->second.empty())
                 {
                     coreInfo->prototypeServiceInstances.erase(iter);
+                    auto reg = registration.lock();
+                    if (reg && coreInfo->dependents.find(bundle.get()) == coreInfo->dependents.end())
+                    {
+                        bundle->coreCtx->services.RemoveServiceUsage(bundle.get(), ServiceRegistrationBase(reg));
+                    }
                 }
                 return true;
             }
@@ -446,6 +475,12 @@ namespace cppmicroservices
                 }
                 coreInfo->bundleServiceInstance.erase(bundle.get());
                 coreInfo->dependents.erase(bundle.get());
+                if (reg
+                    && coreInfo->prototypeServiceInstances.find(bundle.get())
+                           == coreInfo->prototypeServiceInstances.end())
+                {
+                    bundle->coreCtx->services.RemoveServiceUsage(bundle.get(), ServiceRegistrationBase(reg));
+                }
             }
         }
 
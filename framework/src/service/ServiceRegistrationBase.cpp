@@ -181,7 +181,20 @@ namespace cppmicroservices
                 // stored in the service registry, no need to type check before casting
                 old_rank = any_cast<int>(oldRankAny);
             }
-            d->coreInfo->properties = Properties(AnyMap(std::move(propsCopy)));
+            AnyMap props(AnyMap::FLAT_MAP);
+            props.reserve(propsCopy.size());
+            for (auto& kv : propsCopy)
+            {
+                props.emplace(kv.first, std::move(kv.second));
+            }
+            d->coreInfo->properties = Properties(std::move(props));
+        }
+        {
+            std::shared_ptr<BundlePrivate> bundle = SafelyGetBundle();
+            if (bundle)
+            {
+                bundle->coreCtx->services.UpdateIndexedProperties(*this);
+            }
         }
         if (old_rank != new_rank)
         {
@@ -330,6 +343,18 @@ namespace cppmicroservices
             auto l = LockServiceRegistration();
             US_UNUSED(l);
 
+            if (coreContext)
+            {
+                for (auto const& dependent : d->coreInfo->dependents)
+                {
+                    coreContext->services.RemoveServiceUsage(dependent.first, *this);
+                }
+                for (auto const& prototypeInstances : d->coreInfo->prototypeServiceInstances)
+                {
+                    coreContext->services.RemoveServiceUsage(prototypeInstances.first, *this);
+                }
+            }
+
             d->coreInfo->bundle_.reset();
             d->coreInfo->dependents.clear();
             d->coreInfo->service.reset();
@@ -27,12 +27,16 @@
 
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
+#include "LDAPExprCache.h"
 #include "ServiceRegistrationBasePrivate.h"
 #include "ServiceRegistrationLocks.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace cppmicroservices
 {
@@ -57,6 +61,14 @@ namespace cppmicroservices
         classServices.clear();
         serviceRegistrations.clear();
         bundleServices.clear();
+        propertyIndex.Clear();
+        {
+            auto l1 = serviceUsage.Lock();
+            US_UNUSED(l1);
+            serviceUsage.usedByBundle.clear();
+        }
+        std::atomic_store(&classServicesSnapshot, std::make_shared<MapClassServicesSnapshot const>());
+        std::atomic_store(&serviceRegistrationsSnapshot, ServiceRegistrationsConstPtr());
     }
 
     Properties
@@ -67,32 +79,52 @@ namespace cppmicroservices
                                              long sid)
     {
         static std::atomic<long> nextServiceID(1);
-        ServiceProperties props(in);
+
+        // Registered service properties are built once and read many times, which
+        // is what the flat map type is good at. Like the insertions into a
+        // ServiceProperties copy done previously, emplace does not replace values
+        // already provided by the caller.
+        AnyMap props(AnyMap::FLAT_MAP);
+        props.reserve(in.size() + 3);
+        for (auto const& kv : in)
+        {
+            props.emplace(kv.first, kv.second);
+        }
 
         if (!classes.empty())
         {
-            props.insert(std::make_pair(Constants::OBJECTCLASS, classes));
+            props.emplace(Constants::OBJECTCLASS, classes);
         }
 
-        props.insert(std::make_pair(Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++));
+        props.emplace(Constants::SERVICE_ID, sid != -1 ? sid : nextServiceID++);
 
         if (isPrototypeFactory)
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE));
+            props.emplace(Constants::SERVICE_SCOPE, Constants::SCOPE_PROTOTYPE);
         }
         else if (isFactory)
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_BUNDLE));
+            props.emplace(Constants::SERVICE_SCOPE, Constants::SCOPE_BUNDLE);
         }
         else
         {
-            props.insert(std::make_pair(Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON));
+            props.emplace(Constants::SERVICE_SCOPE, Constants::SCOPE_SINGLETON);
         }
 
-        return Properties(AnyMap(std::move(props)));
+        return Properties(std::move(props));
     }
 
-    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx) : core(coreCtx) {}
+    ServiceRegistry::ServiceRegistry(CoreBundleContext* coreCtx)
+        : core(coreCtx)
+        , classServicesSnapshot(std::make_shared<MapClassServicesSnapshot const>())
+        , serviceRegistrationsSnapshot()
+    {
+        auto indexedProps = core->frameworkProperties.find(Constants::FRAMEWORK_SERVICE_INDEXED_PROPERTIES);
+        if (indexedProps != core->frameworkProperties.end())
+        {
+            propertyIndex.SetIndexedKeys(any_cast<std::vector<std::string>>(indexedProps->second));
+        }
+    }
 
     ServiceRegistrationBase
     ServiceRegistry::RegisterService(BundlePrivate* bundle,
@@ -128,15 +160,21 @@ namespace cppmicroservices
         {
             auto l = this->Lock();
             US_UNUSED(l);
-            services.insert(std::make_pair(res, classes));
-            serviceRegistrations.push_back(res);
-            bundleServices[bundle].push_back(res);
+            auto& bundleRegs = bundleServices[bundle];
+            ServiceRegistrationEntry entry { classes,
+                                             bundle,
+                                             serviceRegistrations.insert(serviceRegistrations.end(), res),
+                                             bundleRegs.insert(bundleRegs.end(), res),
+                                             nextRegistrationOrder++ };
+            services.insert(std::make_pair(res, std::move(entry)));
             for (auto& clazz : classes)
             {
-                auto& s = classServices[clazz];
+                auto& s = classServices[clazz].registrations;
                 auto ip = std::lower_bound(s.rbegin(), s.rend(), res);
                 s.insert(ip.base(), res);
             }
+            propertyIndex.Add(res, res.d->coreInfo->properties);
+            PublishSnapshot_unlocked(classes, true);
         }
 
         ServiceReferenceBase r = res.GetReference(std::string());
@@ -154,32 +192,140 @@ namespace cppmicroservices
         US_UNUSED(l);
         for (auto& clazz : classes)
         {
-            auto& s = classServices[clazz];
+            auto& s = classServices[clazz].registrations;
             std::sort(s.rbegin(), s.rend());
         }
+        PublishSnapshot_unlocked(classes, false);
+    }
+
+    void
+    ServiceRegistry::UpdateIndexedProperties(ServiceRegistrationBase const& sr)
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        if (services.find(sr) != services.end())
+        {
+            propertyIndex.Update(sr, sr.d->coreInfo->properties);
+        }
+    }
+
+    void
+    ServiceRegistry::PublishSnapshot_unlocked(std::vector<std::string> const& classes, bool registrationsChanged)
+    {
+        auto const current = std::atomic_load(&classServicesSnapshot);
+        std::shared_ptr<MapClassServicesSnapshot> snapshot;
+        for (auto const& clazz : classes)
+        {
+            bool const hasServices = classServices.count(clazz) != 0;
+            auto i = current->find(clazz);
+            if (hasServices && i != current->end())
+            {
+                std::atomic_store(&i->second->registrations, ServiceRegistrationsConstPtr());
+                continue;
+            }
+            if (hasServices || i != current->end())
+            {
+                // A class got its first service or lost its last one
+                if (!snapshot)
+                {
+                    snapshot = std::make_shared<MapClassServicesSnapshot>(*current);
+                }
+                if (hasServices)
+                {
+                    (*snapshot)[clazz] = std::make_shared<ClassServicesSnapshotEntry const>();
+                }
+                else
+                {
+                    snapshot->erase(clazz);
+                }
+            }
+        }
+        if (snapshot)
+        {
+            std::atomic_store(&classServicesSnapshot,
+                              std::shared_ptr<MapClassServicesSnapshot const>(std::move(snapshot)));
+        }
+
+        if (registrationsChanged)
+        {
+            std::atomic_store(&serviceRegistrationsSnapshot, ServiceRegistrationsConstPtr());
+        }
+    }
+
+    ServiceRegistry::ServiceRegistrationsConstPtr
+    ServiceRegistry::GetServiceRegistrationsSnapshot() const
+    {
+        auto regs = std::atomic_load(&serviceRegistrationsSnapshot);
+        if (!regs)
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            regs = std::atomic_load(&serviceRegistrationsSnapshot);
+            if (!regs)
+            {
+                regs = std::make_shared<std::vector<ServiceRegistrationBase> const>(serviceRegistrations.begin(),
+                                                                                    serviceRegistrations.end());
+                std::atomic_store(&serviceRegistrationsSnapshot, regs);
+            }
+        }
+        return regs;
+    }
+
+    ServiceRegistry::ServiceRegistrationsConstPtr
+    ServiceRegistry::GetClassServices(MapClassServicesSnapshot const& snapshot, std::string const& clazz) const
+    {
+        auto i = snapshot.find(clazz);
+        if (i == snapshot.end())
+        {
+            return nullptr;
+        }
+        auto regs = std::atomic_load(&i->second->registrations);
+        if (!regs)
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            regs = std::atomic_load(&i->second->registrations);
+            if (!regs)
+            {
+                // The snapshot may be outdated, in which case the class can
+                // have lost all of its services since.
+                std::vector<ServiceRegistrationBase> current;
+                auto classIter = classServices.find(clazz);
+                if (classIter != classServices.end())
+                {
+                    auto const& s = classIter->second;
+                    current.reserve(s.registrations.size() - s.unregistered);
+                    std::copy_if(s.registrations.begin(),
+                                 s.registrations.end(),
+                                 std::back_inserter(current),
+                                 [this](ServiceRegistrationBase const& sr) { return services.count(sr) != 0; });
+                }
+                regs = std::make_shared<std::vector<ServiceRegistrationBase> const>(std::move(current));
+                std::atomic_store(&i->second->registrations, regs);
+            }
+        }
+        return regs;
     }
 
     void
     ServiceRegistry::Get(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const
     {
-        this->Lock(), Get_unlocked(removeLeadingNamespacing(clazz), serviceRegs);
+        Get_unlocked(removeLeadingNamespacing(clazz), serviceRegs);
     }
 
     void
     ServiceRegistry::Get_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const
     {
-        auto i = classServices.find(clazz);
-        if (i != classServices.end())
+        auto snapshot = std::atomic_load(&classServicesSnapshot);
+        if (auto regs = GetClassServices(*snapshot, clazz))
         {
-            serviceRegs = i->second;
+            serviceRegs = *regs;
         }
     }
 
     ServiceReferenceBase
     ServiceRegistry::Get(BundlePrivate* bundle, std::string const& clazz) const
     {
-        auto l = this->Lock();
-        US_UNUSED(l);
         try
         {
             std::vector<ServiceReferenceBase> srs;
@@ -205,7 +351,7 @@ namespace cppmicroservices
                          BundlePrivate* bundle,
                          std::vector<ServiceReferenceBase>& res) const
     {
-        this->Lock(), Get_unlocked(removeLeadingNamespacing(clazz), filter, bundle, res);
+        Get_unlocked(removeLeadingNamespacing(clazz), filter, bundle, res);
     }
 
     void
@@ -214,6 +360,9 @@ namespace cppmicroservices
                                   BundlePrivate* bundle,
                                   std::vector<ServiceReferenceBase>& res) const
     {
+        // Keep the snapshots alive while iterating over their registrations.
+        auto snapshot = std::atomic_load(&classServicesSnapshot);
+        ServiceRegistrationsConstPtr regs;
         std::vector<ServiceRegistrationBase>::const_iterator s;
         std::vector<ServiceRegistrationBase>::const_iterator send;
         std::vector<ServiceRegistrationBase> v;
@@ -222,17 +371,16 @@ namespace cppmicroservices
         {
             if (!filter.empty())
             {
-                ldap = LDAPExpr(filter);
+                ldap = LDAPExprCache::Instance().Get(filter);
                 LDAPExpr::ObjectClassSet matched;
                 if (ldap.GetMatchedObjectClasses(matched))
                 {
                     v.clear();
                     for (auto& className : matched)
                     {
-                        auto i = classServices.find(className);
-                        if (i != classServices.end())
+                        if (auto classRegs = GetClassServices(*snapshot, className))
                         {
-                            std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+                            std::copy(classRegs->begin(), classRegs->end(), std::back_inserter(v));
                         }
                     }
                     if (!v.empty())
@@ -247,23 +395,25 @@ namespace cppmicroservices
                 }
                 else
                 {
-                    s = serviceRegistrations.begin();
-                    send = serviceRegistrations.end();
+                    regs = GetServiceRegistrationsSnapshot();
+                    s = regs->begin();
+                    send = regs->end();
                 }
             }
             else
             {
-                s = serviceRegistrations.begin();
-                send = serviceRegistrations.end();
+                regs = GetServiceRegistrationsSnapshot();
+                s = regs->begin();
+                send = regs->end();
             }
         }
         else
         {
-            auto it = classServices.find(clazz);
-            if (it != classServices.end())
+            regs = GetClassServices(*snapshot, clazz);
+            if (regs)
             {
-                s = it->second.begin();
-                send = it->second.end();
+                s = regs->begin();
+                send = regs->end();
             }
             else
             {
@@ -271,15 +421,53 @@ namespace cppmicroservices
             }
             if (!filter.empty())
             {
-                ldap = LDAPExpr(filter);
+                ldap = LDAPExprCache::Instance().Get(filter);
             }
         }
 
+        // If the filter requires an indexed property to equal a value, only
+        // evaluate it against the services with that value.
+        std::vector<ServiceRegistrationBase> candidates;
+        bool checkClass = false;
+        if (!filter.empty() && propertyIndex.GetCandidates(ldap, candidates)
+            && candidates.size() < static_cast<std::size_t>(std::distance(s, send)))
+        {
+            std::sort(candidates.rbegin(), candidates.rend());
+            s = candidates.cbegin();
+            send = candidates.cend();
+            checkClass = !clazz.empty();
+        }
+
         for (; s != send; ++s)
         {
+            // A snapshot may still contain a registration which is being
+            // unregistered concurrently; such services are skipped.
+            if (!s->d->coreInfo->available)
+            {
+                continue;
+            }
+
+            if (checkClass)
+            {
+                PropertiesHandle props(s->d->coreInfo->properties, true);
+                auto const& objectClasses
+                    = ref_any_cast<std::vector<std::string>>(props->ValueByRef_unlocked(Constants::OBJECTCLASS));
+                if (std::find(objectClasses.begin(), objectClasses.end(), clazz) == objectClasses.end())
+                {
+                    continue;
+                }
+            }
+
             if (filter.empty() || ldap.Evaluate(PropertiesHandle((s->d->coreInfo->properties), true), false))
             {
-                res.emplace_back(s->GetReference(clazz));
+                try
+                {
+                    res.emplace_back(s->GetReference(clazz));
+                }
+                catch (std::logic_error const&)
+                {
+                    // unregistered after the availability check above
+                }
             }
         }
 
@@ -308,43 +496,48 @@ namespace cppmicroservices
     void
     ServiceRegistry::RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr)
     {
-        std::vector<std::string> classes;
+        auto entryIter = services.find(sr);
+        if (entryIter == services.end())
         {
-            auto l2 = sr.d->coreInfo->properties.Lock();
-            US_UNUSED(l2);
-            assert(sr.d->coreInfo->properties.Value_unlocked(Constants::OBJECTCLASS).first.Type()
-                   == typeid(std::vector<std::string>));
-            classes = ref_any_cast<std::vector<std::string>>(
-                sr.d->coreInfo->properties.Value_unlocked(Constants::OBJECTCLASS).first);
+            return;
         }
-        services.erase(sr);
-        serviceRegistrations.erase(std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
-                                   serviceRegistrations.end());
-        if (auto bundle = sr.d->coreInfo->bundle_.lock())
+        auto entry = std::move(entryIter->second);
+        services.erase(entryIter);
+        propertyIndex.Remove(sr);
+        serviceRegistrations.erase(entry.registrationsSlot);
+        auto it = bundleServices.find(entry.bundle);
+        if (it != bundleServices.end())
         {
-            auto it = bundleServices.find(bundle.get());
-            if (it != bundleServices.end())
+            it->second.erase(entry.bundleSlot);
+            if (it->second.empty())
             {
-                auto& regs = it->second;
-                regs.erase(std::remove(regs.begin(), regs.end(), sr), regs.end());
-                if (regs.empty())
-                {
-                    bundleServices.erase(it);
-                }
+                bundleServices.erase(it);
             }
         }
-        for (auto& clazz : classes)
+        for (auto& clazz : entry.classes)
         {
-            auto& s = classServices[clazz];
-            if (s.size() > 1)
+            auto classIter = classServices.find(clazz);
+            if (classIter == classServices.end())
             {
-                s.erase(std::remove(s.begin(), s.end(), sr), s.end());
+                continue;
             }
-            else
+            auto& s = classIter->second;
+            if (++s.unregistered == s.registrations.size())
             {
-                classServices.erase(clazz);
+                classServices.erase(classIter);
+            }
+            else if (s.unregistered > s.registrations.size() / 2)
+            {
+                // The registration has already been removed from services
+                s.registrations.erase(std::remove_if(s.registrations.begin(),
+                                                     s.registrations.end(),
+                                                     [this](ServiceRegistrationBase const& r)
+                                                     { return services.count(r) == 0; }),
+                                      s.registrations.end());
+                s.unregistered = 0;
             }
         }
+        PublishSnapshot_unlocked(entry.classes, true);
     }
 
     void
@@ -356,21 +549,67 @@ namespace cppmicroservices
         auto it = bundleServices.find(p);
         if (it != bundleServices.end())
         {
-            res = it->second;
+            res.assign(it->second.begin(), it->second.end());
         }
     }
 
     void
     ServiceRegistry::GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& res) const
     {
-        auto l = this->Lock();
+        std::vector<ServiceRegistrationBase> used;
+        {
+            auto l = serviceUsage.Lock();
+            US_UNUSED(l);
+            auto it = serviceUsage.usedByBundle.find(bundle);
+            if (it == serviceUsage.usedByBundle.end())
+            {
+                return;
+            }
+            used.assign(it->second.begin(), it->second.end());
+        }
+
+        // A service which is being unregistered can still have users until
+        // its unregistration completes; only report registered services.
+        std::vector<std::pair<uint64_t, ServiceRegistrationBase>> ordered;
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            for (auto& sr : used)
+            {
+                auto entryIter = services.find(sr);
+                if (entryIter != services.end())
+                {
+                    ordered.emplace_back(entryIter->second.registrationOrder, std::move(sr));
+                }
+            }
+        }
+        std::sort(ordered.begin(), ordered.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+        for (auto& o : ordered)
+        {
+            res.push_back(std::move(o.second));
+        }
+    }
+
+    void
+    ServiceRegistry::AddServiceUsage(BundlePrivate* bundle, ServiceRegistrationBase const& sr)
+    {
+        auto l = serviceUsage.Lock();
         US_UNUSED(l);
+        serviceUsage.usedByBundle[bundle].insert(sr);
+    }
 
-        for (auto const& serviceRegistration : serviceRegistrations)
+    void
+    ServiceRegistry::RemoveServiceUsage(BundlePrivate* bundle, ServiceRegistrationBase const& sr)
+    {
+        auto l = serviceUsage.Lock();
+        US_UNUSED(l);
+        auto it = serviceUsage.usedByBundle.find(bundle);
+        if (it != serviceUsage.usedByBundle.end())
         {
-            if (serviceRegistration.d->IsUsedByBundle(bundle))
+            it->second.erase(sr);
+            if (it->second.empty())
             {
-                res.push_back(serviceRegistration);
+                serviceUsage.usedByBundle.erase(it);
             }
         }
     }
@@ -27,6 +27,12 @@
 #include "cppmicroservices/ServiceRegistration.h"
 #include "cppmicroservices/detail/Threads.h"
 
+#include "ServicePropertyIndex.h"
+
+#include <cstdint>
+#include <list>
+#include <unordered_set>
+
 namespace cppmicroservices
 {
 
@@ -58,9 +64,54 @@ namespace cppmicroservices
                                                   bool isPrototypeFactory = false,
                                                   long sid = -1);
 
-        using MapServiceClasses = std::unordered_map<ServiceRegistrationBase, std::vector<std::string>>;
-        using MapClassServices = std::unordered_map<std::string, std::vector<ServiceRegistrationBase>>;
-        using MapBundleServices = std::unordered_map<BundlePrivate*, std::vector<ServiceRegistrationBase>>;
+        using ServiceRegistrationList = std::list<ServiceRegistrationBase>;
+
+        /**
+         * Book-keeping for a registered service. The list iterators are
+         * handles to the registration's slots in serviceRegistrations and
+         * bundleServices, so that unregistering does not need to search them.
+         */
+        struct ServiceRegistrationEntry
+        {
+            std::vector<std::string> classes;
+            BundlePrivate* bundle;
+            ServiceRegistrationList::iterator registrationsSlot;
+            ServiceRegistrationList::iterator bundleSlot;
+            uint64_t registrationOrder;
+        };
+
+        /**
+         * The registrations of a class, with the highest ranked service first.
+         *
+         * Unregistering a service only counts it as unregistered instead of
+         * searching and erasing it. The vector is compacted once more than
+         * half of it is unregistered, so that a bundle stop unregistering many
+         * services of one class takes linear time in total.
+         */
+        struct ClassServices
+        {
+            std::vector<ServiceRegistrationBase> registrations;
+            std::size_t unregistered = 0;
+        };
+
+        using MapServiceClasses = std::unordered_map<ServiceRegistrationBase, ServiceRegistrationEntry>;
+        using MapClassServices = std::unordered_map<std::string, ClassServices>;
+        using MapBundleServices = std::unordered_map<BundlePrivate*, ServiceRegistrationList>;
+
+        using ServiceRegistrationsConstPtr = std::shared_ptr<std::vector<ServiceRegistrationBase> const>;
+
+        /**
+         * The registered services of a class in a snapshot. A null registrations
+         * pointer marks a class whose registrations changed since the entry
+         * was last built. The pointer is accessed with std::atomic_load and
+         * std::atomic_store.
+         */
+        struct ClassServicesSnapshotEntry
+        {
+            mutable ServiceRegistrationsConstPtr registrations;
+        };
+        using MapClassServicesSnapshot
+            = std::unordered_map<std::string, std::shared_ptr<ClassServicesSnapshotEntry const>>;
 
         /**
          * All registered services in the current framework.
@@ -69,7 +120,10 @@ namespace cppmicroservices
          */
         MapServiceClasses services;
 
-        std::vector<ServiceRegistrationBase> serviceRegistrations;
+        /**
+         * All registered services, in registration order.
+         */
+        ServiceRegistrationList serviceRegistrations;
 
         /**
          * Mapping of classname to registered service.
@@ -83,6 +137,11 @@ namespace cppmicroservices
          */
         MapBundleServices bundleServices;
 
+        /**
+         * The registration order of the next registered service.
+         */
+        uint64_t nextRegistrationOrder = 0;
+
         CoreBundleContext* core;
 
         ServiceRegistry(ServiceRegistry const&) = delete;
@@ -121,6 +180,9 @@ namespace cppmicroservices
          * Get all services implementing a certain class.
          * Only used internally by the framework.
          *
+         * This reads the most recently published snapshot and does
+         * not block on concurrent registry updates.
+         *
          * @param clazz The class name of the requested service.
          * @return A sorted list of {@link ServiceRegistrationPrivate} objects.
          */
@@ -129,6 +191,9 @@ namespace cppmicroservices
         /**
          * Get a service implementing a certain class.
          *
+         * This reads the most recently published snapshot and does
+         * not block on concurrent registry updates.
+         *
          * @param bundle The bundle requesting reference
          * @param clazz The class name of the requested service.
          * @return A {@link ServiceReference} object.
@@ -139,6 +204,9 @@ namespace cppmicroservices
          * Get all services implementing a certain class and then
          * filter these with a property filter.
          *
+         * This reads the most recently published snapshot and does
+         * not block on concurrent registry updates.
+         *
          * @param clazz The class name of requested service.
          * @param filter The property filter.
          * @param bundle The bundle requesting reference.
@@ -168,16 +236,95 @@ namespace cppmicroservices
          * Get all services that a bundle uses.
          *
          * @param bundle The bundle
-         * @return A set of {@link ServiceRegistration} objects
+         * @return A set of {@link ServiceRegistration} objects, in registration order
          */
         void GetUsedByBundle(BundlePrivate* bundle, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+        /**
+         * Record that a bundle started using a service, i.e. it is now a
+         * dependent of the registration or holds a prototype scope instance
+         * of it. Called with the locks of the registration held.
+         */
+        void AddServiceUsage(BundlePrivate* bundle, ServiceRegistrationBase const& sr);
+
+        /**
+         * Record that a bundle no longer uses a service. Called with the
+         * locks of the registration held.
+         */
+        void RemoveServiceUsage(BundlePrivate* bundle, ServiceRegistrationBase const& sr);
+
       private:
         friend class ServiceHooks;
         friend class ServiceRegistrationBase;
 
+        /**
+         * Reverse index from a bundle to the services it uses, so that
+         * GetUsedByBundle does not need to visit every registration.
+         *
+         * It is updated while the registration locks are held and has its own
+         * lock, which must not be held while acquiring any other lock.
+         */
+        struct ServiceUsage : detail::MultiThreaded<>
+        {
+            std::unordered_map<BundlePrivate*, std::unordered_set<ServiceRegistrationBase>> usedByBundle;
+        };
+        ServiceUsage serviceUsage;
+
+        /**
+         * Read-only copies of classServices and serviceRegistrations.
+         *
+         * Writers modify the containers above while holding the registry lock
+         * and then publish the change. Lookups load the current snapshot with
+         * std::atomic_load. The class map is only copied when a class gets its
+         * first service or loses its last one; its entries are shared between
+         * snapshots. Any other change only invalidates the entry of the class,
+         * which is rebuilt, with the registry lock held, by the first lookup of
+         * the class. A burst of changes to one class, e.g. a bundle stop, thus
+         * copies neither the class map nor the class vector each time, and
+         * lookups of unchanged classes never take the lock.
+         */
+        std::shared_ptr<MapClassServicesSnapshot const> classServicesSnapshot;
+
+        /**
+         * Only lookups without a class name or an objectclass filter need the
+         * list of all registrations, so it is rebuilt lazily after a change
+         * instead of on every registration.
+         */
+        mutable ServiceRegistrationsConstPtr serviceRegistrationsSnapshot;
+
+        /**
+         * Secondary index over the service properties listed in the
+         * Constants::FRAMEWORK_SERVICE_INDEXED_PROPERTIES launch property.
+         */
+        ServicePropertyIndex propertyIndex;
+
         void RemoveServiceRegistration_unlocked(ServiceRegistrationBase const& sr);
 
+        /**
+         * Re-index a registration after its properties were modified.
+         */
+        void UpdateIndexedProperties(ServiceRegistrationBase const& sr);
+
+        /**
+         * Publish the current state of the given classes to the class services
+         * snapshot. Must be called with the registry lock held.
+         *
+         * @param classes The classes whose registrations changed.
+         * @param registrationsChanged Whether registrations were added or removed.
+         */
+        void PublishSnapshot_unlocked(std::vector<std::string> const& classes, bool registrationsChanged);
+
+        ServiceRegistrationsConstPtr GetServiceRegistrationsSnapshot() const;
+
+        /**
+         * Get the registrations of a class from a snapshot, rebuilding the
+         * entry if it was invalidated.
+         *
+         * @return The registrations, or nullptr if the snapshot has no entry for the class.
+         */
+        ServiceRegistrationsConstPtr GetClassServices(MapClassServicesSnapshot const& snapshot,
+                                                      std::string const& clazz) const;
+
         void Get_unlocked(std::string const& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
         void Get_unlocked(std::string const& clazz,
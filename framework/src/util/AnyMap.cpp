@@ -22,8 +22,11 @@
 
 #include "cppmicroservices/AnyMap.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 namespace cppmicroservices
@@ -35,9 +38,15 @@ namespace cppmicroservices
         std::size_t
         any_map_cihash::operator()(std::string const& key) const
         {
-            std::string lcase = key;
-            std::transform(lcase.begin(), lcase.end(), lcase.begin(), ::tolower);
-            return std::hash<std::string> {}(lcase);
+            // FNV-1a over the lower-cased characters. Unlike hashing a lower-cased
+            // copy of the key, this does not allocate.
+            std::uint64_t hash = 14695981039346656037ULL;
+            for (char c : key)
+            {
+                hash ^= static_cast<std::uint64_t>(::tolower(static_cast<unsigned char>(c)));
+                hash *= 1099511628211ULL;
+            }
+            return static_cast<std::size_t>(hash);
         }
 
         bool
@@ -48,6 +57,265 @@ namespace cppmicroservices
                 && std::equal(l.begin(), l.end(), r.begin(), [](char a, char b) { return tolower(a) == tolower(b); }));
         }
 
+        namespace
+        {
+            inline int
+            ascii_tolower(unsigned char c)
+            {
+                return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+            }
+
+            // Orders keys case-insensitively, and keys which are equal ignoring case
+            // case-sensitively. Returns a value < 0, 0 or > 0.
+            int
+            flat_key_compare(std::string const& l, std::string const& r, bool matchCase = true)
+            {
+                auto const n = std::min(l.size(), r.size());
+                int caseOrder = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    auto const lc = static_cast<unsigned char>(l[i]);
+                    auto const rc = static_cast<unsigned char>(r[i]);
+                    if (lc == rc)
+                    {
+                        continue;
+                    }
+                    if (int const diff = ascii_tolower(lc) - ascii_tolower(rc); diff != 0)
+                    {
+                        return diff;
+                    }
+                    if (caseOrder == 0)
+                    {
+                        caseOrder = lc < rc ? -1 : 1;
+                    }
+                }
+                if (l.size() != r.size())
+                {
+                    return l.size() < r.size() ? -1 : 1;
+                }
+                return matchCase ? caseOrder : 0;
+            }
+
+            // FNV-1a over the lower-cased characters, equal for keys which only differ in case.
+            std::size_t
+            flat_key_hash(std::string const& key) noexcept
+            {
+                std::uint64_t hash = 14695981039346656037ULL;
+                for (char c : key)
+                {
+                    hash ^= static_cast<std::uint64_t>(ascii_tolower(static_cast<unsigned char>(c)));
+                    hash *= 1099511628211ULL;
+                }
+                return static_cast<std::size_t>(hash);
+            }
+        } // namespace
+
+        void
+        flat_any_map::clear() noexcept
+        {
+            entries.clear();
+            sorted.clear();
+        }
+
+        void
+        flat_any_map::reserve(size_type count)
+        {
+            entries.reserve(count);
+            sorted.reserve(count);
+        }
+
+        flat_any_map::index_type::const_iterator
+        flat_any_map::lower_bound(std::size_t hash, key_type const& key, bool matchCase) const
+        {
+            return std::lower_bound(sorted.begin(),
+                                    sorted.end(),
+                                    key,
+                                    [this, hash, matchCase](index_entry const& e, key_type const& k)
+                                    {
+                                        if (e.hash != hash)
+                                        {
+                                            return e.hash < hash;
+                                        }
+                                        return flat_key_compare(entries[e.pos].first, k, matchCase) < 0;
+                                    });
+        }
+
+        flat_any_map::iterator
+        flat_any_map::find(key_type const& key)
+        {
+            auto const& self = *this;
+            return begin() + (self.find(key) - self.begin());
+        }
+
+        flat_any_map::const_iterator
+        flat_any_map::find(key_type const& key) const
+        {
+            if (entries.size() <= linear_search_limit)
+            {
+                return std::find_if(begin(), end(), [&key](value_type const& e) { return e.first == key; });
+            }
+            return find(key, flat_key_hash(key), true);
+        }
+
+        flat_any_map::const_iterator
+        flat_any_map::find_ci(key_type const& key) const
+        {
+            if (entries.size() <= linear_search_limit)
+            {
+                return std::find_if(begin(),
+                                    end(),
+                                    [&key](value_type const& e)
+                                    {
+                                        return e.first.size() == key.size()
+                                               && flat_key_compare(e.first, key, false) == 0;
+                                    });
+            }
+            return find(key, flat_key_hash(key), false);
+        }
+
+        std::size_t
+        flat_any_map::hash_key(key_type const& key) noexcept
+        {
+            return flat_key_hash(key);
+        }
+
+        flat_any_map::const_iterator
+        flat_any_map::find(key_type const& key, std::size_t hash) const
+        {
+            return find(key, hash, true);
+        }
+
+        flat_any_map::const_iterator
+        flat_any_map::find_ci(key_type const& key, std::size_t hash) const
+        {
+            return find(key, hash, false);
+        }
+
+        flat_any_map::const_iterator
+        flat_any_map::find(key_type const& key, std::size_t hash, bool matchCase) const
+        {
+            auto matches = [this, &key, hash, matchCase](index_entry const& e)
+            {
+                return e.hash == hash
+                       && (matchCase ? entries[e.pos].first == key
+                                     : flat_key_compare(entries[e.pos].first, key, false) == 0);
+            };
+
+            if (sorted.size() <= linear_search_limit)
+            {
+                // the index is contiguous, so scanning it for the hash is cheap
+                auto it = std::find_if(sorted.begin(), sorted.end(), matches);
+                return it != sorted.end() ? begin() + it->pos : end();
+            }
+
+            auto it = lower_bound(hash, key, matchCase);
+            return it != sorted.end() && matches(*it) ? begin() + it->pos : end();
+        }
+
+        bool
+        flat_any_map::has_case_variants() const
+        {
+            for (std::size_t i = 1; i < sorted.size(); ++i)
+            {
+                if (sorted[i - 1].hash == sorted[i].hash
+                    && flat_key_compare(entries[sorted[i - 1].pos].first, entries[sorted[i].pos].first, false) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::pair<flat_any_map::iterator, bool>
+        flat_any_map::index_last()
+        {
+            auto const last = static_cast<uint32_t>(entries.size() - 1);
+            auto const& key = entries.back().first;
+            auto const hash = flat_key_hash(key);
+            auto it = lower_bound(hash, key, true);
+            if (it != sorted.end() && it->hash == hash && entries[it->pos].first == key)
+            {
+                entries.pop_back();
+                return { begin() + it->pos, false };
+            }
+
+            try
+            {
+                if (entries.size() > std::numeric_limits<uint32_t>::max())
+                {
+                    throw std::length_error("flat_any_map too large");
+                }
+                sorted.insert(it, index_entry { hash, last });
+            }
+            catch (...)
+            {
+                entries.pop_back();
+                throw;
+            }
+            return { begin() + last, true };
+        }
+
+        flat_any_map::size_type
+        flat_any_map::erase(key_type const& key)
+        {
+            auto const hash = flat_key_hash(key);
+            auto it = lower_bound(hash, key, true);
+            if (it == sorted.end() || it->hash != hash || entries[it->pos].first != key)
+            {
+                return 0;
+            }
+
+            auto const pos = it->pos;
+            if (pos + 1 != entries.size())
+            {
+                // The keys are const, so the remaining entries cannot be shifted in place.
+                std::vector<value_type> remaining;
+                remaining.reserve(entries.capacity());
+                for (std::size_t i = 0; i < entries.size(); ++i)
+                {
+                    if (i != pos)
+                    {
+                        remaining.emplace_back(std::move(entries[i]));
+                    }
+                }
+                entries.swap(remaining);
+            }
+            else
+            {
+                entries.pop_back();
+            }
+
+            sorted.erase(it);
+            for (auto& e : sorted)
+            {
+                if (e.pos > pos)
+                {
+                    --e.pos;
+                }
+            }
+            return 1;
+        }
+
+        bool
+        flat_any_map::operator==(flat_any_map const& rhs) const
+        {
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            // both indices are sorted by key, so equal maps have equal keys at equal positions
+            for (std::size_t i = 0; i < sorted.size(); ++i)
+            {
+                auto const& l = entries[sorted[i].pos];
+                auto const& r = rhs.entries[rhs.sorted[i].pos];
+                if (l.first != r.first || !(l.second == r.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         Any const& AtCompoundKey(std::vector<Any> const& v, std::string_view const& key);
 
         Any const&
@@ -194,6 +462,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uocciiter(it.uoci_it());
                 break;
+            case FLAT:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -214,6 +485,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uocciiter(it.uoci_it());
                 break;
+            case FLAT:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -234,6 +508,8 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 delete it.uoci;
                 break;
+            case FLAT:
+                break;
             case NONE:
                 break;
         }
@@ -256,6 +532,8 @@ namespace cppmicroservices
         }
     }
 
+    any_map::const_iter::const_iter(fciter it) : iterator_base(FLAT) { this->it.f = it; }
+
     any_map::const_iter&
     any_map::const_iter::operator=(any_map::const_iter const& x)
     {
@@ -270,6 +548,8 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 delete it.uoci;
                 break;
+            case FLAT:
+                break;
             case NONE:
                 break;
         }
@@ -286,6 +566,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uocciiter(x.uoci_it());
                 break;
+            case FLAT:
+                this->it.f = x.it.f;
+                break;
             case NONE:
                 this->it = {nullptr};
                 break;
@@ -306,6 +589,8 @@ namespace cppmicroservices
                 return *uo_it();
             case UNORDERED_CI:
                 return *uoci_it();
+            case FLAT:
+                return *it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -324,6 +609,8 @@ namespace cppmicroservices
                 return uo_it().operator->();
             case UNORDERED_CI:
                 return uoci_it().operator->();
+            case FLAT:
+                return it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -345,6 +632,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 ++uoci_it();
                 break;
+            case FLAT:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -369,6 +659,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 uoci_it()++;
                 break;
+            case FLAT:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -392,6 +685,8 @@ namespace cppmicroservices
                 return uo_it() == x.uo_it();
             case UNORDERED_CI:
                 return uoci_it() == x.uoci_it();
+            case FLAT:
+                return it.f == x.it.f;
             case NONE:
                 return true;
             default:
@@ -459,6 +754,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 this->it.uoci = new uociiter(it.uoci_it());
                 break;
+            case FLAT:
+                this->it.f = it.it.f;
+                break;
             case NONE:
                 break;
             default:
@@ -479,6 +777,8 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 delete it.uoci;
                 break;
+            case FLAT:
+                break;
             case NONE:
                 break;
         }
@@ -501,6 +801,8 @@ namespace cppmicroservices
         }
     }
 
+    any_map::iter::iter(fiter it) : iterator_base(FLAT) { this->it.f = it; }
+
     any_map::iter::reference
     any_map::iter::operator*() const
     {
@@ -512,6 +814,8 @@ namespace cppmicroservices
                 return *uo_it();
             case UNORDERED_CI:
                 return *uoci_it();
+            case FLAT:
+                return *it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -530,6 +834,8 @@ namespace cppmicroservices
                 return uo_it().operator->();
             case UNORDERED_CI:
                 return uoci_it().operator->();
+            case FLAT:
+                return it.f;
             case NONE:
                 throw std::logic_error("cannot dereference an invalid iterator");
             default:
@@ -551,6 +857,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 ++uoci_it();
                 break;
+            case FLAT:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -575,6 +884,9 @@ namespace cppmicroservices
             case UNORDERED_CI:
                 uoci_it()++;
                 break;
+            case FLAT:
+                ++it.f;
+                break;
             case NONE:
                 throw std::logic_error("cannot increment an invalid iterator");
             default:
@@ -594,6 +906,8 @@ namespace cppmicroservices
                 return uo_it() == x.uo_it();
             case UNORDERED_CI:
                 return uoci_it() == x.uoci_it();
+            case FLAT:
+                return it.f == x.it.f;
             case NONE:
                 return x.type == NONE;
             default:
@@ -659,6 +973,14 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 map.uoci = new unordered_any_cimap(l);
                 break;
+            case map_type::FLAT_MAP:
+                map.f = new flat_any_map();
+                map.f->reserve(l.size());
+                for (auto const& value : l)
+                {
+                    map.f->emplace(value);
+                }
+                break;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -685,6 +1007,10 @@ namespace cppmicroservices
         map.uoci = new unordered_any_cimap(std::move(m));
     }
 
+    any_map::any_map(flat_any_map const& m) : type(map_type::FLAT_MAP) { map.f = new flat_any_map(m); }
+
+    any_map::any_map(flat_any_map&& m) : type(map_type::FLAT_MAP) { map.f = new flat_any_map(std::move(m)); }
+
     any_map::any_map(any_map const& m) : type(m.type) { copy_from(m); }
 
     any_map&
@@ -725,6 +1051,8 @@ namespace cppmicroservices
                 return { uo_m().begin(), iter::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().begin(), iter::UNORDERED_CI };
+            case map_type::FLAT_MAP:
+                return { f_m().begin() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -741,6 +1069,8 @@ namespace cppmicroservices
                 return { uo_m().begin(), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().begin(), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP:
+                return { f_m().begin() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -763,6 +1093,8 @@ namespace cppmicroservices
                 return { uo_m().end(), iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().end(), iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP:
+                return { f_m().end() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -779,6 +1111,8 @@ namespace cppmicroservices
                 return { uo_m().end(), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().end(), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP:
+                return { f_m().end() };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -801,6 +1135,8 @@ namespace cppmicroservices
                 return uo_m().empty();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().empty();
+            case map_type::FLAT_MAP:
+                return f_m().empty();
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -817,6 +1153,8 @@ namespace cppmicroservices
                 return uo_m().size();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().size();
+            case map_type::FLAT_MAP:
+                return f_m().size();
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -833,6 +1171,8 @@ namespace cppmicroservices
                 return uo_m().count(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().count(key);
+            case map_type::FLAT_MAP:
+                return f_m().find(key) != f_m().end() ? 1 : 0;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -849,6 +1189,26 @@ namespace cppmicroservices
                 return uo_m().clear();
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().clear();
+            case map_type::FLAT_MAP:
+                return f_m().clear();
+            default:
+                throw std::logic_error("invalid map type");
+        }
+    }
+
+    void
+    any_map::reserve(size_type count)
+    {
+        switch (type)
+        {
+            case map_type::ORDERED_MAP:
+                return;
+            case map_type::UNORDERED_MAP:
+                return uo_m().reserve(count);
+            case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
+                return uoci_m().reserve(count);
+            case map_type::FLAT_MAP:
+                return f_m().reserve(count);
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -865,6 +1225,15 @@ namespace cppmicroservices
                 return uo_m().at(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().at(key);
+            case map_type::FLAT_MAP:
+            {
+                auto it = f_m().find(key);
+                if (it == f_m().end())
+                {
+                    throw std::out_of_range("key not found in any_map");
+                }
+                return it->second;
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -881,6 +1250,15 @@ namespace cppmicroservices
                 return uo_m().at(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().at(key);
+            case map_type::FLAT_MAP:
+            {
+                auto it = f_m().find(key);
+                if (it == f_m().end())
+                {
+                    throw std::out_of_range("key not found in any_map");
+                }
+                return it->second;
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -897,6 +1275,8 @@ namespace cppmicroservices
                 return uo_m()[key];
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m()[key];
+            case map_type::FLAT_MAP:
+                return f_m().emplace(key, Any()).first->second;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -913,6 +1293,8 @@ namespace cppmicroservices
                 return uo_m()[std::move(key)];
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m()[std::move(key)];
+            case map_type::FLAT_MAP:
+                return f_m().emplace(std::move(key), Any()).first->second;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -938,6 +1320,11 @@ namespace cppmicroservices
                 auto p = uoci_m().insert(value);
                 return { iterator(std::move(p.first), iterator::UNORDERED_CI), p.second };
             }
+            case map_type::FLAT_MAP:
+            {
+                auto p = f_m().emplace(value);
+                return { iterator(p.first), p.second };
+            }
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -954,6 +1341,8 @@ namespace cppmicroservices
                 return { uo_m().find(key), const_iterator::UNORDERED };
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return { uoci_m().find(key), const_iterator::UNORDERED_CI };
+            case map_type::FLAT_MAP:
+                return { f_m().find(key) };
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -1040,6 +1429,15 @@ namespace cppmicroservices
         return map.uoci->find(key);
     }
 
+    any_map::flat_any_map const&
+    any_map::f_m_TypeChecked() const
+    {
+        assert(type == FLAT_MAP
+               && "You are calling f_m_TypeChecked() on map "
+                  "whose type is not FLAT_MAP.");
+        return *map.f;
+    }
+
     any_map::size_type
     any_map::erase(key_type const& key)
     {
@@ -1051,6 +1449,8 @@ namespace cppmicroservices
                 return uo_m().erase(key);
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 return uoci_m().erase(key);
+            case map_type::FLAT_MAP:
+                return f_m().erase(key);
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -1092,6 +1492,18 @@ namespace cppmicroservices
         return *map.uoci;
     }
 
+    any_map::flat_any_map const&
+    any_map::f_m() const
+    {
+        return *map.f;
+    }
+
+    any_map::flat_any_map&
+    any_map::f_m()
+    {
+        return *map.f;
+    }
+
     void
     any_map::copy_from(any_map const& other)
     {
@@ -1106,6 +1518,9 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 map.uoci = new unordered_any_cimap(other.uoci_m());
                 break;
+            case map_type::FLAT_MAP:
+                map.f = new flat_any_map(other.f_m());
+                break;
             default:
                 throw std::logic_error("invalid map type");
         }
@@ -1128,6 +1543,10 @@ namespace cppmicroservices
                 map.uoci = other.map.uoci;
                 other.map.uoci = nullptr;
                 break;
+            case map_type::FLAT_MAP:
+                map.f = other.map.f;
+                other.map.f = nullptr;
+                break;
         }
     }
 
@@ -1145,6 +1564,9 @@ namespace cppmicroservices
             case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 delete map.uoci;
                 break;
+            case map_type::FLAT_MAP:
+                delete map.f;
+                break;
         }
     }
 
@@ -1169,6 +1591,10 @@ namespace cppmicroservices
 
     AnyMap::AnyMap(unordered_any_cimap&& m) : any_map(std::move(m)) {}
 
+    AnyMap::AnyMap(flat_any_map const& m) : any_map(m) {}
+
+    AnyMap::AnyMap(flat_any_map&& m) : any_map(std::move(m)) {}
+
     AnyMap::map_type
     AnyMap::GetType() const
     {
@@ -1257,6 +1683,9 @@ namespace cppmicroservices
             case cppmicroservices::any_map::map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                 typeStr = "UNORDERED_MAP_CASEINSENSITIVE_KEYS";
                 break;
+            case cppmicroservices::any_map::map_type::FLAT_MAP:
+                typeStr = "FLAT_MAP";
+                break;
         }
         os << "AnyMap { " << typeStr << ", {";
         if (m.empty())
@@ -1296,6 +1725,8 @@ namespace cppmicroservices
                     return (*map.uo == *rhs.map.uo);
                 case map_type::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
                     return (*map.uoci == *rhs.map.uoci);
+                case map_type::FLAT_MAP:
+                    return (*map.f == *rhs.map.f);
             }
         }
         return false;
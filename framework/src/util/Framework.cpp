@@ -73,4 +73,31 @@ namespace cppmicroservices
     {
         return pimpl(d)->WaitForStop(timeout);
     }
+
+    void
+    Framework::StartBundles(std::vector<Bundle> const& bundles, uint32_t options)
+    {
+        std::vector<std::shared_ptr<BundlePrivate>> privates;
+        for (auto const& b : bundles)
+        {
+            if (!b)
+            {
+                throw std::invalid_argument("invalid bundle");
+            }
+            privates.push_back(GetPrivate(b));
+        }
+        pimpl(d)->StartBundles(privates, options);
+    }
+
+    uint32_t
+    Framework::GetStartLevel() const
+    {
+        return pimpl(d)->GetActiveStartLevel();
+    }
+
+    void
+    Framework::SetStartLevel(uint32_t startLevel)
+    {
+        pimpl(d)->SetStartLevel(startLevel);
+    }
 } // namespace cppmicroservices
@@ -108,6 +108,8 @@ namespace cppmicroservices
                 return os << "STARTED";
             case FrameworkEvent::Type::FRAMEWORK_ERROR:
                 return os << "ERROR";
+            case FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED:
+                return os << "STARTLEVEL_CHANGED";
             case FrameworkEvent::Type::FRAMEWORK_WARNING:
                 return os << "WARNING";
             case FrameworkEvent::Type::FRAMEWORK_INFO:
@@ -23,19 +23,95 @@ limitations under the License.
 #include "FrameworkPrivate.h"
 
 #include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 
+#include "BundleActivationScheduler.h"
 #include "BundleContextPrivate.h"
 #include "BundleStorage.h"
 
+#include <algorithm>
 #include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 namespace cppmicroservices
 {
 
+    namespace
+    {
+
+        /*
+          Returns the number of threads to start and stop the bundles with, or 0
+          if the FRAMEWORK_BUNDLE_ACTIVATION_THREADS property is not set.
+        */
+        unsigned int
+        GetBundleActivationThreads(CoreBundleContext const* coreCtx)
+        {
+            auto prop = coreCtx->frameworkProperties.find(Constants::FRAMEWORK_BUNDLE_ACTIVATION_THREADS);
+            if (prop == coreCtx->frameworkProperties.end() || prop->second.Type() != typeid(int))
+            {
+                return 0;
+            }
+            auto const numThreads = ref_any_cast<int>(prop->second);
+            if (numThreads < 1)
+            {
+                return std::max(std::thread::hardware_concurrency(), 1u);
+            }
+            return static_cast<unsigned int>(numThreads);
+        }
+
+        /*
+          Returns the value of the FRAMEWORK_BEGINNING_STARTLEVEL property, or 1
+          if it is not set or not a positive int.
+        */
+        uint32_t
+        GetBeginningStartLevel(CoreBundleContext const* coreCtx)
+        {
+            auto prop = coreCtx->frameworkProperties.find(Constants::FRAMEWORK_BEGINNING_STARTLEVEL);
+            if (prop == coreCtx->frameworkProperties.end() || prop->second.Type() != typeid(int)
+                || ref_any_cast<int>(prop->second) < 1)
+            {
+                return 1;
+            }
+            return static_cast<uint32_t>(ref_any_cast<int>(prop->second));
+        }
+
+        /*
+          Calls fn with each group of bundles sharing a start level, in ascending
+          or descending start level order. The order of the bundles within a group
+          is kept.
+        */
+        template <typename Fn>
+        void
+        ForEachStartLevel(std::vector<std::shared_ptr<BundlePrivate>> bundles, bool ascending, Fn fn)
+        {
+            std::stable_sort(bundles.begin(),
+                             bundles.end(),
+                             [ascending](std::shared_ptr<BundlePrivate> const& a, std::shared_ptr<BundlePrivate> const& b)
+                             { return ascending ? a->startLevel < b->startLevel : a->startLevel > b->startLevel; });
+            auto first = bundles.begin();
+            while (first != bundles.end())
+            {
+                auto const level = (*first)->startLevel;
+                auto last = std::find_if(first,
+                                         bundles.end(),
+                                         [level](std::shared_ptr<BundlePrivate> const& b)
+                                         { return b->startLevel != level; });
+                fn(std::vector<std::shared_ptr<BundlePrivate>>(first, last));
+                first = last;
+            }
+        }
+
+    } // namespace
+
     FrameworkPrivate::FrameworkPrivate(CoreBundleContext* fwCtx)
         : BundlePrivate(fwCtx)
+        , activeStartLevel(0)
+        , requestedStartLevel(0)
+        , startLevelChanging(false)
         , headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
     {
         headers[Constants::BUNDLE_SYMBOLICNAME] = symbolicName;
@@ -53,6 +129,10 @@ namespace cppmicroservices
 
     FrameworkPrivate::~FrameworkPrivate() noexcept
     {
+        if (startLevelThread.joinable())
+        {
+            startLevelThread.join();
+        }
         if (shutdownThread.joinable())
         {
             shutdownThread.join();
@@ -63,6 +143,7 @@ namespace cppmicroservices
     FrameworkPrivate::DoInit()
     {
         state = Bundle::STATE_STARTING;
+        activeStartLevel = requestedStartLevel = GetBeginningStartLevel(coreCtx);
         coreCtx->Init();
     }
 
@@ -237,10 +318,46 @@ namespace cppmicroservices
             bundlesToStart = coreCtx->storage->GetStartOnLaunchBundles();
         }
 
-        // Start bundles according to their autostart setting.
+        // Start bundles according to their autostart setting, one start level at a time.
+        std::vector<std::shared_ptr<BundlePrivate>> bundles;
         for (auto i : bundlesToStart)
         {
             auto b = coreCtx->bundleRegistry.GetBundle(i);
+            if (b->startLevel <= activeStartLevel)
+            {
+                bundles.push_back(std::move(b));
+            }
+        }
+        ForEachStartLevel(std::move(bundles),
+                          true,
+                          [this](std::vector<std::shared_ptr<BundlePrivate>> const& levelBundles)
+                          { ActivateBundles(levelBundles); });
+
+        {
+            auto l = Lock();
+            US_UNUSED(l);
+
+            if (state == Bundle::STATE_ACTIVE)
+            {
+                return;
+            }
+
+            state = Bundle::STATE_ACTIVE;
+            operation = BundlePrivate::OP_IDLE;
+        }
+
+        coreCtx->listeners.SendFrameworkEvent(
+            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTED, MakeBundle(shared_from_this()), std::string()));
+
+        // Apply a start level requested while the framework was starting
+        BeginStartLevelChange();
+    }
+
+    void
+    FrameworkPrivate::ActivateBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles)
+    {
+        auto startBundle = [this](std::shared_ptr<BundlePrivate> const& b)
+        {
             try
             {
                 int32_t const autostartSetting = b->barchive->GetAutostartSetting();
@@ -260,23 +377,208 @@ namespace cppmicroservices
                                                                      std::string(),
                                                                      std::current_exception()));
             }
+        };
+
+        if (auto const numThreads = GetBundleActivationThreads(coreCtx))
+        {
+            BundleActivationScheduler(coreCtx, numThreads).Start(bundles, startBundle);
+        }
+        else
+        {
+            for (auto const& b : bundles)
+            {
+                startBundle(b);
+            }
+        }
+    }
+
+    void
+    FrameworkPrivate::DeactivateBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles)
+    {
+        auto stopBundle = [this](std::shared_ptr<BundlePrivate> const& b)
+        {
+            try
+            {
+                if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0)
+                {
+                    // Stop bundle without changing its autostart setting.
+                    b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
+                }
+            }
+            catch (...)
+            {
+                coreCtx->listeners.SendFrameworkEvent(
+                    FrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
+                                                  MakeBundle(b),
+                                                  std::string(),
+                                                  std::current_exception())));
+            }
+        };
+
+        if (auto const numThreads = GetBundleActivationThreads(coreCtx))
+        {
+            BundleActivationScheduler(coreCtx, numThreads).Stop(bundles, stopBundle);
+        }
+        else
+        {
+            for (auto const& b : bundles)
+            {
+                stopBundle(b);
+            }
         }
+    }
 
+    uint32_t
+    FrameworkPrivate::GetActiveStartLevel() const
+    {
+        return activeStartLevel;
+    }
+
+    void
+    FrameworkPrivate::SetStartLevel(uint32_t startLevel)
+    {
+        if (startLevel == 0)
+        {
+            throw std::invalid_argument("The start level must be greater than zero");
+        }
         {
             auto l = Lock();
             US_UNUSED(l);
+            if (((Bundle::STATE_STARTING | Bundle::STATE_ACTIVE) & state) == 0)
+            {
+                throw std::logic_error("The start level of a framework which is not started cannot be changed");
+            }
+            requestedStartLevel = startLevel;
+        }
+        BeginStartLevelChange();
+    }
 
-            if (state == Bundle::STATE_ACTIVE)
+    void
+    FrameworkPrivate::BeginStartLevelChange()
+    {
+        {
+            auto l = Lock();
+            US_UNUSED(l);
+            if (state != Bundle::STATE_ACTIVE || startLevelChanging || requestedStartLevel == activeStartLevel)
             {
                 return;
             }
+            startLevelChanging = true;
+#ifdef US_ENABLE_THREADING_SUPPORT
+            // A previous change has already finished if startLevelChanging was false
+            if (startLevelThread.joinable())
+            {
+                startLevelThread.join();
+            }
+            startLevelThread = std::thread(&FrameworkPrivate::ChangeStartLevel, this);
+            return;
+#endif
+        }
+        ChangeStartLevel();
+    }
 
-            state = Bundle::STATE_ACTIVE;
-            operation = BundlePrivate::OP_IDLE;
+    void
+    FrameworkPrivate::ChangeStartLevel()
+    {
+        for (;;)
+        {
+            bool raise = false;
+            uint32_t level = 0;
+            {
+                auto l = Lock();
+                US_UNUSED(l);
+                if (state != Bundle::STATE_ACTIVE || requestedStartLevel == activeStartLevel)
+                {
+                    startLevelChanging = false;
+                    return;
+                }
+                raise = requestedStartLevel > activeStartLevel;
+                // When raising, the new level becomes active before its bundles are started.
+                // When lowering, the bundles of the current level are stopped first.
+                level = activeStartLevel;
+                if (raise)
+                {
+                    activeStartLevel = ++level;
+                }
+            }
+
+            std::vector<std::shared_ptr<BundlePrivate>> bundles;
+            if (raise)
+            {
+                for (auto& b : coreCtx->bundleRegistry.GetBundles())
+                {
+                    if (b->startLevel == level && b->GetAutostartSetting() != -1)
+                    {
+                        bundles.push_back(std::move(b));
+                    }
+                }
+                std::sort(bundles.begin(),
+                          bundles.end(),
+                          [](std::shared_ptr<BundlePrivate> const& a, std::shared_ptr<BundlePrivate> const& b)
+                          { return a->id < b->id; });
+                ActivateBundles(bundles);
+            }
+            else
+            {
+                for (auto& b : coreCtx->bundleRegistry.GetActiveBundles())
+                {
+                    if (b->startLevel == level)
+                    {
+                        bundles.push_back(std::move(b));
+                    }
+                }
+                std::sort(bundles.begin(),
+                          bundles.end(),
+                          [](std::shared_ptr<BundlePrivate> const& a, std::shared_ptr<BundlePrivate> const& b)
+                          { return a->id > b->id; });
+                DeactivateBundles(bundles);
+                activeStartLevel = --level;
+            }
+
+            coreCtx->listeners.SendFrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTLEVEL_CHANGED,
+                                                                 MakeBundle(shared_from_this()),
+                                                                 "Start level " + std::to_string(level)));
         }
+    }
 
-        coreCtx->listeners.SendFrameworkEvent(
-            FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_STARTED, MakeBundle(shared_from_this()), std::string()));
+    void
+    FrameworkPrivate::StartBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles, uint32_t options)
+    {
+        std::unordered_map<BundlePrivate const*, std::exception_ptr> failures;
+        std::mutex failuresMutex;
+        auto startBundle = [options, &failures, &failuresMutex](std::shared_ptr<BundlePrivate> const& b)
+        {
+            try
+            {
+                b->Start(options);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(failuresMutex);
+                failures.emplace(b.get(), std::current_exception());
+            }
+        };
+
+        if (auto const numThreads = GetBundleActivationThreads(coreCtx))
+        {
+            BundleActivationScheduler(coreCtx, numThreads).Start(bundles, startBundle);
+        }
+        else
+        {
+            for (auto const& b : bundles)
+            {
+                startBundle(b);
+            }
+        }
+
+        for (auto const& b : bundles)
+        {
+            auto failure = failures.find(b.get());
+            if (failure != failures.end())
+            {
+                std::rethrow_exception(failure->second);
+            }
+        }
     }
 
     void
@@ -319,6 +621,12 @@ namespace cppmicroservices
             coreCtx->listeners.BundleChanged(
                 BundleEvent(BundleEvent::BUNDLE_STOPPING, MakeBundle(this->shared_from_this())));
 
+            // A start level change in progress ends after its current level
+            if (startLevelThread.joinable())
+            {
+                startLevelThread.join();
+            }
+
             coreCtx->SetFrameworkStoppedState(true);
 
             if (wasActive)
@@ -366,28 +674,13 @@ namespace cppmicroservices
     void
     FrameworkPrivate::StopAllBundles()
     {
-        // Stop all active bundles, in reverse bundle ID order
+        // Stop all active bundles, in descending start level and reverse bundle ID order
         auto activeBundles = coreCtx->bundleRegistry.GetActiveBundles();
-        for (auto iter = activeBundles.rbegin(); iter != activeBundles.rend(); ++iter)
-        {
-            auto b = *iter;
-            try
-            {
-                if (((Bundle::STATE_ACTIVE | Bundle::STATE_STARTING) & b->state) != 0)
-                {
-                    // Stop bundle without changing its autostart setting.
-                    b->Stop(Bundle::StopOptions::STOP_TRANSIENT);
-                }
-            }
-            catch (...)
-            {
-                coreCtx->listeners.SendFrameworkEvent(
-                    FrameworkEvent(FrameworkEvent(FrameworkEvent::Type::FRAMEWORK_ERROR,
-                                                  MakeBundle(b),
-                                                  std::string(),
-                                                  std::current_exception())));
-            }
-        }
+        std::reverse(activeBundles.begin(), activeBundles.end());
+        ForEachStartLevel(std::move(activeBundles),
+                          false,
+                          [this](std::vector<std::shared_ptr<BundlePrivate>> const& levelBundles)
+                          { DeactivateBundles(levelBundles); });
 
         auto allBundles = coreCtx->bundleRegistry.GetBundles();
 
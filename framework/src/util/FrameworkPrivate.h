@@ -28,8 +28,10 @@ limitations under the License.
 #include "BundlePrivate.h"
 #include "CoreBundleContext.h"
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace cppmicroservices
 {
@@ -61,6 +63,26 @@ namespace cppmicroservices
         void Start(uint32_t) override;
         void Stop(uint32_t) override;
 
+        /**
+         * Start the given bundles, concurrently if the framework property
+         * FRAMEWORK_BUNDLE_ACTIVATION_THREADS is set. All bundles are started
+         * before the first failure, in the order of bundles, is rethrown.
+         */
+        void StartBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles, uint32_t options);
+
+        /**
+         * The active start level of the framework. Bundles with a higher start
+         * level are not activated.
+         */
+        uint32_t GetActiveStartLevel() const;
+
+        /**
+         * Move the active start level towards startLevel, one level at a time, in
+         * a background thread. A FRAMEWORK_STARTLEVEL_CHANGED event is sent each
+         * time a level is reached.
+         */
+        void SetStartLevel(uint32_t startLevel);
+
         void Uninstall() override;
         std::string GetLocation() const override;
 
@@ -115,11 +137,45 @@ namespace cppmicroservices
         void SystemShuttingdownDone_unlocked(FrameworkEventInternal const& fe);
 
       private:
+        /**
+         * Start the given bundles according to their autostart setting, without
+         * changing it. Failures are reported as FRAMEWORK_ERROR events.
+         */
+        void ActivateBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles);
+
+        /**
+         * Stop the given active bundles without changing their autostart setting.
+         * Failures are reported as FRAMEWORK_ERROR events.
+         */
+        void DeactivateBundles(std::vector<std::shared_ptr<BundlePrivate>> const& bundles);
+
+        /**
+         * Start changing the active start level, unless it already equals the
+         * requested start level or a change is in progress.
+         */
+        void BeginStartLevelChange();
+
+        /**
+         * Step the active start level until it equals the requested start level.
+         */
+        void ChangeStartLevel();
+
         /**
          * The thread that performs shutdown of this framework instance.
          */
         std::thread shutdownThread;
 
+        /**
+         * The thread that performs start level changes of this framework instance.
+         */
+        std::thread startLevelThread;
+
+        std::atomic<uint32_t> activeStartLevel;
+
+        // Locked by "this"
+        uint32_t requestedStartLevel;
+        bool startLevelChanging;
+
         AnyMap headers;
     };
 } // namespace cppmicroservices
@@ -333,6 +333,22 @@ namespace cppmicroservices
         std::vector<LDAPExpr> m_args;
         std::string m_attrName;
         std::string m_attrValue;
+
+        // The hash under which flat property maps index m_attrName, so that
+        // evaluating the expression against them mostly compares hashes.
+        std::size_t m_attrHash = 0;
+
+        // The operand of a simple expression converted to the types it may be
+        // compared with. This is done once when the expression is created, and
+        // not for every property value it is evaluated against.
+        bool m_matchesAny = false;
+        bool m_hasLongValue = false;
+        long m_longValue = 0;
+        bool m_hasDoubleValue = false;
+        double m_doubleValue = 0;
+        bool m_matchesTrue = false;
+        bool m_matchesFalse = false;
+        std::string m_approxValue;
     };
 
     LDAPExpr::LDAPExpr() : d() {}
@@ -362,6 +378,38 @@ namespace cppmicroservices
     LDAPExpr::LDAPExpr(int op, std::string const& attrName, std::string const& attrValue)
         : d(std::make_shared<LDAPExprData>(op, attrName, attrValue))
     {
+        d->m_attrHash = any_map::flat_any_map::hash_key(attrName);
+        d->m_matchesAny = (op == EQ && attrValue == LDAPExprConstants::WILDCARD_STRING());
+
+        errno = 0;
+        char* endptr = nullptr;
+        long longInt = strtol(attrValue.c_str(), &endptr, 10);
+        d->m_hasLongValue = !((errno == ERANGE
+                               && (longInt == std::numeric_limits<long>::max()
+                                   || longInt == std::numeric_limits<long>::min()))
+                              || (errno != 0 && longInt == 0) || endptr == attrValue.c_str());
+        d->m_longValue = longInt;
+
+        errno = 0;
+        endptr = nullptr;
+        double doubleVal = strtod(attrValue.c_str(), &endptr);
+        d->m_hasDoubleValue
+            = !((errno == ERANGE && (doubleVal == 0 || doubleVal == HUGE_VAL || doubleVal == -HUGE_VAL))
+                || (errno != 0 && doubleVal == 0) || endptr == attrValue.c_str());
+        d->m_doubleValue = doubleVal;
+
+        // A boolean property matches if the operand is a case-insensitive prefix of its value.
+        static std::string const trueString = "true";
+        static std::string const falseString = "false";
+        d->m_matchesTrue = attrValue.size() <= trueString.size()
+                           && std::equal(attrValue.begin(), attrValue.end(), trueString.begin(), stricomp);
+        d->m_matchesFalse = attrValue.size() <= falseString.size()
+                            && std::equal(attrValue.begin(), attrValue.end(), falseString.begin(), stricomp);
+
+        if (op == APPROX)
+        {
+            d->m_approxValue = FixupString(attrValue);
+        }
     }
 
     LDAPExpr::LDAPExpr(LDAPExpr const&) = default;
@@ -459,6 +507,32 @@ namespace cppmicroservices
         return false;
     }
 
+    bool
+    LDAPExpr::GetMatchedAttributeValue(std::string const& attrName, std::string& value) const
+    {
+        if (d->m_operator == EQ)
+        {
+            if (d->m_attrName.length() == attrName.length()
+                && std::equal(d->m_attrName.begin(), d->m_attrName.end(), attrName.begin(), stricomp)
+                && d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos)
+            {
+                value = d->m_attrValue;
+                return true;
+            }
+        }
+        else if (d->m_operator == AND)
+        {
+            for (auto const& m_arg : d->m_args)
+            {
+                if (m_arg.GetMatchedAttributeValue(attrName, value))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     std::string
     LDAPExpr::ToLower(std::string const& str)
     {
@@ -521,7 +595,35 @@ namespace cppmicroservices
         AnyMap const* pPtr = &p;
         if ((d->m_operator & SIMPLE) != 0)
         {
-            if (pPtr->GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+            if (pPtr->GetType() == AnyMap::FLAT_MAP)
+            {
+                auto value_iter = find_attr_value_in_map<any_map::flat_any_map>(
+                    pPtr,
+                    d->m_attrName,
+                    [this, matchCase](AnyMap const* p, std::string const& key)
+                    {
+                        auto const& flat = p->f_m_TypeChecked();
+                        // The attribute name itself is looked up first, its hash is known.
+                        // Nested lookups use parts of it as keys.
+                        auto const hash
+                            = (&key == &d->m_attrName) ? d->m_attrHash : any_map::flat_any_map::hash_key(key);
+                        auto value_iter = flat.find(key, hash);
+                        if (!matchCase && value_iter == flat.end())
+                        {
+                            return flat.find_ci(key, hash);
+                        }
+                        return value_iter;
+                    },
+                    [](AnyMap const* p) { return p->f_m_TypeChecked().end(); });
+
+                if (value_iter)
+                {
+                    return Compare(value_iter.value()->second);
+                }
+
+                return false;
+            }
+            else if (pPtr->GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
             {
                 auto value_iter = find_attr_value_in_map<any_map::unordered_any_cimap>(
                     pPtr,
@@ -531,11 +633,11 @@ namespace cppmicroservices
 
                 if (!matchCase && value_iter)
                 {
-                    return Compare(value_iter.value()->second, d->m_operator, d->m_attrValue);
+                    return Compare(value_iter.value()->second);
                 }
                 else if (matchCase && value_iter && value_iter.value()->first == d->m_attrName)
                 {
-                    return Compare(value_iter.value()->second, d->m_operator, d->m_attrValue);
+                    return Compare(value_iter.value()->second);
                 }
                 else
                 {
@@ -552,11 +654,10 @@ namespace cppmicroservices
                         auto value_iter = p->findUO_TypeChecked(key);
                         if (!matchCase && value_iter == p->endUO_TypeChecked())
                         {
-                            std::string lower = LDAPExpr::ToLower(key);
                             for (auto value_iter = p->beginUO_TypeChecked(); value_iter != p->endUO_TypeChecked();
                                  ++value_iter)
                             {
-                                if (LDAPExpr::ToLower(value_iter->first) == lower)
+                                if (LDAPExpr::EqualsIgnoreCase(value_iter->first, key))
                                 {
                                     return value_iter;
                                 }
@@ -570,7 +671,7 @@ namespace cppmicroservices
 
                 if (value_iter)
                 {
-                    return Compare(value_iter.value()->second, d->m_operator, d->m_attrValue);
+                    return Compare(value_iter.value()->second);
                 }
 
                 return false;
@@ -585,11 +686,10 @@ namespace cppmicroservices
                         auto value_iter = p->findOM_TypeChecked(key);
                         if (!matchCase && value_iter == p->endOM_TypeChecked())
                         {
-                            std::string lower = LDAPExpr::ToLower(key);
                             for (auto value_iter = p->beginOM_TypeChecked(); value_iter != p->endOM_TypeChecked();
                                  ++value_iter)
                             {
-                                if (LDAPExpr::ToLower(value_iter->first) == lower)
+                                if (LDAPExpr::EqualsIgnoreCase(value_iter->first, key))
                                 {
                                     return value_iter;
                                 }
@@ -604,7 +704,7 @@ namespace cppmicroservices
 
                 if (value_iter)
                 {
-                    return Compare(value_iter.value()->second, d->m_operator, d->m_attrValue);
+                    return Compare(value_iter.value()->second);
                 }
 
                 return false;
@@ -645,34 +745,35 @@ namespace cppmicroservices
     }
 
     bool
-    LDAPExpr::Compare(Any const& obj, int op, std::string const& s) const
+    LDAPExpr::Compare(Any const& obj) const
     {
         if (obj.Empty())
         {
             return false;
         }
-        if (op == EQ && s == LDAPExprConstants::WILDCARD_STRING())
+        if (d->m_matchesAny)
         {
             return true;
         }
 
+        int const op = d->m_operator;
         try
         {
             std::type_info const& objType = obj.Type();
             if (objType == typeid(std::string))
             {
-                return CompareString(ref_any_cast<std::string>(obj), op, s);
+                return CompareStringOperand(ref_any_cast<std::string>(obj));
             }
             else if (objType == typeid(char const*))
             {
-                return CompareString(std::string(ref_any_cast<char const*>(obj)), op, s);
+                return CompareStringOperand(ref_any_cast<char const*>(obj));
             }
             else if (objType == typeid(std::vector<std::string>))
             {
                 auto const& list = ref_any_cast<std::vector<std::string>>(obj);
                 for (std::size_t it = 0; it != list.size(); it++)
                 {
-                    if (CompareString(list[it], op, s))
+                    if (CompareStringOperand(list[it]))
                     {
                         return true;
                     }
@@ -683,7 +784,7 @@ namespace cppmicroservices
                 auto const& list = ref_any_cast<std::list<std::string>>(obj);
                 for (auto const& it : list)
                 {
-                    if (CompareString(it, op, s))
+                    if (CompareStringOperand(it))
                     {
                         return true;
                     }
@@ -691,7 +792,7 @@ namespace cppmicroservices
             }
             else if (objType == typeid(char))
             {
-                return CompareString(std::string(1, ref_any_cast<char>(obj)), op, s);
+                return CompareStringOperand(std::string_view(&ref_any_cast<char>(obj), 1));
             }
             else if (objType == typeid(bool))
             {
@@ -700,101 +801,58 @@ namespace cppmicroservices
                     return false;
                 }
 
-                std::string boolVal = any_cast<bool>(obj) ? "true" : "false";
-                return std::equal(s.begin(), s.end(), boolVal.begin(), stricomp);
+                return ref_any_cast<bool>(obj) ? d->m_matchesTrue : d->m_matchesFalse;
             }
             else if (objType == typeid(short))
             {
-                return CompareIntegralType<short>(obj, op, s);
+                return CompareIntegralType<short>(obj);
             }
             else if (objType == typeid(int))
             {
-                return CompareIntegralType<int>(obj, op, s);
+                return CompareIntegralType<int>(obj);
             }
             else if (objType == typeid(long int))
             {
-                return CompareIntegralType<long int>(obj, op, s);
+                return CompareIntegralType<long int>(obj);
             }
             else if (objType == typeid(long long int))
             {
-                return CompareIntegralType<long long int>(obj, op, s);
+                return CompareIntegralType<long long int>(obj);
             }
             else if (objType == typeid(unsigned char))
             {
-                return CompareIntegralType<unsigned char>(obj, op, s);
+                return CompareIntegralType<unsigned char>(obj);
             }
             else if (objType == typeid(unsigned short))
             {
-                return CompareIntegralType<unsigned short>(obj, op, s);
+                return CompareIntegralType<unsigned short>(obj);
             }
             else if (objType == typeid(unsigned int))
             {
-                return CompareIntegralType<unsigned int>(obj, op, s);
+                return CompareIntegralType<unsigned int>(obj);
             }
             else if (objType == typeid(unsigned long int))
             {
-                return CompareIntegralType<unsigned long int>(obj, op, s);
+                return CompareIntegralType<unsigned long int>(obj);
             }
             else if (objType == typeid(unsigned long long int))
             {
-                return CompareIntegralType<unsigned long long int>(obj, op, s);
+                return CompareIntegralType<unsigned long long int>(obj);
             }
             else if (objType == typeid(float))
             {
-                errno = 0;
-                char* endptr = nullptr;
-                double sFloat = strtod(s.c_str(), &endptr);
-                if ((errno == ERANGE && (sFloat == 0 || sFloat == HUGE_VAL || sFloat == -HUGE_VAL))
-                    || (errno != 0 && sFloat == 0) || endptr == s.c_str())
-                {
-                    return false;
-                }
-
-                auto floatVal = static_cast<double>(any_cast<float>(obj));
-
-                switch (op)
-                {
-                    case LE:
-                        return floatVal <= sFloat;
-                    case GE:
-                        return floatVal >= sFloat;
-                    default: /*APPROX and EQ*/
-                        double diff = floatVal - sFloat;
-                        return (diff < std::numeric_limits<float>::epsilon())
-                               && (diff > -std::numeric_limits<float>::epsilon());
-                }
+                return CompareFloatingPointType<float>(obj);
             }
             else if (objType == typeid(double))
             {
-                errno = 0;
-                char* endptr = nullptr;
-                double sDouble = strtod(s.c_str(), &endptr);
-                if ((errno == ERANGE && (sDouble == 0 || sDouble == HUGE_VAL || sDouble == -HUGE_VAL))
-                    || (errno != 0 && sDouble == 0) || endptr == s.c_str())
-                {
-                    return false;
-                }
-
-                auto doubleVal = any_cast<double>(obj);
-
-                switch (op)
-                {
-                    case LE:
-                        return doubleVal <= sDouble;
-                    case GE:
-                        return doubleVal >= sDouble;
-                    default: /*APPROX and EQ*/
-                        double diff = doubleVal - sDouble;
-                        return (diff < std::numeric_limits<double>::epsilon())
-                               && (diff > -std::numeric_limits<double>::epsilon());
-                }
+                return CompareFloatingPointType<double>(obj);
             }
             else if (objType == typeid(std::vector<Any>))
             {
                 auto const& list = ref_any_cast<std::vector<Any>>(obj);
                 for (std::size_t it = 0; it != list.size(); it++)
                 {
-                    if (Compare(list[it], op, s))
+                    if (Compare(list[it]))
                     {
                         return true;
                     }
@@ -811,22 +869,17 @@ namespace cppmicroservices
 
     template <typename T>
     bool
-    LDAPExpr::CompareIntegralType(Any const& obj, int const op, std::string const& s) const
+    LDAPExpr::CompareIntegralType(Any const& obj) const
     {
-        errno = 0;
-        char* endptr = nullptr;
-        long longInt = strtol(s.c_str(), &endptr, 10);
-        if ((errno == ERANGE
-             && (longInt == std::numeric_limits<long>::max() || longInt == std::numeric_limits<long>::min()))
-            || (errno != 0 && longInt == 0) || endptr == s.c_str())
+        if (!d->m_hasLongValue)
         {
             return false;
         }
 
-        auto sInt = static_cast<T>(longInt);
-        auto intVal = any_cast<T>(obj);
+        auto sInt = static_cast<T>(d->m_longValue);
+        auto intVal = ref_any_cast<T>(obj);
 
-        switch (op)
+        switch (d->m_operator)
         {
             case LE:
                 return intVal <= sInt;
@@ -837,6 +890,40 @@ namespace cppmicroservices
         }
     }
 
+    template <typename T>
+    bool
+    LDAPExpr::CompareFloatingPointType(Any const& obj) const
+    {
+        if (!d->m_hasDoubleValue)
+        {
+            return false;
+        }
+
+        double const sDouble = d->m_doubleValue;
+        auto doubleVal = static_cast<double>(ref_any_cast<T>(obj));
+
+        switch (d->m_operator)
+        {
+            case LE:
+                return doubleVal <= sDouble;
+            case GE:
+                return doubleVal >= sDouble;
+            default: /*APPROX and EQ*/
+                double diff = doubleVal - sDouble;
+                return (diff < std::numeric_limits<T>::epsilon()) && (diff > -std::numeric_limits<T>::epsilon());
+        }
+    }
+
+    bool
+    LDAPExpr::CompareStringOperand(const std::string_view s1) const
+    {
+        if (d->m_operator == APPROX)
+        {
+            return FixupStringEquals(s1, d->m_approxValue);
+        }
+        return CompareString(s1, d->m_operator, d->m_attrValue);
+    }
+
     bool
     LDAPExpr::CompareString(const std::string_view s1, int op, const std::string_view s2)
     {
@@ -876,6 +963,31 @@ namespace cppmicroservices
         return sb;
     }
 
+    bool
+    LDAPExpr::FixupStringEquals(const std::string_view s, const std::string_view fixedUp)
+    {
+        std::size_t pos = 0;
+        for (char c : s)
+        {
+            if (std::isspace(c))
+            {
+                continue;
+            }
+            if (pos == fixedUp.size() || static_cast<char>(std::tolower(c)) != fixedUp[pos])
+            {
+                return false;
+            }
+            ++pos;
+        }
+        return pos == fixedUp.size();
+    }
+
+    bool
+    LDAPExpr::EqualsIgnoreCase(const std::string_view s1, const std::string_view s2)
+    {
+        return s1.size() == s2.size() && std::equal(s1.begin(), s1.end(), s2.begin(), stricomp);
+    }
+
     bool
     LDAPExpr::PatSubstr(const std::string_view s, int si, const std::string_view pat, int pi)
     {
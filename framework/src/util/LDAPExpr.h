@@ -85,6 +85,17 @@ namespace cppmicroservices
          */
         bool GetMatchedObjectClasses(ObjectClassSet& objClasses) const;
 
+        /**
+         * Get the value an attribute must be equal to for this LDAP expression
+         * to match. This only works for equality terms without wildcards, either
+         * on their own or as an operand of an AND expression.
+         *
+         * \param attrName The (case-insensitive) attribute name to look for.
+         * \param value Set to the required attribute value on success.
+         * \return <code>true</code> if such a value exists, <code>false</code> otherwise.
+         */
+        bool GetMatchedAttributeValue(std::string const& attrName, std::string& value) const;
+
         /**
          * Checks if this LDAP expression is "simple". The definition of
          * a simple filter is:
@@ -149,12 +160,19 @@ namespace cppmicroservices
 
         static std::string ToLower(std::string const& str);
 
+        //! Compare a property value with the pre-converted operand of this simple expression.
+        bool Compare(Any const& obj) const;
+
         //!
-        bool Compare(Any const& obj, int op, std::string const& s) const;
+        template <typename T>
+        bool CompareIntegralType(Any const& obj) const;
 
         //!
         template <typename T>
-        bool CompareIntegralType(Any const& obj, int const op, std::string const& s) const;
+        bool CompareFloatingPointType(Any const& obj) const;
+
+        //! Like CompareString, but uses the pre-computed APPROX operand.
+        bool CompareStringOperand(const std::string_view s1) const;
 
         //!
         static bool CompareString(const std::string_view s1, int op, const std::string_view s2);
@@ -162,6 +180,12 @@ namespace cppmicroservices
         //!
         static std::string FixupString(const std::string_view s);
 
+        //! Same as <code>FixupString(s) == fixedUp</code>, without allocating.
+        static bool FixupStringEquals(const std::string_view s, const std::string_view fixedUp);
+
+        //! Case-insensitive string equality, without allocating.
+        static bool EqualsIgnoreCase(const std::string_view s1, const std::string_view s2);
+
         //!
         static bool PatSubstr(const std::string_view s, const std::string_view pat);
 
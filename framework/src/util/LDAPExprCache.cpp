@@ -0,0 +1,116 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "LDAPExprCache.h"
+
+namespace cppmicroservices
+{
+
+    LDAPExprCache&
+    LDAPExprCache::Instance()
+    {
+        static LDAPExprCache cache;
+        return cache;
+    }
+
+    LDAPExprCache::LDAPExprCache(std::size_t capacity) : capacity(capacity), hits(0), misses(0), evictions(0) {}
+
+    LDAPExpr
+    LDAPExprCache::Get(std::string const& filter)
+    {
+        {
+            auto l = this->Lock();
+            US_UNUSED(l);
+            auto it = index.find(filter);
+            if (it != index.end())
+            {
+                ++hits;
+                entries.splice(entries.begin(), entries, it->second);
+                return it->second->second;
+            }
+            ++misses;
+        }
+
+        // Parse outside of the lock; concurrent misses on the same filter
+        // are resolved below by keeping whichever expression got in first.
+        LDAPExpr expr(filter);
+
+        auto l = this->Lock();
+        US_UNUSED(l);
+        if (capacity == 0)
+        {
+            return expr;
+        }
+
+        auto it = index.find(filter);
+        if (it != index.end())
+        {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+
+        entries.emplace_front(filter, expr);
+        index.emplace(filter, entries.begin());
+        EvictToCapacity_unlocked();
+        return expr;
+    }
+
+    void
+    LDAPExprCache::SetCapacity(std::size_t newCapacity)
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        capacity = newCapacity;
+        EvictToCapacity_unlocked();
+    }
+
+    void
+    LDAPExprCache::Clear()
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        index.clear();
+        entries.clear();
+        hits = 0;
+        misses = 0;
+        evictions = 0;
+    }
+
+    LDAPExprCache::Statistics
+    LDAPExprCache::GetStatistics() const
+    {
+        auto l = this->Lock();
+        US_UNUSED(l);
+        return Statistics { hits, misses, evictions, entries.size(), capacity };
+    }
+
+    void
+    LDAPExprCache::EvictToCapacity_unlocked()
+    {
+        while (entries.size() > capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++evictions;
+        }
+    }
+} // namespace cppmicroservices
@@ -0,0 +1,106 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_LDAPEXPRCACHE_H
+#define CPPMICROSERVICES_LDAPEXPRCACHE_H
+
+#include "cppmicroservices/LDAPFilter.h"
+#include "cppmicroservices/detail/Threads.h"
+
+#include "LDAPExpr.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace cppmicroservices
+{
+
+    /**
+     * A bounded, thread-safe cache of parsed LDAP expressions keyed by
+     * their filter string. The least recently used expression is evicted
+     * when the cache is full.
+     *
+     * LDAPExpr objects are immutable after construction and share their
+     * data, so a cached expression can be handed out to any number of
+     * threads.
+     *
+     * This class is not part of the public API.
+     */
+    class LDAPExprCache : private detail::MultiThreaded<>
+    {
+      public:
+        using Statistics = LDAPFilter::CacheStatistics;
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+        /**
+         * The framework-wide cache shared by the service registry,
+         * the service listeners and LDAPFilter.
+         */
+        static LDAPExprCache& Instance();
+
+        explicit LDAPExprCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+        LDAPExprCache(LDAPExprCache const&) = delete;
+        LDAPExprCache& operator=(LDAPExprCache const&) = delete;
+
+        /**
+         * Returns the parsed expression for \c filter, parsing and caching
+         * it if it has not been seen recently.
+         *
+         * @throws std::invalid_argument If \c filter cannot be parsed. Invalid
+         *         filters are never cached.
+         */
+        LDAPExpr Get(std::string const& filter);
+
+        /**
+         * Changes the maximum number of cached expressions, evicting the least
+         * recently used ones if necessary. A capacity of zero disables caching.
+         */
+        void SetCapacity(std::size_t capacity);
+
+        void Clear();
+
+        Statistics GetStatistics() const;
+
+      private:
+        using Entry = std::pair<std::string, LDAPExpr>;
+        using EntryList = std::list<Entry>;
+
+        void EvictToCapacity_unlocked();
+
+        std::size_t capacity;
+
+        /* Most recently used expressions are at the front. */
+        EntryList entries;
+        std::unordered_map<std::string, EntryList::iterator> index;
+
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+    };
+} // namespace cppmicroservices
+
+#endif // CPPMICROSERVICES_LDAPEXPRCACHE_H
@@ -26,8 +26,8 @@
 #include "cppmicroservices/ServiceReference.h"
 
 #include "LDAPExpr.h"
+#include "LDAPExprCache.h"
 #include "Properties.h"
-#include "PropsCheck.h"
 #include "ServiceReferenceBasePrivate.h"
 #include "Utils.h"
 
@@ -41,13 +41,19 @@ namespace cppmicroservices
       public:
         LDAPFilterData() : ldapExpr() {}
 
-        LDAPFilterData(std::string const& filter) : ldapExpr(filter) {}
+        LDAPFilterData(std::string const& filter) : ldapExpr(LDAPExprCache::Instance().Get(filter)) {}
 
         LDAPFilterData(LDAPFilterData const&) = default;
 
         LDAPExpr ldapExpr;
     };
 
+    LDAPFilter::CacheStatistics
+    LDAPFilter::GetCacheStatistics()
+    {
+        return LDAPExprCache::Instance().GetStatistics();
+    }
+
     LDAPFilter::LDAPFilter() : d(nullptr) {}
 
     LDAPFilter::LDAPFilter(std::string const& filter) : d(nullptr)
@@ -84,10 +90,7 @@ namespace cppmicroservices
         {
             auto const& headers = bundle.GetHeaders();
 
-            if (headers.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-            {
-                props_check::ValidateAnyMap(headers);
-            }
+            Properties::Validate(headers);
 
             return d->ldapExpr.Evaluate(headers, false);
         }
@@ -105,10 +108,7 @@ namespace cppmicroservices
     {
         if (d)
         {
-            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-            {
-                props_check::ValidateAnyMap(dictionary);
-            }
+            Properties::Validate(dictionary);
 
             return d->ldapExpr.Evaluate(dictionary, false);
         }
@@ -126,10 +126,7 @@ namespace cppmicroservices
     {
         if (d)
         {
-            if (dictionary.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-            {
-                props_check::ValidateAnyMap(dictionary);
-            }
+            Properties::Validate(dictionary);
 
             return d->ldapExpr.Evaluate(dictionary, true);
         }
@@ -48,14 +48,14 @@ namespace cppmicroservices
         {
             for (auto itr = props.beginOM_TypeChecked(); itr != props.endOM_TypeChecked(); ++itr)
             {
-                caseInsensitiveLookup.insert(itr->first);
+                caseInsensitiveLookup.insert(&itr->first);
             }
         }
         else if (props.GetType() == AnyMap::UNORDERED_MAP)
         {
             for (auto itr = props.beginUO_TypeChecked(); itr != props.endUO_TypeChecked(); ++itr)
             {
-                caseInsensitiveLookup.insert(itr->first);
+                caseInsensitiveLookup.insert(&itr->first);
             }
         }
         else
@@ -68,23 +68,33 @@ namespace cppmicroservices
     // they can _never_ contain some pair of keys which are only different in case. Because of this,
     // the validation check is not performed on these map types. Additionally, those types of maps
     // are already case insensitive so populating and using the case insensitive lookup map is
-    // unnecessary.
+    // unnecessary. FLAT_MAP AnyMaps support case insensitive lookups themselves and do not need
+    // the lookup map either.
 
-    Properties::Properties(AnyMap const& p) : props(p)
+    void
+    Properties::Validate(AnyMap const& props)
     {
-        if (p.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        switch (props.GetType())
         {
-            props_check::ValidateAnyMap(p);
+            case AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS:
+                break;
+            case AnyMap::FLAT_MAP:
+                // Case variants of a key are adjacent in a flat map, so they are cheap
+                // to rule out. Only run the full check to report an offending key.
+                if (props.f_m_TypeChecked().has_case_variants())
+                {
+                    props_check::ValidateAnyMap(props);
+                }
+                break;
+            default:
+                props_check::ValidateAnyMap(props);
+                break;
         }
     }
 
-    Properties::Properties(AnyMap&& p) : props(std::move(p))
-    {
-        if (props.GetType() != AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
-        {
-            props_check::ValidateAnyMap(props);
-        }
-    }
+    Properties::Properties(AnyMap const& p) : props(p) { Validate(props); }
+
+    Properties::Properties(AnyMap&& p) : props(std::move(p)) { Validate(props); }
 
     Properties::Properties(Properties&& o) noexcept : props(std::move(o.props)) {}
 
@@ -100,7 +110,17 @@ namespace cppmicroservices
     Any const&
     Properties::ValueByRef_unlocked(std::string const& key, bool matchCase) const
     {
-        if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        if (props.GetType() == AnyMap::FLAT_MAP)
+        {
+            auto const& flat = props.f_m_TypeChecked();
+            auto itr = flat.find(key);
+            if (itr == flat.end() && !matchCase)
+            {
+                itr = flat.find_ci(key);
+            }
+            return itr != flat.end() ? itr->second : emptyAny;
+        }
+        else if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
         {
             if (auto itr = props.findUOCI_TypeChecked(key); itr != props.endUOCI_TypeChecked())
             {
@@ -134,10 +154,10 @@ namespace cppmicroservices
             {
                 PopulateCaseInsensitiveLookupMap();
 
-                auto ciItr = caseInsensitiveLookup.find(key);
+                auto ciItr = caseInsensitiveLookup.find(&key);
                 if (ciItr != caseInsensitiveLookup.end())
                 {
-                    return props.findUO_TypeChecked(*ciItr)->second;
+                    return props.findUO_TypeChecked(**ciItr)->second;
                 }
                 else
                 {
@@ -159,10 +179,10 @@ namespace cppmicroservices
             {
                 PopulateCaseInsensitiveLookupMap();
 
-                auto ciItr = caseInsensitiveLookup.find(key);
+                auto ciItr = caseInsensitiveLookup.find(&key);
                 if (ciItr != caseInsensitiveLookup.end())
                 {
-                    return props.findOM_TypeChecked(*ciItr)->second;
+                    return props.findOM_TypeChecked(**ciItr)->second;
                 }
                 else
                 {
@@ -188,7 +208,17 @@ namespace cppmicroservices
     std::pair<Any, bool>
     Properties::Value_unlocked(std::string const& key, bool matchCase) const
     {
-        if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+        if (props.GetType() == AnyMap::FLAT_MAP)
+        {
+            auto const& flat = props.f_m_TypeChecked();
+            auto itr = flat.find(key);
+            if (itr == flat.end() && !matchCase)
+            {
+                itr = flat.find_ci(key);
+            }
+            return itr != flat.end() ? std::make_pair(itr->second, true) : std::make_pair(emptyAny, false);
+        }
+        else if (props.GetType() == AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
         {
             if (auto itr = props.findUOCI_TypeChecked(key); itr != props.endUOCI_TypeChecked())
             {
@@ -222,10 +252,10 @@ namespace cppmicroservices
             {
                 PopulateCaseInsensitiveLookupMap();
 
-                auto ciItr = caseInsensitiveLookup.find(key);
+                auto ciItr = caseInsensitiveLookup.find(&key);
                 if (ciItr != caseInsensitiveLookup.end())
                 {
-                    return std::make_pair(props.findUO_TypeChecked(*ciItr)->second, true);
+                    return std::make_pair(props.findUO_TypeChecked(**ciItr)->second, true);
                 }
                 else
                 {
@@ -247,10 +277,10 @@ namespace cppmicroservices
             {
                 PopulateCaseInsensitiveLookupMap();
 
-                auto ciItr = caseInsensitiveLookup.find(key);
+                auto ciItr = caseInsensitiveLookup.find(&key);
                 if (ciItr != caseInsensitiveLookup.end())
                 {
-                    return std::make_pair(props.findOM_TypeChecked(*ciItr)->second, true);
+                    return std::make_pair(props.findOM_TypeChecked(**ciItr)->second, true);
                 }
                 else
                 {
@@ -281,6 +311,7 @@ namespace cppmicroservices
     void
     Properties::Clear_unlocked()
     {
+        caseInsensitiveLookup.clear();
         props.clear();
     }
 } // namespace cppmicroservices
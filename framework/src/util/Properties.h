@@ -58,16 +58,43 @@ namespace cppmicroservices
             return props;
         }
 
+        /**
+         * Throws std::runtime_error if <code>props</code> contains keys which only
+         * differ in case, see props_check::ValidateAnyMap. Uses the cheapest check
+         * the map type allows.
+         */
+        static void Validate(AnyMap const& props);
+
       private:
         // An AnyMap is used to store the properties rather than 2 vectors (one for keys
         // and the other for values) as previously done in the past. This reduces the number of
         // copies and allows for finds to leverage a map find vs vector find.
         AnyMap props;
 
-        // A case-insensitive map which maps all-lowercased keys to the original key values. This
-        // allows for efficient case-insensitive lookups in map types that are not inherently
-        // case insensitive.
-        mutable std::unordered_set<std::string, detail::any_map_cihash, detail::any_map_ciequal> caseInsensitiveLookup;
+        struct KeyPtrCIHash
+        {
+            std::size_t
+            operator()(std::string const* key) const
+            {
+                return detail::any_map_cihash()(*key);
+            }
+        };
+
+        struct KeyPtrCIEqual
+        {
+            bool
+            operator()(std::string const* l, std::string const* r) const
+            {
+                return detail::any_map_ciequal()(*l, *r);
+            }
+        };
+
+        // A case-insensitive set of the keys in props. This allows for efficient case-insensitive
+        // lookups in map types that are not inherently case insensitive. It points to the keys
+        // stored in props instead of holding copies of them, which is safe because props is not
+        // modified other than by Clear_unlocked() and the map types it is used for do not move
+        // their entries.
+        mutable std::unordered_set<std::string const*, KeyPtrCIHash, KeyPtrCIEqual> caseInsensitiveLookup;
 
         static const Any emptyAny;
 
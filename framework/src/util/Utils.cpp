@@ -25,6 +25,7 @@
 #include "cppmicroservices/Bundle.h"
 #include "cppmicroservices/BundleContext.h"
 
+#include "cppmicroservices/util/BinaryManifest.h"
 #include "cppmicroservices/util/Error.h"
 #include "cppmicroservices/util/FileSystem.h"
 
@@ -101,7 +102,10 @@ namespace cppmicroservices
                                return std::all_of(names.begin(),
                                                   names.end(),
                                                   [](const std::string& resourceName) -> bool
-                                                  { return resourceName == std::string("manifest.json"); });
+                                                  {
+                                                      return resourceName == std::string("manifest.json")
+                                                             || resourceName == binarymanifest::ENTRY_NAME;
+                                                  });
                            });
     }
 
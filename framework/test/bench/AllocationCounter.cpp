@@ -0,0 +1,28 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+    std::atomic<std::size_t> allocationCount { 0 };
+} // namespace
+
+std::size_t
+AllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void*
+CountedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void
+CountedFree(void* p)
+{
+    std::free(p);
+}
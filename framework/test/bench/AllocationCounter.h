@@ -0,0 +1,19 @@
+#ifndef CPPMICROSERVICES_BENCH_ALLOCATIONCOUNTER_H
+#define CPPMICROSERVICES_BENCH_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+// Heap allocation counting for the usFrameworkAllocationBenchTests executable,
+// which replaces the global operator new and delete with functions calling
+// CountedAllocate and CountedFree.
+
+// Returns the number of heap allocations made so far.
+std::size_t AllocationCount();
+
+// Allocates size bytes with std::malloc and counts the allocation.
+void* CountedAllocate(std::size_t size);
+
+// Frees memory returned by CountedAllocate.
+void CountedFree(void* p);
+
+#endif // CPPMICROSERVICES_BENCH_ALLOCATIONCOUNTER_H
@@ -0,0 +1,57 @@
+#include "AllocationCounter.h"
+#include "ServiceProperties.h"
+#include "benchmark/benchmark.h"
+
+#include <cppmicroservices/AnyMap.h>
+
+#include <new>
+
+using namespace cppmicroservices;
+
+// The global operator new and delete are replaced to count heap allocations.
+// This file is built into its own executable, so that the counting does not
+// affect the measurements of any other benchmark.
+void*
+operator new(std::size_t size)
+{
+    if (void* p = CountedAllocate(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    CountedFree(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    CountedFree(p);
+}
+
+// Copy a service property map and report the number of heap allocations per copy.
+static void
+CopyServicePropertiesAllocations(benchmark::State& state)
+{
+    auto const props = MakeServiceProperties(static_cast<AnyMap::map_type>(state.range(0)));
+    std::size_t allocations = 0;
+    for (auto _ : state)
+    {
+        auto const before = AllocationCount();
+        AnyMap copy(props);
+        allocations += AllocationCount() - before;
+        benchmark::DoNotOptimize(copy);
+    }
+    state.counters["allocs_per_copy"]
+        = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(CopyServicePropertiesAllocations)
+    ->Arg(AnyMap::ORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+    ->Arg(AnyMap::FLAT_MAP);
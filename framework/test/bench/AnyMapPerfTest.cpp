@@ -1,3 +1,4 @@
+#include "ServiceProperties.h"
 #include "TestUtils.h"
 #include "benchmark/benchmark.h"
 
@@ -11,6 +12,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using namespace cppmicroservices;
 
@@ -188,3 +191,70 @@ BENCHMARK_REGISTER_F(AnyMapPerfTestFixture, ErrorPath_NoThrowOverload)
     ->Arg(15)
     ->Arg(18)
     ->Arg(20);
+
+// Copy a service property map. AnyAllocationTest reports the number of heap
+// allocations per copy.
+static void
+CopyServiceProperties(benchmark::State& state)
+{
+    auto const props = MakeServiceProperties(static_cast<AnyMap::map_type>(state.range(0)));
+    for (auto _ : state)
+    {
+        AnyMap copy(props);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+// Look up every key of a service property map, plus one key which is not in it.
+static void
+LookupServiceProperties(benchmark::State& state)
+{
+    auto const props = MakeServiceProperties(static_cast<AnyMap::map_type>(state.range(0)));
+    std::vector<std::string> keys;
+    for (auto const& kv : props)
+    {
+        keys.push_back(kv.first);
+    }
+    std::string const missing("service.vendor");
+    for (auto _ : state)
+    {
+        for (auto const& key : keys)
+        {
+            benchmark::DoNotOptimize(&props.at(key));
+        }
+        benchmark::DoNotOptimize(props.count(missing));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size() + 1));
+}
+
+// Visit all entries of a service property map.
+static void
+IterateServiceProperties(benchmark::State& state)
+{
+    auto const props = MakeServiceProperties(static_cast<AnyMap::map_type>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::size_t keyLength = 0;
+        for (auto const& kv : props)
+        {
+            keyLength += kv.first.size();
+        }
+        benchmark::DoNotOptimize(keyLength);
+    }
+}
+
+BENCHMARK(CopyServiceProperties)
+    ->Arg(AnyMap::ORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+    ->Arg(AnyMap::FLAT_MAP);
+BENCHMARK(LookupServiceProperties)
+    ->Arg(AnyMap::ORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+    ->Arg(AnyMap::FLAT_MAP);
+BENCHMARK(IterateServiceProperties)
+    ->Arg(AnyMap::ORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP)
+    ->Arg(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS)
+    ->Arg(AnyMap::FLAT_MAP);
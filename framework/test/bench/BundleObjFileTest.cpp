@@ -0,0 +1,93 @@
+#include "TestUtils.h"
+#include "TestingConfig.h"
+#include "benchmark/benchmark.h"
+
+#include "cppmicroservices/util/BundleObjFactory.h"
+#include "cppmicroservices/util/BundleObjFile.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace cppmicroservices;
+
+#if defined(US_BUILD_SHARED_LIBS)
+namespace
+{
+    std::string
+    BundlePath(std::string const& name)
+    {
+        return testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + name + US_LIB_POSTFIX + US_LIB_EXT;
+    }
+
+    /*
+     * Locates the resources of the given bundle binary the way the framework
+     * does when a bundle's resource container is opened.
+     */
+    void
+    LocateResources(benchmark::State& state, std::string const& location)
+    {
+        for (auto _ : state)
+        {
+            auto objFile = BundleObjFactory().CreateBundleFileObj(location);
+            auto resources = objFile->GetRawBundleResourceContainer();
+            benchmark::DoNotOptimize(resources);
+        }
+    }
+} // namespace
+
+// A copy of the framework library, replaced before every iteration so
+// that the resource section has to be located from scratch
+static void
+LocateFrameworkResourcesUncached(benchmark::State& state)
+{
+    std::string const source
+        = testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "CppMicroServices" + US_LIB_EXT;
+    testing::TempDir dir(testing::MakeUniqueTempDirectory());
+    std::string const location = dir.Path + util::DIR_SEP + "framework_copy" + US_LIB_EXT;
+    std::string const staged = location + ".staged";
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        {
+            std::ifstream in(source, std::ios_base::binary);
+            std::ofstream out(staged, std::ios_base::binary | std::ios_base::trunc);
+            out << in.rdbuf();
+        }
+        // a new file, as seen by the framework
+        std::rename(staged.c_str(), location.c_str());
+        state.ResumeTiming();
+
+        auto objFile = BundleObjFactory().CreateBundleFileObj(location);
+        auto resources = objFile->GetRawBundleResourceContainer();
+        benchmark::DoNotOptimize(resources);
+    }
+}
+
+// A bundle with resources linked into a data section
+static void
+LocateLinkedResources(benchmark::State& state)
+{
+    LocateResources(state, BundlePath("TestBundleRL"));
+}
+
+// A bundle with appended resources and therefore no resource section
+static void
+LocateAppendedResources(benchmark::State& state)
+{
+    LocateResources(state, BundlePath("TestBundleA"));
+}
+
+// The framework library itself, which has many sections
+static void
+LocateFrameworkResources(benchmark::State& state)
+{
+    LocateResources(state, testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + "CppMicroServices" + US_LIB_EXT);
+}
+
+BENCHMARK(LocateLinkedResources);
+BENCHMARK(LocateAppendedResources);
+BENCHMARK(LocateFrameworkResources);
+BENCHMARK(LocateFrameworkResourcesUncached);
+#endif
@@ -0,0 +1,113 @@
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+#include "miniz.h"
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    constexpr int NumberOfBundles = 500;
+
+    /*
+     * Creates data-only bundles, each one a zip file containing a manifest.json file,
+     * in a temporary directory which is removed on destruction.
+     */
+    class DataOnlyBundles
+    {
+      public:
+        explicit DataOnlyBundles(int count) : dir(testing::MakeUniqueTempDirectory())
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                std::string const bundleName = "bundle_" + std::to_string(i);
+                std::string const manifest
+                    = "{ \"bundle.symbolic_name\" : \"" + bundleName + "\", \"bundle.version\" : \"1.0.0\" }";
+                std::string const entry = bundleName + "/manifest.json";
+                std::string const location = dir.Path + util::DIR_SEP + bundleName + ".zip";
+
+                mz_zip_archive zip;
+                memset(&zip, 0, sizeof(mz_zip_archive));
+                mz_zip_writer_init_file(&zip, location.c_str(), 0);
+                mz_zip_writer_add_mem(&zip, entry.c_str(), manifest.c_str(), manifest.size(), MZ_DEFAULT_COMPRESSION);
+                mz_zip_writer_finalize_archive(&zip);
+                mz_zip_writer_end(&zip);
+
+                locations.push_back(location);
+            }
+        }
+
+        std::vector<std::string> const&
+        Locations() const
+        {
+            return locations;
+        }
+
+      private:
+        testing::TempDir dir;
+        std::vector<std::string> locations;
+    };
+
+    void
+    StartAndInstall(FrameworkConfiguration const& config, std::vector<std::string> const& locations)
+    {
+        auto framework = FrameworkFactory().NewFramework(config);
+        framework.Start();
+        auto context = framework.GetBundleContext();
+        for (auto const& location : locations)
+        {
+            auto bundles = context.InstallBundles(location);
+            benchmark::DoNotOptimize(bundles);
+        }
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+} // namespace
+
+// Every launch installs all bundles, reading each zip file and its manifest.
+static void
+ColdStartInstallDataOnlyBundles(benchmark::State& state)
+{
+    DataOnlyBundles bundles(NumberOfBundles);
+    testing::TempDir storage(testing::MakeUniqueTempDirectory());
+    FrameworkConfiguration config;
+    config[Constants::FRAMEWORK_STORAGE] = storage.Path;
+
+    for (auto _ : state)
+    {
+        StartAndInstall(config, bundles.Locations());
+    }
+}
+
+// The bundles recorded by the first launch are restored from the persistent
+// storage without opening the unchanged zip files.
+static void
+WarmStartInstallDataOnlyBundles(benchmark::State& state)
+{
+    DataOnlyBundles bundles(NumberOfBundles);
+    testing::TempDir storage(testing::MakeUniqueTempDirectory());
+    FrameworkConfiguration config;
+    config[Constants::FRAMEWORK_STORAGE] = storage.Path;
+    config[Constants::FRAMEWORK_STORAGE_PERSISTENT] = true;
+
+    StartAndInstall(config, bundles.Locations());
+    for (auto _ : state)
+    {
+        StartAndInstall(config, bundles.Locations());
+    }
+}
+
+BENCHMARK(ColdStartInstallDataOnlyBundles)->Unit(benchmark::kMillisecond);
+BENCHMARK(WarmStartInstallDataOnlyBundles)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,157 @@
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+#include "miniz.h"
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "cppmicroservices/util/BinaryManifest.h"
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    constexpr int NumberOfComponents = 500;
+
+    /*
+     * Builds a manifest declaring NumberOfComponents declarative services
+     * components, similar to what a large service bundle carries.
+     */
+    void
+    BuildManifest(std::string const& bundleName, rapidjson::Document& manifest)
+    {
+        auto& alloc = manifest.GetAllocator();
+        manifest.SetObject();
+        manifest.AddMember("bundle.symbolic_name", rapidjson::Value(bundleName.c_str(), alloc), alloc);
+        manifest.AddMember("bundle.version", "1.0.0", alloc);
+
+        rapidjson::Value components(rapidjson::kArrayType);
+        for (int i = 0; i < NumberOfComponents; ++i)
+        {
+            std::string const name = "sample::Component" + std::to_string(i);
+            rapidjson::Value properties(rapidjson::kObjectType);
+            properties.AddMember("index", i, alloc);
+            properties.AddMember("weight", i * 0.5, alloc);
+            properties.AddMember("enabled", (i % 2) == 0, alloc);
+
+            rapidjson::Value interfaces(rapidjson::kArrayType);
+            interfaces.PushBack(rapidjson::Value("sample::ServiceInterface", alloc), alloc);
+
+            rapidjson::Value reference(rapidjson::kObjectType);
+            reference.AddMember("name", "dependency", alloc);
+            reference.AddMember("interface", "sample::Dependency", alloc);
+            reference.AddMember("cardinality", "0..n", alloc);
+            reference.AddMember("policy", "dynamic", alloc);
+            rapidjson::Value references(rapidjson::kArrayType);
+            references.PushBack(reference, alloc);
+
+            rapidjson::Value service(rapidjson::kObjectType);
+            service.AddMember("interfaces", interfaces, alloc);
+
+            rapidjson::Value component(rapidjson::kObjectType);
+            component.AddMember("implementation-class", rapidjson::Value(name.c_str(), alloc), alloc);
+            component.AddMember("properties", properties, alloc);
+            component.AddMember("service", service, alloc);
+            component.AddMember("references", references, alloc);
+            components.PushBack(component, alloc);
+        }
+
+        rapidjson::Value scr(rapidjson::kObjectType);
+        scr.AddMember("version", 1, alloc);
+        scr.AddMember("components", components, alloc);
+        manifest.AddMember("scr", scr, alloc);
+    }
+
+    /*
+     * Writes a data-only bundle carrying the large manifest, with or without
+     * the binary manifest the resource compiler stores for --binary-manifest.
+     */
+    std::string
+    CreateBundle(testing::TempDir const& dir, bool withBinaryManifest)
+    {
+        std::string const bundleName = "large_manifest_bundle";
+        std::string const location = dir.Path + util::DIR_SEP + bundleName + ".zip";
+
+        rapidjson::Document manifest;
+        BuildManifest(bundleName, manifest);
+        rapidjson::StringBuffer json;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(json);
+        manifest.Accept(writer);
+
+        mz_zip_archive zip;
+        memset(&zip, 0, sizeof(mz_zip_archive));
+        mz_zip_writer_init_file(&zip, location.c_str(), 0);
+        mz_zip_writer_add_mem(&zip, (bundleName + "/").c_str(), nullptr, 0, MZ_NO_COMPRESSION);
+        mz_zip_writer_add_mem(&zip,
+                              (bundleName + "/manifest.json").c_str(),
+                              json.GetString(),
+                              json.GetSize(),
+                              MZ_DEFAULT_COMPRESSION);
+        if (withBinaryManifest)
+        {
+            std::string const encoded = binarymanifest::Encode(manifest);
+            mz_zip_writer_add_mem(&zip,
+                                  (bundleName + "/" + binarymanifest::ENTRY_NAME).c_str(),
+                                  encoded.data(),
+                                  encoded.size(),
+                                  MZ_DEFAULT_COMPRESSION);
+        }
+        mz_zip_writer_finalize_archive(&zip);
+        mz_zip_writer_end(&zip);
+        return location;
+    }
+
+    void
+    InstallLargeManifestBundle(benchmark::State& state, bool withBinaryManifest)
+    {
+        testing::TempDir dir(testing::MakeUniqueTempDirectory());
+        auto const location = CreateBundle(dir, withBinaryManifest);
+
+        auto framework = FrameworkFactory().NewFramework();
+        framework.Start();
+        auto context = framework.GetBundleContext();
+        for (auto _ : state)
+        {
+            auto bundles = context.InstallBundles(location);
+            state.PauseTiming();
+            if (bundles.size() != 1 || !bundles.at(0).GetHeaders().count("scr"))
+            {
+                state.SkipWithError("bundle not installed");
+                break;
+            }
+            bundles.at(0).Uninstall();
+            state.ResumeTiming();
+        }
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+} // namespace
+
+// The framework parses manifest.json
+static void
+InstallBundleWithJsonManifest(benchmark::State& state)
+{
+    InstallLargeManifestBundle(state, false);
+}
+
+// The framework decodes the precompiled manifest.bin
+static void
+InstallBundleWithBinaryManifest(benchmark::State& state)
+{
+    InstallLargeManifestBundle(state, true);
+}
+
+BENCHMARK(InstallBundleWithJsonManifest)->Unit(benchmark::kMillisecond);
+BENCHMARK(InstallBundleWithBinaryManifest)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,121 @@
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+#include "miniz.h"
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include "cppmicroservices/util/FileSystem.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    constexpr int NumberOfDirectories = 100;
+    constexpr int ResourcesPerDirectory = 200;
+
+    /*
+     * Creates a data-only bundle with NumberOfDirectories * ResourcesPerDirectory
+     * resources, half of them .json files, and installs it into a framework.
+     */
+    class LargeResourceBundle
+    {
+      public:
+        LargeResourceBundle()
+            : dir(testing::MakeUniqueTempDirectory())
+            , framework(FrameworkFactory().NewFramework())
+        {
+            std::string const bundleName = "large_resource_bundle";
+            std::string const manifest
+                = "{ \"bundle.symbolic_name\" : \"" + bundleName + "\", \"bundle.version\" : \"1.0.0\" }";
+            std::string const location = dir.Path + util::DIR_SEP + bundleName + ".zip";
+
+            mz_zip_archive zip;
+            memset(&zip, 0, sizeof(mz_zip_archive));
+            mz_zip_writer_init_file(&zip, location.c_str(), 0);
+            AddEntry(zip, bundleName + "/", "");
+            AddEntry(zip, bundleName + "/manifest.json", manifest);
+            for (int d = 0; d < NumberOfDirectories; ++d)
+            {
+                std::string const resDir = bundleName + "/dir_" + std::to_string(d) + "/";
+                AddEntry(zip, resDir, "");
+                for (int r = 0; r < ResourcesPerDirectory; ++r)
+                {
+                    std::string const suffix = (r % 2) ? ".json" : ".txt";
+                    AddEntry(zip, resDir + "res_" + std::to_string(r) + suffix, "{}");
+                }
+            }
+            mz_zip_writer_finalize_archive(&zip);
+            mz_zip_writer_end(&zip);
+
+            framework.Start();
+            bundle = framework.GetBundleContext().InstallBundles(location).at(0);
+        }
+
+        ~LargeResourceBundle()
+        {
+            framework.Stop();
+            framework.WaitForStop(std::chrono::milliseconds::zero());
+        }
+
+        Bundle const&
+        GetBundle() const
+        {
+            return bundle;
+        }
+
+      private:
+        static void
+        AddEntry(mz_zip_archive& zip, std::string const& name, std::string const& content)
+        {
+            mz_zip_writer_add_mem(&zip, name.c_str(), content.c_str(), content.size(), MZ_DEFAULT_COMPRESSION);
+        }
+
+        testing::TempDir dir;
+        Framework framework;
+        Bundle bundle;
+    };
+} // namespace
+
+static void
+GetResourceFromLargeBundle(benchmark::State& state)
+{
+    LargeResourceBundle large;
+    int i = 0;
+    for (auto _ : state)
+    {
+        auto const d = i % NumberOfDirectories;
+        auto const r = i % ResourcesPerDirectory;
+        auto resource = large.GetBundle().GetResource("/dir_" + std::to_string(d) + "/res_" + std::to_string(r)
+                                                      + ((r % 2) ? ".json" : ".txt"));
+        benchmark::DoNotOptimize(resource);
+        ++i;
+    }
+}
+
+static void
+FindResourcesInLargeBundle(benchmark::State& state)
+{
+    LargeResourceBundle large;
+    for (auto _ : state)
+    {
+        auto resources = large.GetBundle().FindResources("/", "*.json", true);
+        // all .json resources plus the manifest
+        if (resources.size() != NumberOfDirectories * ResourcesPerDirectory / 2 + 1)
+        {
+            state.SkipWithError("unexpected number of resources");
+            break;
+        }
+    }
+}
+
+BENCHMARK(GetResourceFromLargeBundle);
+BENCHMARK(FindResourcesInLargeBundle)->Unit(benchmark::kMillisecond);
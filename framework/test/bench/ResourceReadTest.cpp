@@ -0,0 +1,87 @@
+#include "TestUtils.h"
+#include "benchmark/benchmark.h"
+#include <cppmicroservices/Bundle.h>
+#include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/BundleResource.h>
+#include <cppmicroservices/BundleResourceStream.h>
+#include <cppmicroservices/Framework.h>
+#include <cppmicroservices/FrameworkEvent.h>
+#include <cppmicroservices/FrameworkFactory.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    constexpr int ReadsPerThread = 50;
+
+    /*
+     * Reads the given resource ReadsPerThread times on each of state.range(0)
+     * threads. All threads share the same bundle and therefore the same
+     * resource container.
+     */
+    void
+    ReadConcurrently(benchmark::State& state, std::string const& bundleName, std::string const& resourcePath)
+    {
+        auto framework = FrameworkFactory().NewFramework();
+        framework.Start();
+        auto bundle = testing::InstallLib(framework.GetBundleContext(), bundleName);
+        auto resource = bundle.GetResource(resourcePath);
+        if (!resource)
+        {
+            state.SkipWithError("resource not found");
+            return;
+        }
+
+        auto const threadCount = static_cast<int>(state.range(0));
+        auto readResource = [&resource]()
+        {
+            for (int i = 0; i < ReadsPerThread; ++i)
+            {
+                BundleResourceStream rs(resource, std::ios_base::binary);
+                std::string content(static_cast<std::size_t>(resource.GetSize()), '\0');
+                rs.read(&content[0], static_cast<std::streamsize>(content.size()));
+                benchmark::DoNotOptimize(content);
+            }
+        };
+
+        for (auto _ : state)
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(threadCount);
+            for (int i = 0; i < threadCount; ++i)
+            {
+                threads.emplace_back(readResource);
+            }
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * threadCount * ReadsPerThread);
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+} // namespace
+
+// Resources appended to the library are read from the bundle file.
+static void
+ConcurrentReadAppendedResource(benchmark::State& state)
+{
+    ReadConcurrently(state, "TestBundleR", "/icons/compressable.bmp");
+}
+
+// Resources linked into the library are read from the mapped bundle.
+static void
+ConcurrentReadLinkedResource(benchmark::State& state)
+{
+    ReadConcurrently(state, "TestBundleRL", "/foo2.txt");
+}
+
+BENCHMARK(ConcurrentReadAppendedResource)->RangeMultiplier(4)->Range(1, 32)->UseRealTime();
+BENCHMARK(ConcurrentReadLinkedResource)->RangeMultiplier(4)->Range(1, 32)->UseRealTime();
@@ -0,0 +1,25 @@
+#ifndef CPPMICROSERVICES_BENCH_SERVICEPROPERTIES_H
+#define CPPMICROSERVICES_BENCH_SERVICEPROPERTIES_H
+
+#include <cppmicroservices/AnyMap.h>
+
+#include <string>
+#include <vector>
+
+// A typical set of service properties: mostly scalars and short strings.
+inline cppmicroservices::AnyMap
+MakeServiceProperties(cppmicroservices::AnyMap::map_type type)
+{
+    cppmicroservices::AnyMap props(type);
+    props["service.id"] = 42L;
+    props["service.ranking"] = 10;
+    props["service.scope"] = std::string("singleton");
+    props["service.pid"] = std::string("com.acme.pid");
+    props["enabled"] = true;
+    props["load.factor"] = 0.75;
+    props["tenant"] = std::string("tenant-17");
+    props["objectclass"] = std::vector<std::string> { "com::acme::Foo" };
+    return props;
+}
+
+#endif // CPPMICROSERVICES_BENCH_SERVICEPROPERTIES_H
@@ -260,3 +260,144 @@ BENCHMARK_REGISTER_F(ServiceRegistryFixture, ModifyServices)
         {1, 1000}
 })
     ->UseManualTime();
+
+namespace
+{
+    std::shared_ptr<Framework> concurrentLookupFramework;
+    std::vector<ServiceRegistrationU> concurrentLookupRegs;
+} // namespace
+
+/**
+ * Measures how service lookups scale with the number of concurrently
+ * querying threads. Thread 0 sets up the shared framework before the timed
+ * loop starts and tears it down once all threads have finished.
+ */
+static void
+ConcurrentServiceLookup(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        concurrentLookupFramework = std::make_shared<Framework>(FrameworkFactory().NewFramework());
+        concurrentLookupFramework->Start();
+        auto fc = concurrentLookupFramework->GetBundleContext();
+        auto interfaceMap = MakeInterfaceMapWithNInterfaces(10);
+        for (auto i = 100; i > 0; --i)
+        {
+            InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+            concurrentLookupRegs.emplace_back(fc.RegisterService(iMapCopy));
+        }
+    }
+
+    for (auto _ : state)
+    {
+        auto fc = concurrentLookupFramework->GetBundleContext();
+        auto sRef = fc.GetServiceReference("TestInterface1");
+        auto sRefs = fc.GetServiceReferences("TestInterface5");
+        benchmark::DoNotOptimize(sRef);
+        benchmark::DoNotOptimize(sRefs);
+    }
+
+    if (state.thread_index() == 0)
+    {
+        concurrentLookupRegs.clear();
+        concurrentLookupFramework->Stop();
+        concurrentLookupFramework->WaitForStop(std::chrono::milliseconds::zero());
+        concurrentLookupFramework.reset();
+    }
+}
+
+BENCHMARK(ConcurrentServiceLookup)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, RegisterServicesWithListeners)
+(benchmark::State& state)
+{
+    auto fc = framework->GetBundleContext();
+    auto listenerCount = state.range(0);
+    bool const conjunctiveFilters = state.range(1) != 0;
+
+    std::vector<ListenerToken> tokens;
+    for (auto i = listenerCount; i > 0; --i)
+    {
+        // Listeners for other interfaces, which never match the registered service
+        std::string iName { "OtherInterface" + std::to_string(i) };
+        std::string filter = "(" + Constants::OBJECTCLASS + "=" + iName + ")";
+        if (conjunctiveFilters)
+        {
+            filter = "(&" + filter + "(target=" + std::to_string(i) + "))";
+        }
+        tokens.emplace_back(fc.AddServiceListener([](ServiceEvent const&) {}, filter));
+    }
+
+    auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+    for (auto _ : state)
+    {
+        InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+        auto reg = fc.RegisterService(iMapCopy);
+        state.PauseTiming();
+        reg.Unregister();
+        state.ResumeTiming();
+    }
+
+    for (auto& token : tokens)
+    {
+        fc.RemoveListener(std::move(token));
+    }
+}
+
+// first parameter specifies the number of service listeners
+// second parameter specifies whether the listener filters are AND filters with an objectclass term
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, RegisterServicesWithListeners)
+    ->ArgsProduct({
+        {0, 100, 1000, 5000},
+        {0, 1}
+});
+
+BENCHMARK_DEFINE_F(ServiceRegistryFixture, StopBundleWithManyServices)
+(benchmark::State& state)
+{
+    using namespace std::chrono;
+
+    auto fc = framework->GetBundleContext();
+    auto otherCount = state.range(0);
+    auto bundleCount = state.range(1);
+
+    // Services of other bundles, half of which are used by the stopped bundle
+    std::vector<ServiceRegistrationU> otherRegs;
+    auto interfaceMap = MakeInterfaceMapWithNInterfaces(1);
+    for (auto i = otherCount; i > 0; --i)
+    {
+        InterfaceMapPtr iMapCopy(std::make_shared<InterfaceMap>(*interfaceMap));
+        otherRegs.emplace_back(fc.RegisterService(iMapCopy));
+    }
+
+    auto bundle = cppmicroservices::testing::InstallLib(fc, "TestBundleA");
+    for (auto _ : state)
+    {
+        bundle.Start();
+        auto bc = bundle.GetBundleContext();
+        for (auto i = bundleCount; i > 0; --i)
+        {
+            auto reg = bc.RegisterService(MakeInterfaceMapWithNInterfaces(1));
+            US_UNUSED(reg);
+        }
+        for (std::size_t i = 0; i < otherRegs.size(); i += 2)
+        {
+            auto service = bc.GetService(otherRegs[i].GetReference());
+            US_UNUSED(service);
+        }
+
+        auto start = high_resolution_clock::now();
+        bundle.Stop();
+        auto end = high_resolution_clock::now();
+        state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+    }
+}
+
+// first parameter specifies the number of services registered by other bundles
+// second parameter specifies the number of services registered by the stopped bundle
+BENCHMARK_REGISTER_F(ServiceRegistryFixture, StopBundleWithManyServices)
+    ->ArgsProduct({
+        {100, 1000, 10000},
+        {10, 1000}
+})
+    ->UseManualTime();
@@ -8,6 +8,8 @@
 #include <future>
 
 #include "TestUtils.h"
+#include "TestingConfig.h"
+#include "cppmicroservices/util/FileSystem.h"
 #include "benchmark/benchmark.h"
 
 class BundleInstallFixture : public ::benchmark::Fixture
@@ -65,6 +67,64 @@ class BundleInstallFixture : public ::benchmark::Fixture
         framework.WaitForStop(std::chrono::milliseconds::zero());
     }
 
+    void
+    InstallTestBundles(benchmark::State& state, bool batch)
+    {
+        using namespace std::chrono;
+        using namespace cppmicroservices;
+
+        std::vector<std::string> locations;
+        for (auto const& name : { "TestBundleA",
+                                  "TestBundleA2",
+                                  "TestBundleB",
+                                  "TestBundleH",
+                                  "TestBundleLQ",
+                                  "TestBundleM",
+                                  "TestBundleR",
+                                  "TestBundleRA",
+                                  "TestBundleRL",
+                                  "TestBundleS",
+                                  "TestBundleSL1",
+                                  "TestBundleSL3",
+                                  "TestBundleSL4",
+                                  "dummyService",
+                                  "largeBundle" })
+        {
+            locations.push_back(testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + name + US_LIB_POSTFIX
+                                + US_LIB_EXT);
+        }
+
+        auto framework = cppmicroservices::FrameworkFactory().NewFramework();
+        framework.Start();
+        auto context = framework.GetBundleContext();
+        for (auto _ : state)
+        {
+            std::vector<Bundle> bundles;
+            auto start = high_resolution_clock::now();
+            if (batch)
+            {
+                bundles = context.InstallBundles(locations);
+            }
+            else
+            {
+                for (auto const& location : locations)
+                {
+                    auto installed = context.InstallBundles(location);
+                    bundles.insert(bundles.end(), installed.begin(), installed.end());
+                }
+            }
+            auto end = high_resolution_clock::now();
+            state.SetIterationTime(duration_cast<duration<double>>(end - start).count());
+            for (auto& bundle : bundles)
+            {
+                bundle.Uninstall();
+            }
+        }
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
     void
     InstallConcurrently(benchmark::State& state, uint32_t numThreads)
     {
@@ -138,6 +198,14 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, BundleInstallCppFramework)
 BENCHMARK_DEFINE_F(BundleInstallFixture, LargeBundleInstallCppFramework)
 (benchmark::State& state) { InstallWithCppFramework(state, "largeBundle"); }
 
+#ifdef US_BUILD_SHARED_LIBS
+BENCHMARK_DEFINE_F(BundleInstallFixture, SerialTestBundlesInstall)
+(benchmark::State& state) { InstallTestBundles(state, false); }
+
+BENCHMARK_DEFINE_F(BundleInstallFixture, BatchTestBundlesInstall)
+(benchmark::State& state) { InstallTestBundles(state, true); }
+#endif
+
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)
 (benchmark::State& state) { InstallConcurrently(state, 1); }
@@ -157,6 +225,10 @@ BENCHMARK_DEFINE_F(BundleInstallFixture, ConcurrentBundleInstall1ThreadPerBundle
 // Register functions as benchmark
 BENCHMARK_REGISTER_F(BundleInstallFixture, BundleInstallCppFramework)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, LargeBundleInstallCppFramework)->UseManualTime();
+#ifdef US_BUILD_SHARED_LIBS
+BENCHMARK_REGISTER_F(BundleInstallFixture, SerialTestBundlesInstall)->UseManualTime();
+BENCHMARK_REGISTER_F(BundleInstallFixture, BatchTestBundlesInstall)->UseManualTime();
+#endif
 #if defined(PERFORM_LARGE_CONCURRENCY_TEST)
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall1Thread)->UseManualTime();
 BENCHMARK_REGISTER_F(BundleInstallFixture, ConcurrentBundleInstall2Threads)->UseManualTime();
@@ -0,0 +1,100 @@
+#include "benchmark/benchmark.h"
+#include <cppmicroservices/AnyMap.h>
+#include <cppmicroservices/LDAPFilter.h>
+
+#include <string>
+
+using namespace cppmicroservices;
+
+namespace
+{
+    AnyMap
+    MakeProperties(AnyMap::map_type type)
+    {
+        AnyMap props(type);
+        props["Service.Ranking"] = 42;
+        props["load.factor"] = 0.75;
+        props["enabled"] = true;
+        props["tenant"] = std::string("tenant-17");
+        props["description"] = std::string("A Service  Description");
+        props["count"] = 1234567L;
+        return props;
+    }
+
+    // Properties of a component with many configuration properties
+    AnyMap
+    MakeLargeProperties(AnyMap::map_type type)
+    {
+        auto props = MakeProperties(type);
+        for (int i = 0; i < 40; ++i)
+        {
+            props["component.config.property" + std::to_string(i)] = i;
+        }
+        return props;
+    }
+} // namespace
+
+// Evaluate a filter against a property map. The evaluation repeats the same
+// operand conversions and key lookups for every call, which is what makes
+// matching many services against one filter expensive.
+static void
+EvaluateFilter(benchmark::State& state, std::string const& filterString, AnyMap::map_type type)
+{
+    LDAPFilter filter(filterString);
+    auto props = MakeProperties(type);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(filter.Match(props));
+    }
+}
+
+static void
+EvaluateFilterLargeMap(benchmark::State& state, std::string const& filterString, AnyMap::map_type type)
+{
+    LDAPFilter filter(filterString);
+    auto props = MakeLargeProperties(type);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(filter.Match(props));
+    }
+}
+
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  Integral,
+                  std::string("(service.ranking>=10)"),
+                  AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter, Long, std::string("(count=1234567)"), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  Double,
+                  std::string("(load.factor<=0.8)"),
+                  AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter, Bool, std::string("(enabled=TRUE)"), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter, String, std::string("(tenant=tenant-*)"), AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  Approx,
+                  std::string("(description~=a service description)"),
+                  AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  Conjunction,
+                  std::string("(&(service.ranking>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  ConjunctionUnorderedMap,
+                  std::string("(&(SERVICE.RANKING>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::UNORDERED_MAP);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  ConjunctionOrderedMap,
+                  std::string("(&(SERVICE.RANKING>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::ORDERED_MAP);
+BENCHMARK_CAPTURE(EvaluateFilter,
+                  ConjunctionFlatMap,
+                  std::string("(&(SERVICE.RANKING>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::FLAT_MAP);
+BENCHMARK_CAPTURE(EvaluateFilterLargeMap,
+                  ConjunctionUnorderedMap,
+                  std::string("(&(SERVICE.RANKING>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::UNORDERED_MAP);
+BENCHMARK_CAPTURE(EvaluateFilterLargeMap,
+                  ConjunctionFlatMap,
+                  std::string("(&(SERVICE.RANKING>=10)(load.factor<=0.8)(enabled=true)(tenant=tenant-17))"),
+                  AnyMap::FLAT_MAP);
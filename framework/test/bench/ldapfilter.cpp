@@ -30,6 +30,18 @@ ConstructNonTrivialFilterFromString(benchmark::State& state)
     };
 }
 
+static void
+ConstructFilterFromUniqueStrings(benchmark::State& state)
+{
+    // Every filter string is new, so each construction parses the filter
+    // and misses the parsed filter cache.
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        LDAPFilter filter("(plugins_priority=" + std::to_string(i++) + ")");
+    };
+}
+
 LDAPFilter
 GetSimpleLDAPFilter()
 {
@@ -125,12 +137,39 @@ MatchFilterWithServiceReference(benchmark::State& state, Filter filter)
     }
 }
 
+static void
+GetServiceReferencesWithRepeatedFilter(benchmark::State& state)
+{
+    using namespace benchmark::test;
+
+    ScopedFramework scopedFramework;
+    auto context = scopedFramework.framework.GetBundleContext();
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        ServiceProperties props;
+        props["role"] = std::string(i == 0 ? "primary" : "secondary");
+        (void)context.RegisterService<Foo>(std::make_shared<FooImpl>(), props);
+    }
+
+    for (auto _ : state)
+    {
+        auto refs = context.GetServiceReferences<Foo>("(role=primary)");
+        benchmark::DoNotOptimize(refs);
+    }
+
+    auto const stats = LDAPFilter::GetCacheStatistics();
+    state.counters["cache_hits"] = static_cast<double>(stats.hits);
+    state.counters["cache_misses"] = static_cast<double>(stats.misses);
+}
+
 // Register functions as benchmark
 BENCHMARK(ConstructFilterFromString);
 BENCHMARK(ConstructNonTrivialFilterFromString);
+BENCHMARK(ConstructFilterFromUniqueStrings);
 BENCHMARK_CAPTURE(MatchFilterWithAnyMap, Simple, GetSimpleLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithAnyMap, Complex, GetComplexLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithBundle, Simple, GetSimpleLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithBundle, Complex, GetComplexLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithServiceReference, Simple, GetSimpleLDAPFilter());
 BENCHMARK_CAPTURE(MatchFilterWithServiceReference, Complex, GetComplexLDAPFilter());
+BENCHMARK(GetServiceReferencesWithRepeatedFilter)->Arg(1)->Arg(100)->Arg(1000);
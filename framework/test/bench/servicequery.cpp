@@ -1,4 +1,5 @@
 #include <cppmicroservices/BundleContext.h>
+#include <cppmicroservices/Constants.h>
 #include <cppmicroservices/Framework.h>
 #include <cppmicroservices/FrameworkEvent.h>
 #include <cppmicroservices/FrameworkFactory.h>
@@ -103,3 +104,47 @@ BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByInterface);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByClassName);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByClassNameAndLDAPFilter);
 BENCHMARK_REGISTER_F(ServiceFixture, GetAllServiceReferencesByInterfaceAndLDAPFilter);
+
+// Look up one of many services of the same interface by an equality filter on
+// a service property. The first argument selects whether the property is indexed
+// through Constants::FRAMEWORK_SERVICE_INDEXED_PROPERTIES, the second one is the
+// number of registered services.
+static void
+GetServiceReferencesByPropertyValue(benchmark::State& state)
+{
+    using namespace cppmicroservices;
+    using namespace benchmark::test;
+
+    FrameworkConfiguration config;
+    if (state.range(0) != 0)
+    {
+        config[Constants::FRAMEWORK_SERVICE_INDEXED_PROPERTIES] = std::vector<std::string> { "tenant" };
+    }
+    auto framework = FrameworkFactory().NewFramework(config);
+    framework.Start();
+    auto context = framework.GetBundleContext();
+
+    auto const serviceCount = state.range(1);
+    for (int64_t i = 0; i < serviceCount; ++i)
+    {
+        (void)context.RegisterService<Foo>(std::make_shared<FooImpl>(),
+                                           ServiceProperties({
+                                               {"tenant", std::string("tenant") + std::to_string(i)}
+        }));
+    }
+
+    std::string const filter = "(tenant=tenant" + std::to_string(serviceCount / 2) + ")";
+    for (auto _ : state)
+    {
+        auto refs = context.GetServiceReferences<Foo>(filter);
+        benchmark::DoNotOptimize(refs);
+    }
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+BENCHMARK(GetServiceReferencesByPropertyValue)->ArgsProduct({
+    {0, 1},
+    {10, 1000, 10000}
+});
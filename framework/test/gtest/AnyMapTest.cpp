@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "cppmicroservices/AnyMap.h"
 #include "cppmicroservices/GlobalConfig.h"
+#include "cppmicroservices/LDAPFilter.h"
 
 #include "gtest/gtest.h"
 
@@ -272,6 +273,111 @@ TEST(AnyMapTest, CopyAssignment)
     AnyMapTest_CopyAssignment_Helper(AnyMap::UNORDERED_MAP, AnyMap::ORDERED_MAP);
     AnyMapTest_CopyAssignment_Helper(AnyMap::ORDERED_MAP,
                                      AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    AnyMapTest_CopyAssignment_Helper(AnyMap::FLAT_MAP, AnyMap::UNORDERED_MAP);
+    AnyMapTest_CopyAssignment_Helper(AnyMap::UNORDERED_MAP, AnyMap::FLAT_MAP);
+}
+
+TEST(AnyMapTest, FlatMap)
+{
+    AnyMap flat { AnyMap::FLAT_MAP,
+                  { { "service.id", 1 }, { "Objectclass", std::string("A") }, { "b", 2 }, { "a", 3 } } };
+    ASSERT_EQ(AnyMap::FLAT_MAP, flat.GetType());
+    ASSERT_EQ(4, flat.size());
+
+    // lookups are case sensitive
+    ASSERT_EQ(1, flat.count("Objectclass"));
+    ASSERT_EQ(0, flat.count("objectclass"));
+    ASSERT_EQ(3, any_cast<int>(flat.at("a")));
+    ASSERT_THROW(flat.at("A"), std::out_of_range);
+    ASSERT_TRUE(flat.find("service.ID") == flat.end());
+
+    // iteration visits entries in insertion order
+    std::vector<std::string> keys;
+    for (auto const& kv : flat)
+    {
+        keys.push_back(kv.first);
+    }
+    ASSERT_EQ((std::vector<std::string> { "service.id", "Objectclass", "b", "a" }), keys);
+
+    // keys which only differ in case are distinct
+    ASSERT_FALSE(flat.emplace("b", 5).second);
+    ASSERT_TRUE(flat.insert(std::make_pair(std::string("B"), Any(6))).second);
+    ASSERT_EQ(2, any_cast<int>(flat["b"]));
+    ASSERT_EQ(6, any_cast<int>(flat["B"]));
+    flat["c"] = 7;
+    ASSERT_EQ(6, flat.size());
+
+    // erasing keeps the remaining entries and their order intact
+    ASSERT_EQ(0, flat.erase("C"));
+    ASSERT_EQ(1, flat.erase("Objectclass"));
+    ASSERT_EQ(1, flat.erase("c"));
+    keys.clear();
+    for (auto it = flat.cbegin(); it != flat.cend(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+    ASSERT_EQ((std::vector<std::string> { "service.id", "b", "a", "B" }), keys);
+    ASSERT_EQ(2, any_cast<int>(flat.at("b")));
+    ASSERT_EQ(6, any_cast<int>(flat.at("B")));
+
+    AnyMap copy(flat);
+    ASSERT_EQ(flat, copy);
+    copy["a"] = 4;
+    ASSERT_NE(flat, copy);
+
+    AnyMap reordered { AnyMap::FLAT_MAP, { { "B", 6 }, { "a", 3 }, { "b", 2 }, { "service.id", 1 } } };
+    ASSERT_EQ(flat, reordered);
+
+    flat.clear();
+    ASSERT_TRUE(flat.empty());
+    ASSERT_TRUE(flat.begin() == flat.end());
+}
+
+TEST(AnyMapTest, FlatMapIndexed)
+{
+    // large enough for lookups to use the sorted index
+    AnyMap flat(AnyMap::FLAT_MAP);
+    for (int i = 0; i < 100; ++i)
+    {
+        flat["Key" + std::to_string(i)] = i;
+    }
+    flat["key50"] = -50;
+    ASSERT_EQ(101, flat.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i, any_cast<int>(flat.at("Key" + std::to_string(i))));
+    }
+    ASSERT_EQ(-50, any_cast<int>(flat.at("key50")));
+    ASSERT_EQ(0, flat.count("KEY50"));
+    ASSERT_EQ(0, flat.count("Key100"));
+
+    // keys which only differ in case are rejected by filters
+    ASSERT_THROW(LDAPFilter("(KEY7=7)").Match(flat), std::runtime_error);
+    ASSERT_EQ(1, flat.erase("key50"));
+    ASSERT_TRUE(LDAPFilter("(&(KEY7=7)(key99>=99))").Match(flat));
+    ASSERT_FALSE(LDAPFilter("(KEY7=7)").MatchCase(flat));
+    ASSERT_TRUE(LDAPFilter("(Key7=7)").MatchCase(flat));
+
+    ASSERT_EQ(1, flat.erase("Key0"));
+    ASSERT_EQ(99, flat.size());
+    ASSERT_EQ(0, flat.count("Key0"));
+    ASSERT_EQ(1, any_cast<int>(flat.begin()->second));
+    for (int i = 1; i < 100; ++i)
+    {
+        ASSERT_EQ(i, any_cast<int>(flat.at("Key" + std::to_string(i))));
+    }
+}
+
+TEST(AnyMapTest, FlatMapLDAPFilter)
+{
+    AnyMap props { AnyMap::FLAT_MAP, { { "Service.Vendor", std::string("acme") }, { "service.ranking", 5 } } };
+    ASSERT_TRUE(LDAPFilter("(service.vendor=acme)").Match(props));
+    ASSERT_FALSE(LDAPFilter("(service.vendor=acme)").MatchCase(props));
+    ASSERT_TRUE(LDAPFilter("(&(Service.Vendor=acme)(service.ranking>=5))").MatchCase(props));
+
+    props["service.vendor"] = std::string("other");
+    ASSERT_THROW(LDAPFilter("(service.vendor=acme)").Match(props), std::runtime_error);
 }
 
 TEST(AnyMapTest, CIHash)
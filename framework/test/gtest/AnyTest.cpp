@@ -26,6 +26,10 @@ limitations under the License.
 
 #include "gtest/gtest.h"
 
+#include <array>
+#include <string>
+#include <vector>
+
 using namespace cppmicroservices;
 
 // type used to track move vs. copy constructor calls in the AnyMove test
@@ -362,8 +366,133 @@ TEST(AnyTest, AnyMove)
     Any a4 { m1 };
     Any a5 { std::move(m1) };
 
+    // MyType is small and nothrow movable, so it is stored inside the Any and
+    // moving a1 into a3 moves the held value instead of transferring a pointer.
     EXPECT_EQ(4, MyType::defaults);
     EXPECT_EQ(2, MyType::copies);
-    EXPECT_EQ(4, MyType::moves);
-    EXPECT_EQ(3, MyType::dtors);
+    EXPECT_EQ(5, MyType::moves);
+    EXPECT_EQ(4, MyType::dtors);
+}
+
+namespace
+{
+    // a value too large to be stored inside the Any
+    struct LargeType
+    {
+        std::array<char, 256> data {};
+
+        bool
+        operator==(LargeType const& other) const
+        {
+            return data == other.data;
+        }
+    };
+    std::ostream&
+    operator<<(std::ostream& o, LargeType const&)
+    {
+        return o;
+    }
+
+    // a small value which may throw when moved and therefore must live on the heap
+    struct ThrowingMoveType
+    {
+        ThrowingMoveType() = default;
+        ThrowingMoveType(ThrowingMoveType const&) = default;
+        ThrowingMoveType(ThrowingMoveType&&) noexcept(false) {}
+        bool
+        operator==(ThrowingMoveType const&) const
+        {
+            return true;
+        }
+    };
+    std::ostream&
+    operator<<(std::ostream& o, ThrowingMoveType const&)
+    {
+        return o;
+    }
+} // namespace
+
+TEST(AnyTest, AnySize)
+{
+    // the inline storage holds a std::string and its holder's vtable pointer
+    EXPECT_LE(sizeof(Any), 2 * sizeof(void*) + sizeof(std::string));
+}
+
+TEST(AnyTest, StringsAreStoredInline)
+{
+    auto isInline = [](Any const& any, void const* value)
+    {
+        auto begin = reinterpret_cast<char const*>(&any);
+        auto p = static_cast<char const*>(value);
+        return p >= begin && p < begin + sizeof(Any);
+    };
+
+    Any str(std::string("short"));
+    EXPECT_TRUE(isInline(str, any_cast<std::string>(&str)));
+    Any moved(std::move(str));
+    EXPECT_TRUE(isInline(moved, any_cast<std::string>(&moved)));
+    EXPECT_EQ(any_cast<std::string>(moved), "short");
+    Any i(42);
+    EXPECT_TRUE(isInline(i, any_cast<int>(&i)));
+}
+
+TEST(AnyTest, AnySmallAndLargeValues)
+{
+    LargeType large;
+    large.data[0] = 'x';
+
+    std::vector<Any> values { Any(1),
+                              Any(true),
+                              Any(2.5),
+                              Any(std::string("a string which does not fit into the small string buffer")),
+                              Any(std::string("short")),
+                              Any(large),
+                              Any(ThrowingMoveType {}),
+                              Any(std::vector<int> { 1, 2, 3 }) };
+
+    // copies and moves preserve type and value, regardless of where the value is stored
+    for (auto const& value : values)
+    {
+        Any copy(value);
+        EXPECT_EQ(copy.Type(), value.Type());
+        EXPECT_TRUE(copy == value);
+
+        Any moved(std::move(copy));
+        EXPECT_TRUE(copy.Empty());
+        EXPECT_TRUE(moved == value);
+
+        Any assigned;
+        assigned = moved;
+        EXPECT_TRUE(assigned == value);
+        assigned = std::move(moved);
+        EXPECT_TRUE(moved.Empty());
+        EXPECT_TRUE(assigned == value);
+
+        auto& self = assigned;
+        assigned = self;
+        EXPECT_TRUE(assigned == value);
+        assigned = std::move(self);
+        EXPECT_TRUE(assigned == value);
+    }
+
+    // swap every combination of inline and heap allocated values
+    for (auto const& lhsValue : values)
+    {
+        for (auto const& rhsValue : values)
+        {
+            Any lhs(lhsValue);
+            Any rhs(rhsValue);
+            lhs.Swap(rhs);
+            EXPECT_TRUE(lhs == rhsValue);
+            EXPECT_TRUE(rhs == lhsValue);
+        }
+    }
+
+    // references into an Any stay valid until its value is replaced
+    Any str(std::string("short"));
+    str = ref_any_cast<std::string>(str);
+    EXPECT_EQ(any_cast<std::string>(str), "short");
+    any_cast<std::string>(&str)->append(" and long enough to need a heap allocation");
+    EXPECT_EQ(ref_any_cast<std::string>(str), "short and long enough to need a heap allocation");
+    EXPECT_EQ(any_cast<LargeType>(values[5]).data[0], 'x');
 }
@@ -36,7 +36,12 @@
 
 #include "../../src/bundle/BundleManifest.h"
 #include "cppmicroservices/BundleResourceStream.h"
+#include "cppmicroservices/util/BinaryManifest.h"
 
+#include "miniz.h"
+#include <rapidjson/document.h>
+
+#include <cstring>
 #include <iostream>
 
 US_MSVC_PUSH_DISABLE_WARNING(4996)
@@ -216,6 +221,142 @@ TEST_F(BundleManifestTest, ParseManifest)
     ASSERT_EQ(any_cast<std::vector<Any>>(m["list"]).size(), 2ul);
 }
 
+namespace
+{
+    /*
+     * Writes a data-only bundle to location containing the given manifest.json
+     * and, unless empty, the given manifest.bin.
+     */
+    void
+    CreateManifestBundle(std::string const& location,
+                         std::string const& bundleName,
+                         std::string const& manifestJson,
+                         std::string const& binaryManifest)
+    {
+        mz_zip_archive zip;
+        memset(&zip, 0, sizeof(mz_zip_archive));
+        mz_zip_writer_init_file(&zip, location.c_str(), 0);
+        mz_zip_writer_add_mem(&zip, (bundleName + "/").c_str(), nullptr, 0, MZ_NO_COMPRESSION);
+        mz_zip_writer_add_mem(&zip,
+                              (bundleName + "/manifest.json").c_str(),
+                              manifestJson.data(),
+                              manifestJson.size(),
+                              MZ_DEFAULT_COMPRESSION);
+        if (!binaryManifest.empty())
+        {
+            mz_zip_writer_add_mem(&zip,
+                                  (bundleName + "/" + binarymanifest::ENTRY_NAME).c_str(),
+                                  binaryManifest.data(),
+                                  binaryManifest.size(),
+                                  MZ_DEFAULT_COMPRESSION);
+        }
+        mz_zip_writer_finalize_archive(&zip);
+        mz_zip_writer_end(&zip);
+    }
+
+    std::string
+    EncodeManifest(std::string const& manifestJson)
+    {
+        rapidjson::Document doc;
+        doc.Parse(manifestJson.c_str());
+        EXPECT_FALSE(doc.HasParseError());
+        return binarymanifest::Encode(doc);
+    }
+} // namespace
+
+TEST_F(BundleManifestTest, ParseBinaryManifest)
+{
+    std::string const json = R"({
+      "bundle.symbolic_name" : "binary_manifest",
+      "bundle.version" : "1.0.0",
+      "escaped" : "%%value",
+      "number" : 42,
+      "large" : 12345678901,
+      "double" : 0.5,
+      "flag" : true,
+      "nothing" : null,
+      "vector" : [ "first", 2, null ],
+      "map" : { "String" : "hi", "list" : [ 1, 2 ] }
+    })";
+
+    cppmicroservices::testing::TempDir dir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    std::string const jsonLocation = dir.Path + util::DIR_SEP + "json_manifest.zip";
+    std::string const binaryLocation = dir.Path + util::DIR_SEP + "binary_manifest.zip";
+    CreateManifestBundle(jsonLocation, "binary_manifest", json, std::string());
+    CreateManifestBundle(binaryLocation, "binary_manifest", json, EncodeManifest(json));
+
+    auto context = framework.GetBundleContext();
+    auto fromJson = context.InstallBundles(jsonLocation);
+    ASSERT_EQ(fromJson.size(), 1ul);
+    AnyMap const jsonHeaders = fromJson.at(0).GetHeaders();
+    // both bundles have the same symbolic name and version
+    fromJson.at(0).Uninstall();
+    auto fromBinary = context.InstallBundles(binaryLocation);
+    ASSERT_EQ(fromBinary.size(), 1ul);
+
+    // The binary manifest must yield exactly the headers parsed from the JSON
+    auto const& headers = fromBinary.at(0).GetHeaders();
+    ASSERT_EQ(headers.size(), jsonHeaders.size());
+    for (auto const& header : jsonHeaders)
+    {
+        ASSERT_EQ(headers.count(header.first), 1ul) << header.first;
+        EXPECT_EQ(headers.at(header.first).Type(), header.second.Type()) << header.first;
+        EXPECT_EQ(headers.at(header.first).ToJSON(), header.second.ToJSON()) << header.first;
+    }
+
+    EXPECT_THAT(headers.at("escaped").ToString(), ::testing::StrEq("%value"));
+    EXPECT_EQ(any_cast<int>(headers.at("number")), 42);
+    EXPECT_EQ(headers.count("large"), 0ul);
+    EXPECT_EQ(headers.count("nothing"), 0ul);
+    EXPECT_EQ(any_cast<std::vector<Any>>(headers.at("vector")).size(), 2ul);
+    // nested objects keep case insensitive keys
+    EXPECT_THAT(any_cast<AnyMap>(headers.at("map")).at("string").ToString(), ::testing::StrEq("hi"));
+}
+
+TEST_F(BundleManifestTest, PreferBinaryManifest)
+{
+    cppmicroservices::testing::TempDir dir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    std::string const location = dir.Path + util::DIR_SEP + "binary_manifest.zip";
+    CreateManifestBundle(location,
+                         "binary_manifest",
+                         R"({ "bundle.symbolic_name" : "binary_manifest", "source" : "json" })",
+                         EncodeManifest(R"({ "bundle.symbolic_name" : "binary_manifest", "source" : "binary" })"));
+
+    auto bundles = framework.GetBundleContext().InstallBundles(location);
+    ASSERT_EQ(bundles.size(), 1ul);
+    EXPECT_THAT(bundles.at(0).GetHeaders().at("source").ToString(), ::testing::StrEq("binary"));
+}
+
+TEST_F(BundleManifestTest, InvalidBinaryManifestFallsBackToJson)
+{
+    std::string const json = R"({ "bundle.symbolic_name" : "binary_manifest", "source" : "json" })";
+    std::string const encoded = EncodeManifest(json);
+
+    std::string unknownVersion(encoded);
+    unknownVersion[sizeof(binarymanifest::MAGIC)] = static_cast<char>(binarymanifest::VERSION + 1);
+    std::string trailing(encoded);
+    trailing.push_back('\0');
+
+    std::vector<std::string> invalid = { "{}", unknownVersion, trailing, EncodeManifest("[ 1 ]") };
+    // every truncation of a valid manifest is rejected
+    for (std::size_t size = 1; size < encoded.size(); ++size)
+    {
+        invalid.push_back(encoded.substr(0, size));
+    }
+
+    cppmicroservices::testing::TempDir dir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    auto context = framework.GetBundleContext();
+    for (std::size_t i = 0; i < invalid.size(); ++i)
+    {
+        std::string const location = dir.Path + util::DIR_SEP + "binary_manifest_" + std::to_string(i) + ".zip";
+        CreateManifestBundle(location, "binary_manifest", json, invalid[i]);
+        auto bundles = context.InstallBundles(location);
+        ASSERT_EQ(bundles.size(), 1ul);
+        EXPECT_THAT(bundles.at(0).GetHeaders().at("source").ToString(), ::testing::StrEq("json"));
+        bundles.at(0).Uninstall();
+    }
+}
+
 namespace cppmicroservices
 {
 
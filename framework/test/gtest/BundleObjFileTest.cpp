@@ -32,7 +32,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
 
 namespace
 {
@@ -86,6 +89,80 @@ TEST(BundleObjFile, GetRawBundleResourceContainer)
 #endif
 }
 
+#if defined(US_BUILD_SHARED_LIBS) && defined(US_PLATFORM_LINUX)
+namespace
+{
+    void
+    CopyFile(std::string const& from, std::string const& to, std::size_t size = std::string::npos)
+    {
+        std::ifstream in(from, std::ios_base::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(to, std::ios_base::binary | std::ios_base::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(std::min(size, content.size())));
+    }
+} // namespace
+
+TEST(BundleObjFile, SharesResourcesOfUnchangedFile)
+{
+    auto first = cppmicroservices::BundleObjFactory().CreateBundleFileObj(testBundlePath);
+    auto second = cppmicroservices::BundleObjFactory().CreateBundleFileObj(testBundlePath);
+    auto data = first->GetRawBundleResourceContainer();
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data, second->GetRawBundleResourceContainer());
+
+    std::string const content(static_cast<char const*>(data->GetData()), data->GetSize());
+    first.reset();
+    second.reset();
+    data.reset();
+
+    // once released, the resources are mapped again from the remembered location
+    auto third = cppmicroservices::BundleObjFactory().CreateBundleFileObj(testBundlePath);
+    auto remapped = third->GetRawBundleResourceContainer();
+    ASSERT_TRUE(remapped);
+    EXPECT_EQ(content, std::string(static_cast<char const*>(remapped->GetData()), remapped->GetSize()));
+}
+
+TEST(BundleObjFile, DetectsReplacedFile)
+{
+    std::string const appendedBundlePath = cppmicroservices::testing::LIB_PATH + cppmicroservices::util::DIR_SEP
+                                           + US_LIB_PREFIX + "TestBundleA" + US_LIB_POSTFIX + US_LIB_EXT;
+    cppmicroservices::testing::TempDir dir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    std::string const location = dir.Path + cppmicroservices::util::DIR_SEP + "bundle" + US_LIB_EXT;
+    std::string const staged = location + ".staged";
+
+    CopyFile(testBundlePath, location);
+    auto linked = cppmicroservices::BundleObjFactory().CreateBundleFileObj(location);
+    ASSERT_TRUE(linked->GetRawBundleResourceContainer());
+
+    // replace the file with a bundle without a resource section
+    CopyFile(appendedBundlePath, staged);
+    ASSERT_EQ(0, std::rename(staged.c_str(), location.c_str()));
+    auto appended = cppmicroservices::BundleObjFactory().CreateBundleFileObj(location);
+    EXPECT_FALSE(appended->GetRawBundleResourceContainer());
+
+    // and back again
+    CopyFile(testBundlePath, staged);
+    ASSERT_EQ(0, std::rename(staged.c_str(), location.c_str()));
+    auto relinked = cppmicroservices::BundleObjFactory().CreateBundleFileObj(location);
+    EXPECT_TRUE(relinked->GetRawBundleResourceContainer());
+}
+
+TEST(BundleObjFile, TruncatedElfFile)
+{
+    cppmicroservices::testing::TempDir dir(cppmicroservices::testing::MakeUniqueTempDirectory());
+    std::string const location = dir.Path + cppmicroservices::util::DIR_SEP + "truncated" + US_LIB_EXT;
+
+    // the ELF header refers to section headers beyond the end of the file
+    CopyFile(testBundlePath, location, 128);
+    EXPECT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(location),
+                 cppmicroservices::InvalidObjFileException);
+
+    CopyFile(testBundlePath, location, 8);
+    EXPECT_THROW(cppmicroservices::BundleObjFactory().CreateBundleFileObj(location),
+                 cppmicroservices::InvalidObjFileException);
+}
+#endif
+
 #if defined(US_BUILD_SHARED_LIBS)
 #    if defined(US_PLATFORM_APPLE) || defined(US_PLATFORM_POSIX)
 TEST(BundleObjFile, MappedFile)
@@ -21,6 +21,8 @@ limitations under the License.
 =============================================================================*/
 
 #include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/BundleEvent.h"
+#include "cppmicroservices/Constants.h"
 #include "cppmicroservices/Framework.h"
 #include "cppmicroservices/FrameworkEvent.h"
 #include "cppmicroservices/FrameworkFactory.h"
@@ -106,6 +108,74 @@ namespace
         framework.WaitForStop(std::chrono::milliseconds::zero());
     }
 
+    TEST(BundleRegistryConcurrencyTest, testBatchInstall)
+    {
+        FrameworkFactory factory;
+        auto framework = factory.NewFramework();
+        framework.Start();
+        auto bc = framework.GetBundleContext();
+
+        auto libPath = [](std::string const& bundleName) {
+            return cppmicroservices::testing::LIB_PATH + util::DIR_SEP + US_LIB_PREFIX + bundleName + US_LIB_POSTFIX
+                   + US_LIB_EXT;
+        };
+        auto alreadyInstalled = bc.InstallBundles(libPath("TestBundleH"));
+        ASSERT_EQ(alreadyInstalled.size(), 1u);
+
+        std::vector<std::string> const names
+            = { "TestBundleA", "TestBundleRL", "TestBundleH", "TestBundleM", "TestBundleA", "TestBundleS" };
+        std::vector<std::string> locations;
+        for (auto const& name : names)
+        {
+            locations.push_back(libPath(name));
+        }
+
+        std::vector<std::string> installedEvents;
+        auto token = bc.AddBundleListener(
+            [&installedEvents](BundleEvent const& event)
+            {
+                if (event.GetType() == BundleEvent::BUNDLE_INSTALLED)
+                {
+                    installedEvents.push_back(event.GetBundle().GetSymbolicName());
+                }
+            });
+
+        auto bundles = bc.InstallBundles(locations);
+        bc.RemoveListener(std::move(token));
+
+        // One bundle per location, in the order of the locations
+        ASSERT_EQ(bundles.size(), names.size());
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            ASSERT_EQ(bundles[i].GetSymbolicName(), names[i]);
+            ASSERT_EQ(bundles[i].GetLocation(), locations[i]);
+        }
+        ASSERT_EQ(bundles[2], alreadyInstalled.front());
+        ASSERT_EQ(bundles[4], bundles[0]);
+
+        // New bundles are installed, and announced, in the order of their locations
+        std::vector<std::string> const expectedEvents = { "TestBundleA", "TestBundleRL", "TestBundleM", "TestBundleS" };
+        ASSERT_EQ(installedEvents, expectedEvents);
+        ASSERT_LT(bundles[0].GetBundleId(), bundles[1].GetBundleId());
+        ASSERT_LT(bundles[1].GetBundleId(), bundles[3].GetBundleId());
+        ASSERT_LT(bundles[3].GetBundleId(), bundles[5].GetBundleId());
+
+        // The manifests read ahead of the install are the ones of the bundles
+        ASSERT_EQ(bundles[0].GetHeaders().at(Constants::BUNDLE_SYMBOLICNAME).ToString(), "TestBundleA");
+        for (auto& b : bundles)
+        {
+            EXPECT_NO_THROW(b.Start());
+        }
+
+        // A failing location stops the install, the preceding ones stay installed
+        EXPECT_THROW(bc.InstallBundles(std::vector<std::string> { libPath("TestBundleRA"), "/non/existing/bundle" }),
+                     std::runtime_error);
+        EXPECT_FALSE(bc.GetBundles(libPath("TestBundleRA")).empty());
+
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
 #    ifdef US_ENABLE_THREADING_SUPPORT
     TEST(BundleRegistryConcurrencyTest, testConcurrent)
     {
@@ -29,6 +29,10 @@ limitations under the License.
 #include "cppmicroservices/FrameworkFactory.h"
 
 #include "gtest/gtest.h"
+#include <atomic>
+#include <iterator>
+#include <string_view>
+#include <thread>
 #include <unordered_set>
 
 using namespace cppmicroservices;
@@ -434,6 +438,114 @@ TEST_F(BundleResourceTest, testCompressedResource)
     ASSERT_TRUE(bmp.eof());
 }
 
+TEST_F(BundleResourceTest, testMappedResource)
+{
+    // TestBundleRL links its resources into the library and embeds foo.txt
+    // without compression
+    auto testBundleRL = cppmicroservices::testing::InstallLib(context, "TestBundleRL");
+    BundleResource foo = testBundleRL.GetResource("foo.txt");
+    ASSERT_TRUE(foo.IsValid());
+    ASSERT_EQ(foo.GetSize(), foo.GetCompressedSize());
+
+    std::string_view mapped = foo.GetMappedData();
+    ASSERT_EQ(mapped.size(), static_cast<std::size_t>(foo.GetSize()));
+
+    std::ifstream fooFile(US_FRAMEWORK_SOURCE_DIR "/test/bundles/libRWithLinkedResources/resources/foo.txt",
+                          std::ifstream::in | std::ifstream::binary);
+    ASSERT_TRUE(fooFile.is_open());
+    std::string const fileData((std::istreambuf_iterator<char>(fooFile)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(mapped, fileData);
+
+    // the view is stable across calls and copies of the resource
+    BundleResource fooCopy(foo);
+    ASSERT_EQ(fooCopy.GetMappedData().data(), mapped.data());
+
+    // streams over stored resources read the same data
+    BundleResourceStream rs(foo, std::ios_base::binary);
+    std::string const streamData((std::istreambuf_iterator<char>(rs)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(streamData, fileData);
+
+    // the mapping outlives the bundle
+    testBundleRL.Uninstall();
+    ASSERT_EQ(mapped, fileData);
+}
+
+TEST_F(BundleResourceTest, testMappedResourceRequiresStoredEntry)
+{
+    auto testBundleRL = cppmicroservices::testing::InstallLib(context, "TestBundleRL");
+
+    // compressed resources cannot be mapped
+    BundleResource foo2 = testBundleRL.GetResource("foo2.txt");
+    ASSERT_TRUE(foo2.IsValid());
+    ASSERT_NE(foo2.GetSize(), foo2.GetCompressedSize());
+    ASSERT_TRUE(foo2.GetMappedData().empty());
+
+    std::string content;
+    std::getline(BundleResourceStream(foo2), content);
+    ASSERT_EQ(content, "afoo andasf");
+
+    ASSERT_TRUE(testBundleRL.GetResource("/").GetMappedData().empty());
+    ASSERT_TRUE(BundleResource().GetMappedData().empty());
+
+    // resources appended to the library are not memory mapped
+    BundleResource png = testBundle.GetResource("/icons/cppmicroservices.png");
+    ASSERT_TRUE(png.IsValid());
+    ASSERT_TRUE(png.GetMappedData().empty());
+}
+
+#ifdef US_ENABLE_THREADING_SUPPORT
+TEST_F(BundleResourceTest, testConcurrentResourceReads)
+{
+    // TestBundleR appends its resources to the library whereas TestBundleRL
+    // links them into it, covering both the file based and the memory mapped
+    // resource container.
+    auto testBundleRL = cppmicroservices::testing::InstallLib(context, "TestBundleRL");
+    std::vector<BundleResource> resources { testBundle.GetResource("/icons/compressable.bmp"),
+                                            testBundle.GetResource("/foo.ptxt"),
+                                            testBundleRL.GetResource("/foo.txt"),
+                                            testBundleRL.GetResource("/foo2.txt") };
+
+    auto readAll = [](BundleResource const& res)
+    {
+        BundleResourceStream rs(res, std::ios_base::binary);
+        return std::string((std::istreambuf_iterator<char>(rs)), std::istreambuf_iterator<char>());
+    };
+
+    std::vector<std::string> expected;
+    for (auto const& res : resources)
+    {
+        ASSERT_TRUE(res.IsValid());
+        expected.push_back(readAll(res));
+        ASSERT_EQ(expected.back().size(), static_cast<std::size_t>(res.GetSize()));
+    }
+
+    std::atomic<int> mismatches { 0 };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (int j = 0; j < 20; ++j)
+                {
+                    for (std::size_t k = 0; k < resources.size(); ++k)
+                    {
+                        if (readAll(resources[k]) != expected[k])
+                        {
+                            ++mismatches;
+                        }
+                    }
+                }
+            });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    ASSERT_EQ(mismatches, 0);
+}
+#endif
+
 TEST_F(BundleResourceTest, testResources)
 {
     BundleResource foo = testBundle.GetResource("foo.ptxt");
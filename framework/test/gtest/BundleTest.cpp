@@ -31,6 +31,7 @@
 #include "cppmicroservices/GetBundleContext.h"
 #include "cppmicroservices/ListenerToken.h"
 #include "cppmicroservices/ServiceEvent.h"
+#include "cppmicroservices/ServiceFactory.h"
 
 #include "cppmicroservices/util/FileSystem.h"
 #include "cppmicroservices/util/String.h"
@@ -41,6 +42,7 @@
 #include "TestUtils.h"
 #include "TestingConfig.h"
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <thread>
@@ -889,6 +891,132 @@ TEST_F(BundleTest, TestBundleActivatorFailures)
     // Test that the bundle is not active after a failed start
     ASSERT_EQ(Bundle::State::STATE_RESOLVED, bundleStartFail.GetState());
 }
+
+namespace
+{
+    struct LazyTestService
+    {
+        virtual ~LazyTestService() = default;
+    };
+
+    class LazyTestServiceFactory : public ServiceFactory
+    {
+      public:
+        InterfaceMapConstPtr
+        GetService(Bundle const&, ServiceRegistrationBase const&) override
+        {
+            return MakeInterfaceMap<LazyTestService>(std::make_shared<LazyTestService>());
+        }
+
+        void
+        UngetService(Bundle const&, ServiceRegistrationBase const&, InterfaceMapConstPtr const&) override
+        {
+        }
+    };
+} // namespace
+
+// Test that a bundle with a lazy activation policy is activated when a service
+// registered on its behalf is first got.
+TEST_F(BundleTest, TestLazyActivation)
+{
+    AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    headers[Constants::BUNDLE_SYMBOLICNAME] = std::string("TestBundleA");
+    headers[Constants::BUNDLE_ACTIVATOR] = true;
+    headers[Constants::BUNDLE_ACTIVATIONPOLICY] = Constants::ACTIVATION_LAZY;
+    AnyMap manifest(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    manifest["TestBundleA"] = headers;
+    auto bundle = InstallLib(context, "TestBundleA", manifest);
+
+    std::vector<BundleEvent::Type> events;
+    auto token = context.AddBundleListener(
+        [&events, &bundle](BundleEvent const& event)
+        {
+            if (event.GetBundle() == bundle)
+            {
+                events.push_back(event.GetType());
+            }
+        });
+    auto hasEvent = [&events](BundleEvent::Type type)
+    { return std::find(events.begin(), events.end(), type) != events.end(); };
+
+    bundle.Start(Bundle::START_ACTIVATION_POLICY);
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+    ASSERT_TRUE(hasEvent(BundleEvent::BUNDLE_LAZY_ACTIVATION));
+    ASSERT_FALSE(hasEvent(BundleEvent::BUNDLE_STARTING));
+    // The bundle activator, which registers a service, did not run
+    ASSERT_TRUE(bundle.GetRegisteredServices().empty());
+
+    // Register a service factory on behalf of the bundle, as Declarative Services does
+    auto reg = bundle.GetBundleContext().RegisterService<LazyTestService>(
+        ToFactory(std::make_shared<LazyTestServiceFactory>()));
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+    auto ref = context.GetServiceReference<LazyTestService>();
+    ASSERT_TRUE(context.GetService(ref));
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_EQ(bundle.GetRegisteredServices().size(), 2u);
+
+    // A bundle waiting for its activation is stopped without calling its activator
+    bundle.Stop();
+    bundle.Start(Bundle::START_ACTIVATION_POLICY);
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_STARTING);
+    bundle.Stop();
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_RESOLVED);
+
+    // Starting the bundle eagerly activates it
+    bundle.Start(Bundle::START_ACTIVATION_POLICY);
+    bundle.Start();
+    ASSERT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+
+    context.RemoveListener(std::move(token));
+}
+
+// Test that getting a service of a bundle waiting for its lazy activation does
+// not activate it while the framework is shutting down.
+TEST(BundleLazyActivationTest, NoLazyActivationDuringFrameworkShutdown)
+{
+    auto framework = FrameworkFactory().NewFramework();
+    framework.Start();
+    auto context = framework.GetBundleContext();
+
+    AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    headers[Constants::BUNDLE_SYMBOLICNAME] = std::string("TestBundleA");
+    headers[Constants::BUNDLE_ACTIVATOR] = true;
+    headers[Constants::BUNDLE_ACTIVATIONPOLICY] = Constants::ACTIVATION_LAZY;
+    AnyMap manifest(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    manifest["TestBundleA"] = headers;
+    auto lazyBundle = InstallLib(context, "TestBundleA", manifest);
+    // Installed last, so it is stopped first
+    auto bundle = InstallLib(context, "TestBundleB");
+    bundle.Start();
+    lazyBundle.Start(Bundle::START_ACTIVATION_POLICY);
+    auto reg = lazyBundle.GetBundleContext().RegisterService<LazyTestService>(
+        ToFactory(std::make_shared<LazyTestServiceFactory>()));
+
+    bool gotReference = false;
+    bool lazyBundleStarted = false;
+    auto token = context.AddBundleListener(
+        [&](BundleEvent const& event)
+        {
+            if (event.GetBundle() == lazyBundle && event.GetType() == BundleEvent::BUNDLE_STARTED)
+            {
+                lazyBundleStarted = true;
+            }
+            else if (event.GetBundle() == bundle && event.GetType() == BundleEvent::BUNDLE_STOPPING)
+            {
+                if (auto ref = context.GetServiceReference<LazyTestService>())
+                {
+                    gotReference = true;
+                    context.GetService(ref);
+                }
+            }
+        });
+    ASSERT_TRUE(token);
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+    ASSERT_TRUE(gotReference);
+    ASSERT_FALSE(lazyBundleStarted);
+}
 #endif
 
 TEST_F(BundleTest, TestBundleStreamOperator)
@@ -21,6 +21,7 @@ limitations under the License.
 =============================================================================*/
 
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <future>
 #include <mutex>
@@ -312,6 +313,378 @@ TEST(FrameworkTest, TempDataDirIsNotCreatedWhenFrameworkStarts)
     framework.WaitForStop(std::chrono::milliseconds::zero());
 }
 
+TEST(FrameworkTest, PersistentBundleStorage)
+{
+    TempDir frameworkStorage = MakeUniqueTempDirectory();
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(frameworkStorage);
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_PERSISTENT] = true;
+
+    long bundleId = -1;
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(framework.Start(););
+        auto bundle = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA");
+        ASSERT_TRUE(bundle);
+        bundle.Start();
+        bundleId = bundle.GetBundleId();
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    // The installed bundle and its autostart setting are restored
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(framework.Start(););
+        auto bundle = framework.GetBundleContext().GetBundle(bundleId);
+        ASSERT_TRUE(bundle);
+        ASSERT_EQ(bundle.GetSymbolicName(), "TestBundleA");
+        ASSERT_EQ(bundle.GetState(), Bundle::STATE_ACTIVE);
+        ASSERT_FALSE(bundle.GetHeaders().empty());
+
+        // Installing the same location again returns the restored bundle
+        auto bundles = framework.GetBundleContext().InstallBundles(bundle.GetLocation());
+        ASSERT_EQ(bundles.size(), 1u);
+        ASSERT_EQ(bundles.front().GetBundleId(), bundleId);
+
+        // Bundles installed later get new ids
+        auto bundleB = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleB");
+        ASSERT_GT(bundleB.GetBundleId(), bundleId);
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    // Cleaning the storage on the first init discards the recorded bundles
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_CLEAN] = Constants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT;
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(framework.Start(););
+        ASSERT_FALSE(framework.GetBundleContext().GetBundle(bundleId));
+        for (auto const& b : framework.GetBundleContext().GetBundles())
+        {
+            ASSERT_NE(b.GetSymbolicName(), "TestBundleA");
+            ASSERT_NE(b.GetSymbolicName(), "TestBundleB");
+        }
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+}
+
+TEST(FrameworkTest, PersistentBundleStorageIsWrittenOnChange)
+{
+    TempDir frameworkStorage = MakeUniqueTempDirectory();
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(frameworkStorage);
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_PERSISTENT] = true;
+
+    // The changes made with the first framework are restored by the second
+    // one, although the first framework was not stopped yet.
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start(););
+    auto bundleA = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA");
+    auto bundleB = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleB");
+    bundleA.Start();
+    bundleB.Uninstall();
+    {
+        auto restored = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(restored.Start(););
+        auto restoredA = restored.GetBundleContext().GetBundle(bundleA.GetBundleId());
+        ASSERT_TRUE(restoredA);
+        ASSERT_EQ(restoredA.GetState(), Bundle::STATE_ACTIVE);
+        ASSERT_FALSE(restored.GetBundleContext().GetBundle(bundleB.GetBundleId()));
+        restored.Stop();
+        restored.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    bundleA.Stop();
+    {
+        auto restored = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(restored.Start(););
+        auto restoredA = restored.GetBundleContext().GetBundle(bundleA.GetBundleId());
+        ASSERT_TRUE(restoredA);
+        ASSERT_NE(restoredA.GetState(), Bundle::STATE_ACTIVE);
+        restored.Stop();
+        restored.WaitForStop(std::chrono::milliseconds::zero());
+    }
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, PersistentBundleStorageRestoresManifests)
+{
+    TempDir frameworkStorage = MakeUniqueTempDirectory();
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(frameworkStorage);
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_PERSISTENT] = true;
+
+    AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    headers[Constants::BUNDLE_SYMBOLICNAME] = std::string("TestBundleA");
+    headers["escaped"] = std::string("%value");
+    headers["long"] = 12345678901L;
+    headers["ordered"] = std::map<std::string, Any> { { "b", 1 }, { "a", std::string("x") } };
+    AnyMap nested(AnyMap::ORDERED_MAP);
+    nested["Key"] = std::vector<Any> { 1, 2.5, true };
+    headers["nested"] = nested;
+    AnyMap manifest(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+    manifest["TestBundleA"] = headers;
+
+    long bundleId = -1;
+    {
+        auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(framework.Start(););
+        bundleId = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA", manifest)
+                       .GetBundleId();
+        framework.Stop();
+        framework.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    // The injected manifest is restored with the same values and types
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start(););
+    auto bundle = framework.GetBundleContext().GetBundle(bundleId);
+    ASSERT_TRUE(bundle);
+    auto const& restored = bundle.GetHeaders();
+    ASSERT_EQ(restored.size(), headers.size());
+    for (auto const& header : headers)
+    {
+        ASSERT_EQ(restored.count(header.first), 1ul) << header.first;
+        EXPECT_EQ(restored.at(header.first).Type(), header.second.Type()) << header.first;
+        EXPECT_EQ(restored.at(header.first).ToJSON(), header.second.ToJSON()) << header.first;
+    }
+    EXPECT_EQ(any_cast<AnyMap>(restored.at("nested")).GetType(), AnyMap::ORDERED_MAP);
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, PersistentBundleStorageJournal)
+{
+    TempDir frameworkStorage = MakeUniqueTempDirectory();
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_STORAGE] = static_cast<std::string>(frameworkStorage);
+    frameworkConfig[Constants::FRAMEWORK_STORAGE_PERSISTENT] = true;
+    std::string const storageFile = static_cast<std::string>(frameworkStorage) + util::DIR_SEP + "bundles"
+                                    + util::DIR_SEP + "archives.dat";
+    auto fileSize = [&storageFile]()
+    {
+        std::ifstream in(storageFile, std::ios_base::binary | std::ios_base::ate);
+        return static_cast<std::streamoff>(in.tellg());
+    };
+
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start(););
+    auto bundleA = cppmicroservices::testing::InstallLib(framework.GetBundleContext(), "TestBundleA");
+    bundleA.Start();
+    auto size = fileSize();
+
+    // Changes are appended, and the file is rewritten once most of its
+    // records are superseded, so its size stays bounded.
+    for (int i = 0; i < 500; ++i)
+    {
+        bundleA.Stop();
+        bundleA.Start();
+    }
+    ASSERT_LT(fileSize(), size + 200 * 32);
+
+    // A record torn by a crash is ignored
+    {
+        std::ofstream out(storageFile, std::ios_base::binary | std::ios_base::app);
+        out << "torn record";
+    }
+    {
+        auto restored = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(restored.Start(););
+        auto restoredA = restored.GetBundleContext().GetBundle(bundleA.GetBundleId());
+        ASSERT_TRUE(restoredA);
+        ASSERT_EQ(restoredA.GetState(), Bundle::STATE_ACTIVE);
+        restored.Stop();
+        restored.WaitForStop(std::chrono::milliseconds::zero());
+    }
+
+    // The file was rewritten without the torn record, so later changes are
+    // restored again
+    bundleA.Stop();
+    {
+        auto restored = FrameworkFactory().NewFramework(frameworkConfig);
+        ASSERT_NO_THROW(restored.Start(););
+        auto restoredA = restored.GetBundleContext().GetBundle(bundleA.GetBundleId());
+        ASSERT_TRUE(restoredA);
+        ASSERT_NE(restoredA.GetState(), Bundle::STATE_ACTIVE);
+        restored.Stop();
+        restored.WaitForStop(std::chrono::milliseconds::zero());
+    }
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+#ifdef US_BUILD_SHARED_LIBS
+TEST(FrameworkTest, ConcurrentBundleActivation)
+{
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_BUNDLE_ACTIVATION_THREADS] = 4;
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start(););
+    auto context = framework.GetBundleContext();
+
+    // TestBundleA starts after TestBundleH, which starts after TestBundleM
+    auto install = [&context](std::string const& name, Any const& startAfter)
+    {
+        AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        headers[Constants::BUNDLE_SYMBOLICNAME] = name;
+        headers[Constants::BUNDLE_ACTIVATOR] = true;
+        if (!startAfter.Empty())
+        {
+            headers[Constants::BUNDLE_STARTAFTER] = startAfter;
+        }
+        AnyMap manifest(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        manifest[name] = headers;
+        return cppmicroservices::testing::InstallLib(context, name, manifest);
+    };
+    std::vector<Bundle> bundles { install("TestBundleA", std::vector<Any> { std::string("TestBundleH") }),
+                                  install("TestBundleH", std::string("TestBundleM")),
+                                  install("TestBundleM", Any()) };
+
+    std::mutex eventsMutex;
+    std::vector<std::string> started;
+    std::vector<std::string> stopping;
+    auto bundleToken = context.AddBundleListener(
+        [&](BundleEvent const& event)
+        {
+            std::lock_guard<std::mutex> lock(eventsMutex);
+            if (event.GetType() == BundleEvent::BUNDLE_STARTED)
+            {
+                started.push_back(event.GetBundle().GetSymbolicName());
+            }
+            else if (event.GetType() == BundleEvent::BUNDLE_STOPPING && event.GetBundle() != framework)
+            {
+                stopping.push_back(event.GetBundle().GetSymbolicName());
+            }
+        });
+    std::size_t timings = 0;
+    auto frameworkToken = context.AddFrameworkListener(
+        [&](FrameworkEvent const& event)
+        {
+            std::lock_guard<std::mutex> lock(eventsMutex);
+            if (event.GetType() == FrameworkEvent::FRAMEWORK_INFO
+                && event.GetMessage().find(" started in ") != std::string::npos)
+            {
+                ++timings;
+            }
+        });
+
+    ASSERT_NO_THROW(framework.StartBundles(bundles));
+    for (auto const& b : bundles)
+    {
+        ASSERT_EQ(b.GetState(), Bundle::STATE_ACTIVE);
+    }
+    std::vector<std::string> const startOrder { "TestBundleM", "TestBundleH", "TestBundleA" };
+    ASSERT_EQ(started, startOrder);
+    ASSERT_EQ(timings, bundles.size());
+    context.RemoveListener(std::move(frameworkToken));
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+    std::vector<std::string> const stopOrder { "TestBundleA", "TestBundleH", "TestBundleM" };
+    ASSERT_EQ(stopping, stopOrder);
+    US_UNUSED(bundleToken);
+}
+
+TEST(FrameworkTest, StartBundlesReportsFirstFailure)
+{
+    auto framework = FrameworkFactory().NewFramework();
+    ASSERT_NO_THROW(framework.Start(););
+    auto context = framework.GetBundleContext();
+    auto bundleA = cppmicroservices::testing::InstallLib(context, "TestBundleA");
+    auto startFail = cppmicroservices::testing::InstallLib(context, "TestBundleStartFail");
+    ASSERT_TRUE(startFail);
+
+    ASSERT_THROW(framework.StartBundles({ startFail, bundleA }), std::runtime_error);
+    // The bundles after the failing one are still started
+    ASSERT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_THROW(framework.StartBundles({ Bundle() }), std::invalid_argument);
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
+TEST(FrameworkTest, StartLevels)
+{
+    FrameworkConfiguration frameworkConfig;
+    frameworkConfig[Constants::FRAMEWORK_BEGINNING_STARTLEVEL] = 2;
+    auto framework = FrameworkFactory().NewFramework(frameworkConfig);
+    ASSERT_NO_THROW(framework.Start(););
+    ASSERT_EQ(framework.GetStartLevel(), 2u);
+    auto context = framework.GetBundleContext();
+
+    auto install = [&context](std::string const& name, int startLevel)
+    {
+        AnyMap headers(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        headers[Constants::BUNDLE_SYMBOLICNAME] = name;
+        headers[Constants::BUNDLE_ACTIVATOR] = true;
+        headers[Constants::BUNDLE_STARTLEVEL] = startLevel;
+        AnyMap manifest(AnyMap::UNORDERED_MAP_CASEINSENSITIVE_KEYS);
+        manifest[name] = headers;
+        return cppmicroservices::testing::InstallLib(context, name, manifest);
+    };
+    auto bundleA = install("TestBundleA", 1);
+    auto bundleH = install("TestBundleH", 2);
+    auto bundleM = install("TestBundleM", 3);
+
+    std::mutex levelsMutex;
+    std::condition_variable levelsChanged;
+    std::vector<std::string> levels;
+    auto token = context.AddFrameworkListener(
+        [&](FrameworkEvent const& event)
+        {
+            if (event.GetType() == FrameworkEvent::FRAMEWORK_STARTLEVEL_CHANGED)
+            {
+                std::lock_guard<std::mutex> lock(levelsMutex);
+                levels.push_back(event.GetMessage());
+                levelsChanged.notify_all();
+            }
+        });
+    auto waitForLevels = [&](std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(levelsMutex);
+        return levelsChanged.wait_for(lock, std::chrono::seconds(30), [&] { return levels.size() >= count; });
+    };
+
+    bundleA.Start();
+    bundleH.Start();
+    bundleM.Start();
+    ASSERT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_EQ(bundleH.GetState(), Bundle::STATE_ACTIVE);
+    // Marked to be started, but above the active start level
+    ASSERT_NE(bundleM.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_THROW(bundleM.Start(Bundle::START_TRANSIENT), std::runtime_error);
+
+    framework.SetStartLevel(3);
+    ASSERT_TRUE(waitForLevels(1));
+    ASSERT_EQ(framework.GetStartLevel(), 3u);
+    ASSERT_EQ(bundleM.GetState(), Bundle::STATE_ACTIVE);
+
+    framework.SetStartLevel(1);
+    ASSERT_TRUE(waitForLevels(3));
+    ASSERT_EQ(framework.GetStartLevel(), 1u);
+    ASSERT_EQ(bundleA.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_NE(bundleH.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_NE(bundleM.GetState(), Bundle::STATE_ACTIVE);
+
+    // Lowering the start level keeps the autostart setting of the bundles
+    framework.SetStartLevel(3);
+    ASSERT_TRUE(waitForLevels(5));
+    ASSERT_EQ(bundleH.GetState(), Bundle::STATE_ACTIVE);
+    ASSERT_EQ(bundleM.GetState(), Bundle::STATE_ACTIVE);
+    std::vector<std::string> const expectedLevels { "Start level 3", "Start level 2", "Start level 1",
+                                                    "Start level 2", "Start level 3" };
+    ASSERT_EQ(levels, expectedLevels);
+    ASSERT_THROW(framework.SetStartLevel(0), std::invalid_argument);
+
+    context.RemoveListener(std::move(token));
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+#endif
+
 TEST(FrameworkTest, DefaultLogSink)
 {
     FrameworkConfiguration configuration;
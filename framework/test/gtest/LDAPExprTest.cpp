@@ -207,6 +207,41 @@ TEST(LDAPExprTest, CompareString)
     props.clear();
     props["name"] = std::string("MICRO");
     ASSERT_TRUE(ldapMatch.Match(props));
+
+    // Whitespace and case are ignored on both sides of an approx. filter
+    ldapMatch = LDAPFilter("(name~=Micro Services)");
+    props["name"] = std::string(" micro   SERVICES ");
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["name"] = std::string("microservice");
+    ASSERT_FALSE(ldapMatch.Match(props));
+    props["name"] = std::string("microservicess");
+    ASSERT_FALSE(ldapMatch.Match(props));
+}
+
+TEST(LDAPExprTest, CompareReusedOperand)
+{
+    // The operand of a filter is converted once, and must give the same
+    // results for property values of different types.
+    LDAPFilter ldapMatch("(val=1)");
+    AnyMap props(AnyMap::ORDERED_MAP);
+    props["VAL"] = 1;
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["VAL"] = 1.0;
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["VAL"] = std::string("1");
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["VAL"] = std::vector<Any> { std::string("0"), 1L };
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["VAL"] = true;
+    ASSERT_FALSE(ldapMatch.Match(props));
+
+    ldapMatch = LDAPFilter("(val=TRUE)");
+    props["VAL"] = true;
+    ASSERT_TRUE(ldapMatch.Match(props));
+    props["VAL"] = false;
+    ASSERT_FALSE(ldapMatch.Match(props));
+    props["VAL"] = 1;
+    ASSERT_FALSE(ldapMatch.Match(props));
 }
 
 TEST(LDAPExprTest, PatSubstr)
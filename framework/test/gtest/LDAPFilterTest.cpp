@@ -168,3 +168,37 @@ TEST(LDAPFilter, TestEvaluate)
     props["prop"] = std::string("foo(bar)");
     ASSERT_TRUE(ldap.Match(props));
 }
+
+TEST(LDAPFilter, CacheStatistics)
+{
+    const std::string filterStr = "(ldapFilterCacheTest=CacheStatistics)";
+
+    LDAPFilter first(filterStr);
+    auto const before = LDAPFilter::GetCacheStatistics();
+    LDAPFilter second(filterStr);
+    auto const after = LDAPFilter::GetCacheStatistics();
+
+    // The second construction must be answered from the cache.
+    ASSERT_GT(after.hits, before.hits);
+    ASSERT_EQ(after.misses, before.misses);
+    ASSERT_EQ(first, second);
+    ASSERT_LE(after.size, after.capacity);
+
+    // Invalid filters are never cached and keep throwing.
+    EXPECT_THROW(LDAPFilter("(ldapFilterCacheTest=Invalid"), std::invalid_argument);
+    EXPECT_THROW(LDAPFilter("(ldapFilterCacheTest=Invalid"), std::invalid_argument);
+}
+
+TEST(LDAPFilter, CacheEviction)
+{
+    auto const before = LDAPFilter::GetCacheStatistics();
+    for (std::size_t i = 0; i <= before.capacity; ++i)
+    {
+        LDAPFilter filter("(ldapFilterCacheTest=Eviction" + std::to_string(i) + ")");
+        ASSERT_TRUE(filter);
+    }
+    auto const after = LDAPFilter::GetCacheStatistics();
+
+    ASSERT_GT(after.evictions, before.evictions);
+    ASSERT_EQ(after.size, after.capacity);
+}
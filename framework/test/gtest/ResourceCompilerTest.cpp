@@ -20,6 +20,11 @@
 
 =============================================================================*/
 
+#include "cppmicroservices/Bundle.h"
+#include "cppmicroservices/BundleContext.h"
+#include "cppmicroservices/Framework.h"
+#include "cppmicroservices/FrameworkEvent.h"
+#include "cppmicroservices/FrameworkFactory.h"
 #include "cppmicroservices/util/FileSystem.h"
 
 #include "TestUtils.h"
@@ -33,6 +38,7 @@
 #include <rapidjson/document.h>
 
 #include <array>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
@@ -651,6 +657,50 @@ TEST_F(ResourceCompilerTest, testCompressionLevel)
     testExists(entryNames, "mybundle/resource2/");
 }
 
+/*
+ * Use resource compiler to store a binary manifest next to manifest.json and
+ * check that the framework installs the bundle with the manifest's headers.
+ */
+TEST_F(ResourceCompilerTest, testBinaryManifest)
+{
+    std::ostringstream cmd;
+    cmd << rcbinpath;
+    cmd << " --bundle-name mybundle ";
+    cmd << " --manifest-add manifest.json ";
+    cmd << " --out-file ExampleBinaryManifest.zip ";
+    cmd << " --res-add resource1/resource1.txt ";
+    cmd << " --binary-manifest";
+
+    auto cwdir = util::GetCurrentWorkingDirectory();
+    ChangeDirectory(tempdir);
+    // Test that --binary-manifest successfully creates a zip file.
+    ASSERT_EQ(EXIT_SUCCESS, runExecutable(cmd.str()));
+    ChangeDirectory(cwdir);
+
+    ZipFile zip(tempdir + "ExampleBinaryManifest.zip");
+    // Check number of entries of zip.
+    ASSERT_EQ(zip.size(), 5);
+
+    auto entryNames = zip.getNames();
+    testExists(entryNames, "mybundle/manifest.json");
+    testExists(entryNames, "mybundle/manifest.bin");
+    testExists(entryNames, "mybundle/");
+    testExists(entryNames, "mybundle/resource1/resource1.txt");
+    testExists(entryNames, "mybundle/resource1/");
+
+    auto framework = FrameworkFactory().NewFramework();
+    framework.Start();
+    auto bundles = framework.GetBundleContext().InstallBundles(tempdir + "ExampleBinaryManifest.zip");
+    ASSERT_EQ(bundles.size(), 1);
+    auto const& headers = bundles.at(0).GetHeaders();
+    EXPECT_EQ(headers.at("bundle.symbolic_name").ToString(), "mybundle");
+    EXPECT_EQ(headers.at("bundle.version").ToString(), "0.1.0");
+    EXPECT_TRUE(any_cast<bool>(headers.at("bundle.activator")));
+    EXPECT_EQ(bundles.at(0).GetVersion(), BundleVersion(0, 1, 0));
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
 /*
  * Add the same manifest contents multiples times through --manifest-add
  * The intended behavior is that any subsequent duplicate manifest file is ignored
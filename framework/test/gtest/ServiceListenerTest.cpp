@@ -398,4 +398,64 @@ TEST_F(ServiceListenerTest, frameSL25a)
     sListen.clearEvents();
 }
 
+namespace
+{
+    struct ObjectClassFilterService
+    {
+        virtual ~ObjectClassFilterService() = default;
+    };
+
+    struct OtherObjectClassFilterService
+    {
+        virtual ~OtherObjectClassFilterService() = default;
+    };
+} // namespace
+
+TEST_F(ServiceListenerTest, ObjectClassConjunctionFilters)
+{
+    auto context = framework.GetBundleContext();
+    std::string const objectClass = us_service_interface_iid<ObjectClassFilterService>();
+    std::string const otherObjectClass = us_service_interface_iid<OtherObjectClassFilterService>();
+
+    int andCount = 0;
+    int orCount = 0;
+    int mismatchCount = 0;
+    auto andToken = context.AddServiceListener([&andCount](ServiceEvent const&) { ++andCount; },
+                                               "(&(objectclass=" + objectClass + ")(target=bar))");
+    auto orToken = context.AddServiceListener(
+        [&orCount](ServiceEvent const&) { ++orCount; },
+        "(|(&(objectclass=" + objectClass + ")(target=bar))(&(objectclass=" + otherObjectClass + ")(target=baz)))");
+    auto mismatchToken = context.AddServiceListener([&mismatchCount](ServiceEvent const&) { ++mismatchCount; },
+                                                    "(&(objectclass=" + otherObjectClass + ")(target=bar))");
+
+    auto reg1 = context.RegisterService<ObjectClassFilterService>(std::make_shared<ObjectClassFilterService>(),
+                                                                  ServiceProperties({
+                                                                      {"target", std::string("bar")}
+    }));
+    auto reg2 = context.RegisterService<ObjectClassFilterService>(std::make_shared<ObjectClassFilterService>(),
+                                                                  ServiceProperties({
+                                                                      {"target", std::string("baz")}
+    }));
+    auto reg3
+        = context.RegisterService<OtherObjectClassFilterService>(std::make_shared<OtherObjectClassFilterService>(),
+                                                                 ServiceProperties({
+                                                                     {"target", std::string("baz")}
+    }));
+
+    EXPECT_EQ(andCount, 1);
+    EXPECT_EQ(orCount, 2);
+    EXPECT_EQ(mismatchCount, 0);
+
+    context.RemoveListener(std::move(andToken));
+    reg1.Unregister();
+    EXPECT_EQ(andCount, 1);
+    EXPECT_EQ(orCount, 3);
+
+    context.RemoveListener(std::move(orToken));
+    context.RemoveListener(std::move(mismatchToken));
+    reg2.Unregister();
+    reg3.Unregister();
+    EXPECT_EQ(orCount, 3);
+}
+
 US_MSVC_POP_WARNING
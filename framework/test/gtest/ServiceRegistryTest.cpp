@@ -28,6 +28,7 @@
 #include "TestUtils.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <atomic>
 #include <future>
 #include <thread>
@@ -234,6 +235,161 @@ TEST_F(ServiceRegistryTest, TestServicePropertiesUpdate)
     ASSERT_TRUE(context.GetServiceReferences<ITestServiceA>().empty());
 }
 
+TEST_F(ServiceRegistryTest, TestServicesInUseAreInRegistrationOrder)
+{
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 5; ++i)
+    {
+        regs.push_back(context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>()));
+    }
+    std::vector<std::shared_ptr<ITestServiceA>> services;
+    for (auto i : { 3, 0, 4, 1 })
+    {
+        services.push_back(context.GetService(regs[i].GetReference()));
+    }
+    std::vector<ServiceReferenceU> expected { regs[0].GetReference(),
+                                              regs[1].GetReference(),
+                                              regs[3].GetReference(),
+                                              regs[4].GetReference() };
+    ASSERT_EQ(context.GetBundle().GetServicesInUse(), expected);
+    for (auto& reg : regs)
+    {
+        reg.Unregister();
+    }
+}
+
+TEST_F(ServiceRegistryTest, TestLookupsWhileUnregisteringServicesOfOneClass)
+{
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 20; ++i)
+    {
+        regs.push_back(context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(),
+                                                              ServiceProperties({
+                                                                  { Constants::SERVICE_RANKING, Any(i % 3) }
+        })));
+    }
+    ASSERT_EQ(context.GetServiceReferences<ITestServiceA>().size(), 20u);
+    for (std::size_t i = 0; i < regs.size(); i += 2)
+    {
+        auto ref = regs[i].GetReference();
+        regs[i].Unregister();
+        auto refs = context.GetServiceReferences<ITestServiceA>();
+        ASSERT_EQ(refs.size(), 20u - (i / 2 + 1));
+        ASSERT_EQ(std::find(refs.begin(), refs.end(), ref), refs.end());
+    }
+    auto refs = context.GetServiceReferences<ITestServiceA>();
+    ASSERT_TRUE(std::is_sorted(refs.rbegin(), refs.rend()));
+
+    // Registering after the class was compacted still orders by ranking
+    auto top = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(),
+                                                      ServiceProperties({
+                                                          { Constants::SERVICE_RANKING, Any(10) }
+    }));
+    ASSERT_EQ(context.GetServiceReference<ITestServiceA>(), top.GetReference());
+    top.Unregister();
+    for (std::size_t i = 1; i < regs.size(); i += 2)
+    {
+        regs[i].Unregister();
+    }
+    ASSERT_TRUE(context.GetServiceReferences<ITestServiceA>().empty());
+}
+
+TEST_F(ServiceRegistryTest, TestServicesInUse)
+{
+    auto bundle = context.GetBundle();
+    auto regCount = bundle.GetRegisteredServices().size();
+    ASSERT_TRUE(bundle.GetServicesInUse().empty());
+
+    auto reg1 = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    auto reg2 = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    auto reg3 = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>());
+    auto registered = bundle.GetRegisteredServices();
+    ASSERT_EQ(registered.size(), regCount + 3);
+    ASSERT_EQ(registered[regCount + 1], reg2.GetReference());
+
+    auto service1 = context.GetService(reg1.GetReference());
+    auto service2 = context.GetService(reg2.GetReference());
+    auto service2Again = context.GetService(reg2.GetReference());
+    auto inUse = bundle.GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 2);
+    ASSERT_NE(std::find(inUse.begin(), inUse.end(), reg1.GetReference()), inUse.end());
+    ASSERT_NE(std::find(inUse.begin(), inUse.end(), reg2.GetReference()), inUse.end());
+
+    // A service stays in use until all of its service objects are released
+    service2.reset();
+    ASSERT_EQ(bundle.GetServicesInUse().size(), 2);
+    service2Again.reset();
+    inUse = bundle.GetServicesInUse();
+    ASSERT_EQ(inUse.size(), 1);
+    ASSERT_EQ(inUse.front(), reg1.GetReference());
+
+    // Unregistering a service which is in use removes it as well
+    reg1.Unregister();
+    ASSERT_TRUE(bundle.GetServicesInUse().empty());
+    ASSERT_EQ(bundle.GetRegisteredServices().size(), regCount + 2);
+
+    reg2.Unregister();
+    registered = bundle.GetRegisteredServices();
+    ASSERT_EQ(registered.size(), regCount + 1);
+    ASSERT_EQ(registered.back(), reg3.GetReference());
+    reg3.Unregister();
+}
+
+TEST(ServiceRegistryIndexTest, TestIndexedServiceProperties)
+{
+    FrameworkConfiguration config;
+    config[Constants::FRAMEWORK_SERVICE_INDEXED_PROPERTIES] = std::vector<std::string> { "tenant", "shard" };
+    auto framework = FrameworkFactory().NewFramework(config);
+    framework.Start();
+    auto context = framework.GetBundleContext();
+
+    std::vector<ServiceRegistration<ITestServiceA>> regs;
+    for (int i = 0; i < 10; ++i)
+    {
+        ServiceProperties props;
+        props["tenant"] = std::string("tenant") + std::to_string(i % 5);
+        props["shard"] = std::string("shard") + std::to_string(i);
+        props[Constants::SERVICE_RANKING] = i;
+        regs.push_back(context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(), props));
+    }
+    // A non-string value can not be indexed but must still be found.
+    ServiceProperties intProps;
+    intProps["tenant"] = 3;
+    auto intReg = context.RegisterService<ITestServiceA>(std::make_shared<TestServiceA>(), intProps);
+    // An indexed property of a service registered under a different interface.
+    ServiceProperties otherProps;
+    otherProps["tenant"] = std::string("tenant3");
+    auto otherReg = context.RegisterService<ITestServiceB>(std::make_shared<ITestServiceB>(), otherProps);
+
+    auto refs = context.GetServiceReferences<ITestServiceA>("(tenant=tenant3)");
+    ASSERT_EQ(refs.size(), 2);
+    // the highest ranked service comes first
+    EXPECT_EQ(refs[0], regs[8].GetReference());
+    EXPECT_EQ(refs[1], regs[3].GetReference());
+
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(&(TENANT=tenant3)(shard=shard8))").size(), 1);
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(&(tenant=tenant3)(shard=shard1))").size(), 0);
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(tenant=3)").size(), 1);
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(tenant=tenant*)").size(), 10);
+    EXPECT_EQ(context.GetServiceReferences("", "(tenant=tenant3)").size(), 3);
+
+    ServiceProperties modified;
+    modified["tenant"] = std::string("tenant3");
+    modified["shard"] = std::string("shard0");
+    regs[0].SetProperties(modified);
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(tenant=tenant3)").size(), 3);
+    EXPECT_EQ(context.GetServiceReferences<ITestServiceA>("(tenant=tenant0)").size(), 1);
+
+    regs[8].Unregister();
+    refs = context.GetServiceReferences<ITestServiceA>("(tenant=tenant3)");
+    ASSERT_EQ(refs.size(), 2);
+    EXPECT_EQ(refs[0], regs[3].GetReference());
+    EXPECT_EQ(refs[1], regs[0].GetReference());
+
+    framework.Stop();
+    framework.WaitForStop(std::chrono::milliseconds::zero());
+}
+
 
 
 #if defined(US_ENABLE_THREADING_SUPPORT)
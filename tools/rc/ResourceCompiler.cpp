@@ -68,6 +68,7 @@ namespace us_nowide = nowide;
 #endif
 
 #include "CLI/CLI.hpp"
+#include "cppmicroservices/util/BinaryManifest.h"
 #include "cppmicroservices/util/RapidJsonUtils.h"
 
 #include <rapidjson/document.h>
@@ -375,10 +376,13 @@ namespace
 class ZipArchive
 {
   public:
-    ZipArchive(std::string const& archiveFileName, int compressionLevel, std::string const& bundleName);
+    ZipArchive(std::string const& archiveFileName,
+               int compressionLevel,
+               std::string const& bundleName,
+               bool binaryManifest = false);
     virtual ~ZipArchive();
     /*
-     * @brief Add manifest.json to this zip archive
+     * @brief Add manifest.json (and manifest.bin, if requested) to this zip archive
      * @param manifest contents of the manifest to add to the zip archive
      * @throw std::runtime exception if failed to add manifest.json
      * @throw InvalidManifest if manifest.json is invalid
@@ -422,6 +426,13 @@ class ZipArchive
      */
     void CheckAndAddToArchivedNames(std::string const& archiveEntry);
 
+    /*
+     * @brief Add the binary encoding of a manifest as <bundleName>/manifest.bin,
+     *        if binary manifests were requested.
+     * @throw std::runtime exception if failed to add the entry
+     */
+    void AddBinaryManifest(rapidjson::Value const& manifest);
+
     void
     PrintErrorAndExit(std::string const& errorMsg)
     {
@@ -432,15 +443,20 @@ class ZipArchive
     std::string fileName;
     int compressionLevel;
     std::string bundleName;
+    bool binaryManifest;
     std::unique_ptr<mz_zip_archive> writeArchive;
     std::set<std::string> archivedNames; // list of all the file entries
     std::set<std::string> archivedDirs;  // list of all directory entries
 };
 
-ZipArchive::ZipArchive(std::string const& archiveFileName, int compressionLevel, std::string const& bName)
+ZipArchive::ZipArchive(std::string const& archiveFileName,
+                       int compressionLevel,
+                       std::string const& bName,
+                       bool binaryManifest)
     : fileName(archiveFileName)
     , compressionLevel(compressionLevel)
     , bundleName(bName)
+    , binaryManifest(binaryManifest)
     , writeArchive(new mz_zip_archive())
 {
     std::clog << "Initializing zip archive " << fileName << " ..." << std::endl;
@@ -464,6 +480,29 @@ ZipArchive::CheckAndAddToArchivedNames(std::string const& archiveEntry)
     }
 }
 
+void
+ZipArchive::AddBinaryManifest(rapidjson::Value const& manifest)
+{
+    if (!binaryManifest)
+    {
+        return;
+    }
+
+    std::string const encodedManifest = cppmicroservices::binarymanifest::Encode(manifest);
+    std::string archiveEntry(bundleName + "/" + cppmicroservices::binarymanifest::ENTRY_NAME);
+    CheckAndAddToArchivedNames(archiveEntry);
+
+    if (MZ_FALSE
+        == mz_zip_writer_add_mem(writeArchive.get(),
+                                 archiveEntry.c_str(),
+                                 encodedManifest.data(),
+                                 encodedManifest.size(),
+                                 compressionLevel))
+    {
+        throw std::runtime_error("Error writing " + archiveEntry + " to archive " + fileName);
+    }
+}
+
 void
 ZipArchive::AddManifestFile(rapidjson::Document const& manifest)
 {
@@ -512,6 +551,7 @@ ZipArchive::AddManifestFile(rapidjson::Document const& manifest)
     {
         throw std::runtime_error("Error writing manifest.json to archive " + fileName);
     }
+    AddBinaryManifest(manifest);
     AddDirectory(bundleName + "/");
 }
 
@@ -536,10 +576,11 @@ ZipArchive::AddResourceFile(std::string const& resFileName, bool isManifest)
 
     // This check exists solely to maintain a deprecated way of adding manifest.json
     // through the --res-add option.
-    if (isManifest || resFileName == std::string("manifest.json"))
+    rapidjson::Document manifestRoot;
+    bool const addsManifest = isManifest || resFileName == std::string("manifest.json");
+    if (addsManifest)
     {
-        rapidjson::Document root;
-        parseAndValidateJsonFromFile(resFileName, root);
+        parseAndValidateJsonFromFile(resFileName, manifestRoot);
     }
 
     // if it is a manifest file, we ignore the parent directory path because the
@@ -561,6 +602,10 @@ ZipArchive::AddResourceFile(std::string const& resFileName, bool isManifest)
     {
         throw std::runtime_error("Error writing file to archive");
     }
+    if (addsManifest)
+    {
+        AddBinaryManifest(manifestRoot);
+    }
     // add a directory entries for the file path
     size_t lastPathSeparatorPos = archiveEntry.find("/", 0);
     while (lastPathSeparatorPos != std::string::npos)
@@ -737,6 +782,12 @@ main(int argc, char** argv)
                          bundleFile,
                          "Path to the bundle binary. The resources zip file will be appended to this binary.");
 
+    bool binaryManifest = false;
+    app.add_flag("--binary-manifest",
+                 binaryManifest,
+                 "Also store a precompiled binary form of the bundle manifest (manifest.bin), which the framework "
+                 "reads instead of parsing manifest.json.");
+
     app.set_help_all_flag("--help-all", "Expand all help");
 
     try
@@ -843,7 +894,7 @@ main(int argc, char** argv)
                 deleteTempFile = true;
             }
 
-            std::unique_ptr<ZipArchive> zipArchive(new ZipArchive(zipFile, compressionLevel, bundleName));
+            std::unique_ptr<ZipArchive> zipArchive(new ZipArchive(zipFile, compressionLevel, bundleName, binaryManifest));
 
             // map of manifest file to its JSON data.
             // std::map ensures manifests are processed in sorted filename order,
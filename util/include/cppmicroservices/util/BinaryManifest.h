@@ -0,0 +1,387 @@
+/*=============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) The CppMicroServices developers. See the COPYRIGHT
+  file at the top-level directory of this distribution and at
+  https://github.com/CppMicroServices/CppMicroServices/COPYRIGHT .
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CPPMICROSERVICES_UTIL_BINARYMANIFEST_H
+#define CPPMICROSERVICES_UTIL_BINARYMANIFEST_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <rapidjson/document.h>
+
+namespace cppmicroservices::binarymanifest
+{
+
+    /*
+     * A compact binary encoding of manifest values. The resource compiler
+     * writes a bundle's manifest.json in this encoding to the manifest.bin
+     * entry next to it, and the framework's bundle storage uses it for the
+     * manifests it records.
+     *
+     * Layout (all integers little endian):
+     *
+     *   manifest.bin := magic "USMF" | uint8 version | value
+     *
+     *   value  := uint8 tag, followed by
+     *             Int:           int32
+     *             Long:          int64
+     *             Double:        IEEE 754 binary64
+     *             String:        uint32 size, bytes
+     *             Array:         uint32 count, value...
+     *             Object:        uint32 count, (uint32 size, key bytes, value)...
+     *             TypedObject:   uint8 map type, then as Object
+     *             OrderedObject: as Object
+     *             nothing for Null, False and True
+     *
+     * JSON values which the framework does not map to an Any (null and
+     * integers outside the int32 range) are encoded as Null. The resource
+     * compiler only writes the tags up to Object; the others encode values
+     * which do not come from JSON.
+     */
+
+    constexpr char const* ENTRY_NAME = "manifest.bin";
+    constexpr char MAGIC[4] = { 'U', 'S', 'M', 'F' };
+    constexpr uint8_t VERSION = 1;
+    constexpr int MAX_DEPTH = 128;
+
+    static_assert(sizeof(double) == 8, "The encoding requires IEEE 754 binary64 doubles");
+
+    enum class Tag : uint8_t
+    {
+        Null = 0,
+        False = 1,
+        True = 2,
+        Int = 3,
+        Double = 4,
+        String = 5,
+        Array = 6,
+        Object = 7,
+        Long = 8,
+        TypedObject = 9,
+        OrderedObject = 10
+    };
+
+    /*
+     * Appends encoded values to a buffer.
+     */
+    class Writer
+    {
+      public:
+        void
+        WriteUInt8(uint8_t value)
+        {
+            m_Data.push_back(static_cast<char>(value));
+        }
+
+        void
+        WriteTag(Tag tag)
+        {
+            WriteUInt8(static_cast<uint8_t>(tag));
+        }
+
+        void
+        WriteUInt32(uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                m_Data.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+            }
+        }
+
+        void
+        WriteUInt64(uint64_t value)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                m_Data.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+            }
+        }
+
+        void
+        WriteInt32(int32_t value)
+        {
+            WriteUInt32(static_cast<uint32_t>(value));
+        }
+
+        void
+        WriteInt64(int64_t value)
+        {
+            WriteUInt64(static_cast<uint64_t>(value));
+        }
+
+        void
+        WriteDouble(double value)
+        {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof bits);
+            WriteUInt64(bits);
+        }
+
+        void
+        WriteString(std::string_view value)
+        {
+            WriteUInt32(static_cast<uint32_t>(value.size()));
+            m_Data.append(value.data(), value.size());
+        }
+
+        /// Appends bytes as they are, without a size.
+        void
+        WriteBytes(std::string_view bytes)
+        {
+            m_Data.append(bytes.data(), bytes.size());
+        }
+
+        std::size_t
+        Size() const
+        {
+            return m_Data.size();
+        }
+
+        /// Discards everything written after the first size bytes.
+        void
+        Truncate(std::size_t size)
+        {
+            m_Data.resize(size);
+        }
+
+        std::string const&
+        Data() const
+        {
+            return m_Data;
+        }
+
+      private:
+        std::string m_Data;
+    };
+
+    namespace detail
+    {
+        inline void
+        EncodeValue(rapidjson::Value const& value, Writer& out)
+        {
+            if (value.IsObject())
+            {
+                out.WriteTag(Tag::Object);
+                out.WriteUInt32(value.MemberCount());
+                for (auto const& m : value.GetObject())
+                {
+                    out.WriteString(std::string_view(m.name.GetString(), m.name.GetStringLength()));
+                    EncodeValue(m.value, out);
+                }
+            }
+            else if (value.IsArray())
+            {
+                out.WriteTag(Tag::Array);
+                out.WriteUInt32(value.Size());
+                for (auto const& v : value.GetArray())
+                {
+                    EncodeValue(v, out);
+                }
+            }
+            else if (value.IsString())
+            {
+                out.WriteTag(Tag::String);
+                out.WriteString(std::string_view(value.GetString(), value.GetStringLength()));
+            }
+            else if (value.IsBool())
+            {
+                out.WriteTag(value.GetBool() ? Tag::True : Tag::False);
+            }
+            else if (value.IsInt())
+            {
+                out.WriteTag(Tag::Int);
+                out.WriteInt32(value.GetInt());
+            }
+            else if (value.IsDouble())
+            {
+                out.WriteTag(Tag::Double);
+                out.WriteDouble(value.GetDouble());
+            }
+            else
+            {
+                out.WriteTag(Tag::Null);
+            }
+        }
+    } // namespace detail
+
+    /// Encodes a parsed manifest.json document.
+    inline std::string
+    Encode(rapidjson::Value const& manifest)
+    {
+        Writer out;
+        out.WriteBytes(std::string_view(MAGIC, sizeof MAGIC));
+        out.WriteUInt8(VERSION);
+        detail::EncodeValue(manifest, out);
+        return out.Data();
+    }
+
+    /*
+     * Bounds checked sequential reader for encoded values. All read
+     * functions return false instead of reading past the end of the data.
+     */
+    class Reader
+    {
+      public:
+        explicit Reader(std::string_view data) : m_Data(data), m_Pos(0) {}
+
+        /// Checks the magic and version of manifest.bin. Must be called first.
+        bool
+        ReadHeader()
+        {
+            uint8_t version = 0;
+            if (m_Data.size() < sizeof MAGIC || std::memcmp(m_Data.data(), MAGIC, sizeof MAGIC) != 0)
+            {
+                return false;
+            }
+            m_Pos = sizeof MAGIC;
+            return ReadUInt8(version) && version == VERSION;
+        }
+
+        bool
+        ReadTag(Tag& tag)
+        {
+            uint8_t value = 0;
+            if (!ReadUInt8(value) || value > static_cast<uint8_t>(Tag::OrderedObject))
+            {
+                return false;
+            }
+            tag = static_cast<Tag>(value);
+            return true;
+        }
+
+        bool
+        ReadUInt8(uint8_t& value)
+        {
+            if (m_Pos >= m_Data.size())
+            {
+                return false;
+            }
+            value = static_cast<uint8_t>(m_Data[m_Pos++]);
+            return true;
+        }
+
+        bool
+        ReadUInt32(uint32_t& value)
+        {
+            if (m_Data.size() - m_Pos < 4)
+            {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                value |= static_cast<uint32_t>(static_cast<uint8_t>(m_Data[m_Pos++])) << (8 * i);
+            }
+            return true;
+        }
+
+        bool
+        ReadUInt64(uint64_t& value)
+        {
+            uint32_t low = 0;
+            uint32_t high = 0;
+            if (!ReadUInt32(low) || !ReadUInt32(high))
+            {
+                return false;
+            }
+            value = (static_cast<uint64_t>(high) << 32) | low;
+            return true;
+        }
+
+        bool
+        ReadInt32(int32_t& value)
+        {
+            uint32_t bits = 0;
+            if (!ReadUInt32(bits))
+            {
+                return false;
+            }
+            std::memcpy(&value, &bits, sizeof value);
+            return true;
+        }
+
+        bool
+        ReadInt64(int64_t& value)
+        {
+            uint64_t bits = 0;
+            if (!ReadUInt64(bits))
+            {
+                return false;
+            }
+            std::memcpy(&value, &bits, sizeof value);
+            return true;
+        }
+
+        bool
+        ReadDouble(double& value)
+        {
+            uint64_t bits = 0;
+            if (!ReadUInt64(bits))
+            {
+                return false;
+            }
+            std::memcpy(&value, &bits, sizeof value);
+            return true;
+        }
+
+        bool
+        ReadString(std::string_view& value)
+        {
+            uint32_t size = 0;
+            if (!ReadUInt32(size) || m_Data.size() - m_Pos < size)
+            {
+                return false;
+            }
+            value = m_Data.substr(m_Pos, size);
+            m_Pos += size;
+            return true;
+        }
+
+        bool
+        ReadString(std::string& value)
+        {
+            std::string_view view;
+            if (!ReadString(view))
+            {
+                return false;
+            }
+            value.assign(view.data(), view.size());
+            return true;
+        }
+
+        /// Returns the number of bytes not read yet.
+        std::size_t
+        Remaining() const
+        {
+            return m_Data.size() - m_Pos;
+        }
+
+      private:
+        std::string_view m_Data;
+        std::size_t m_Pos;
+    };
+
+} // namespace cppmicroservices::binarymanifest
+
+#endif // CPPMICROSERVICES_UTIL_BINARYMANIFEST_H
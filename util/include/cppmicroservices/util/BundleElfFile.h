@@ -28,10 +28,9 @@
 #    include <cerrno>
 #    include <cstring>
 #    include <elf.h>
-#    include <fstream>
-#    include <map>
 #    include <memory>
-#    include <new>
+#    include <mutex>
+#    include <unordered_map>
 
 #    include <sys/stat.h>
 
@@ -89,78 +88,92 @@ namespace cppmicroservices
         }
     };
 
+    // The location of the .us_resources section in an ELF file.
+    struct ElfResourceSection
+    {
+        bool found = false;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    /// Find the .us_resources section of an ELF shared library.
+    ///
+    /// @param image the complete contents of the ELF file, e.g. mapped into memory.
+    /// @param imageSize the size of the ELF file in bytes.
+    /// @throws InvalidElfException if the image is not a valid ELF shared library.
     template <class ElfType>
-    class BundleElfFile
-        : public BundleObjFile
-        , private ElfType
+    ElfResourceSection
+    FindElfResourceSection(char const* image, std::size_t imageSize)
     {
-      public:
         typedef typename ElfType::Ehdr Ehdr;
         typedef typename ElfType::Shdr Shdr;
-        typedef typename ElfType::Dyn Dyn;
-        typedef typename ElfType::Addr Addr;
-        typedef typename ElfType::Sym Sym;
-
-        typedef typename ElfType::Half Half;
-        typedef typename ElfType::Word Word;
-        typedef typename ElfType::Off Off;
 
-        BundleElfFile(std::ifstream& fs, std::size_t fileSize, std::string const& fileName) : m_rawData()
+        if (imageSize < sizeof(Ehdr))
         {
-            if (fileSize < sizeof(Ehdr))
-            {
-                throw InvalidElfException("Missing ELF header");
-            }
+            throw InvalidElfException("Missing ELF header");
+        }
 
-            fs.seekg(0);
+        // The image may not be suitably aligned for the ELF structures, copy them out
+        Ehdr elfHeader;
+        std::memcpy(&elfHeader, image, sizeof elfHeader);
 
-            // Read the ELF header
-            Ehdr elfHeader;
-            fs.read(reinterpret_cast<char*>(&elfHeader), sizeof elfHeader);
+        if (elfHeader.e_type != ET_DYN)
+        {
+            throw InvalidElfException("Not an ELF shared library");
+        }
 
-            if (elfHeader.e_type != ET_DYN)
-            {
-                throw InvalidElfException("Not an ELF shared library");
-            }
+        if (elfHeader.e_shnum == 0)
+        {
+            return {};
+        }
 
-            if (elfHeader.e_shoff + (elfHeader.e_shnum * elfHeader.e_shentsize) > fileSize)
-            {
-                throw InvalidElfException("ELF section headers missing");
-            }
+        if (elfHeader.e_shentsize < sizeof(Shdr) || elfHeader.e_shoff > imageSize
+            || elfHeader.e_shnum > (imageSize - elfHeader.e_shoff) / elfHeader.e_shentsize)
+        {
+            throw InvalidElfException("ELF section headers missing");
+        }
 
-            // read in all section headers
-            auto sectionHeaders = std::make_unique<Shdr[]>(elfHeader.e_shnum);
-            fs.seekg(elfHeader.e_shoff);
-            fs.read(reinterpret_cast<char*>(sectionHeaders.get()), sizeof(Shdr) * elfHeader.e_shnum);
+        auto sectionHeader = [&](std::size_t index)
+        {
+            Shdr header;
+            std::memcpy(&header, image + elfHeader.e_shoff + index * elfHeader.e_shentsize, sizeof header);
+            return header;
+        };
 
-            // parse the .us_resources section
-            // keep the buffer in a smart pointer to correctly clean up at end
-            // of scope even if exceptions occur.
-            auto buffer = std::make_unique<char[]>(sectionHeaders[elfHeader.e_shstrndx].sh_size);
-            if (nullptr != buffer)
-            {
-                fs.seekg(sectionHeaders[elfHeader.e_shstrndx].sh_offset);
-                fs.read(buffer.get(), sectionHeaders[elfHeader.e_shstrndx].sh_size);
+        if (elfHeader.e_shstrndx >= elfHeader.e_shnum)
+        {
+            throw InvalidElfException("ELF section names missing");
+        }
+        Shdr const names = sectionHeader(elfHeader.e_shstrndx);
+        if (names.sh_offset > imageSize || names.sh_size > imageSize - names.sh_offset)
+        {
+            throw InvalidElfException("ELF section names missing");
+        }
+        char const* nameTable = image + names.sh_offset;
 
-                for (int i = 0; i < elfHeader.e_shnum; ++i)
-                {
-                    if (0 == strcmp(".us_resources", (buffer.get() + sectionHeaders[i].sh_name)))
-                    {
-                        fs.seekg(sectionHeaders[i].sh_offset);
-                        auto zipContentSize = sectionHeaders[i].sh_size;
-                        if (0 < zipContentSize)
-                        {
-                            off_t pa_offset = (sectionHeaders[i].sh_offset) & ~(sysconf(_SC_PAGESIZE) - 1);
-                            size_t dataOffset = sectionHeaders[i].sh_offset - static_cast<size_t>(pa_offset);
-                            size_t mappedLength = zipContentSize + dataOffset;
-                            m_rawData = std::make_shared<RawBundleResources>(
-                                std::make_unique<MappedFile>(fileName, mappedLength, pa_offset, dataOffset));
-                            break;
-                        }
-                    }
-                }
+        static constexpr char resourceSectionName[] = ".us_resources";
+        for (std::size_t i = 0; i < elfHeader.e_shnum; ++i)
+        {
+            Shdr const section = sectionHeader(i);
+            if (section.sh_name < names.sh_size && names.sh_size - section.sh_name >= sizeof resourceSectionName
+                && 0 == std::memcmp(nameTable + section.sh_name, resourceSectionName, sizeof resourceSectionName)
+                && 0 < section.sh_size && section.sh_offset <= imageSize
+                && section.sh_size <= imageSize - section.sh_offset)
+            {
+                ElfResourceSection resources;
+                resources.found = true;
+                resources.offset = static_cast<std::size_t>(section.sh_offset);
+                resources.size = static_cast<std::size_t>(section.sh_size);
+                return resources;
             }
         }
+        return {};
+    }
+
+    class BundleElfFile final : public BundleObjFile
+    {
+      public:
+        explicit BundleElfFile(std::shared_ptr<RawBundleResources> rawData) : m_rawData(std::move(rawData)) {}
 
         std::shared_ptr<RawBundleResources>
         GetRawBundleResourceContainer() const override
@@ -172,6 +185,79 @@ namespace cppmicroservices
         std::shared_ptr<RawBundleResources> m_rawData;
     };
 
+    namespace detail
+    {
+        // Identifies a version of a file on disk.
+        struct ElfFileIdentity
+        {
+            dev_t device;
+            ino_t inode;
+            off_t size;
+            struct timespec modified;
+
+            explicit ElfFileIdentity(struct stat const& fileStat)
+                : device(fileStat.st_dev)
+                , inode(fileStat.st_ino)
+                , size(fileStat.st_size)
+                , modified(fileStat.st_mtim)
+            {
+            }
+
+            bool
+            operator==(ElfFileIdentity const& other) const
+            {
+                return device == other.device && inode == other.inode && size == other.size
+                       && modified.tv_sec == other.modified.tv_sec && modified.tv_nsec == other.modified.tv_nsec;
+            }
+        };
+
+        struct ElfResourceLocation
+        {
+            ElfFileIdentity identity;
+            ElfResourceSection section;
+            // The mapped section, as long as some bundle still uses it
+            std::weak_ptr<RawBundleResources> resources;
+        };
+
+        // Remembers where the resources of each ELF file are located, so that
+        // opening an unchanged file again, e.g. after a framework restart,
+        // does not need to read its headers.
+        class ElfResourceLocationCache
+        {
+          public:
+            static ElfResourceLocationCache&
+            Instance()
+            {
+                static ElfResourceLocationCache cache;
+                return cache;
+            }
+
+            bool
+            Find(std::string const& fileName, ElfFileIdentity const& identity, ElfResourceLocation& location) const
+            {
+                std::lock_guard<std::mutex> l(m_Mutex);
+                auto const iter = m_Locations.find(fileName);
+                if (iter == m_Locations.end() || !(iter->second.identity == identity))
+                {
+                    return false;
+                }
+                location = iter->second;
+                return true;
+            }
+
+            void
+            Store(std::string const& fileName, ElfResourceLocation const& location)
+            {
+                std::lock_guard<std::mutex> l(m_Mutex);
+                m_Locations.insert_or_assign(fileName, location);
+            }
+
+          private:
+            mutable std::mutex m_Mutex;
+            std::unordered_map<std::string, ElfResourceLocation> m_Locations;
+        };
+    } // namespace detail
+
     std::unique_ptr<BundleObjFile>
     CreateBundleElfFile(std::string const& fileName)
     {
@@ -182,6 +268,30 @@ namespace cppmicroservices
             throw InvalidElfException("Stat for " + fileName + " failed", errno);
         }
 
+        auto& cache = detail::ElfResourceLocationCache::Instance();
+        detail::ElfResourceLocation location { detail::ElfFileIdentity(elfStat), {}, {} };
+        if (cache.Find(fileName, location.identity, location))
+        {
+            if (!location.section.found)
+            {
+                return std::make_unique<BundleElfFile>(nullptr);
+            }
+            if (auto rawData = location.resources.lock())
+            {
+                return std::make_unique<BundleElfFile>(std::move(rawData));
+            }
+
+            // map just the resource section
+            off_t pa_offset = static_cast<off_t>(location.section.offset) & ~(sysconf(_SC_PAGESIZE) - 1);
+            size_t dataOffset = location.section.offset - static_cast<size_t>(pa_offset);
+            size_t mappedLength = location.section.size + dataOffset;
+            auto rawData = std::make_shared<RawBundleResources>(
+                std::make_unique<MappedFile>(fileName, mappedLength, pa_offset, dataOffset));
+            location.resources = rawData;
+            cache.Store(fileName, location);
+            return std::make_unique<BundleElfFile>(std::move(rawData));
+        }
+
         std::size_t fileSize = elfStat.st_size;
 
         if (fileSize < EI_NIDENT)
@@ -189,38 +299,43 @@ namespace cppmicroservices
             throw InvalidElfException("Missing ELF identification");
         }
 
-        std::ifstream elfFile(fileName.c_str(), std::ios_base::binary);
-        elfFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-        char elfIdent[EI_NIDENT];
-        elfFile.read(elfIdent, sizeof elfIdent);
-
-        if (memcmp(elfIdent, ELFMAG, SELFMAG) != 0)
+        // Map the file once and read the headers directly from the mapping. The
+        // resource section is served from the same mapping.
+        errno = 0;
+        auto image = std::make_shared<MappedFile const>(fileName, fileSize, 0);
+        char const* data = static_cast<char const*>(image->GetData());
+        if (nullptr == data)
         {
-            throw InvalidElfException("Not an ELF object file");
+            throw InvalidElfException("Mapping " + fileName + " failed", errno);
         }
 
-        std::ifstream selfFile(fileName, std::ios_base::binary);
-        char selfIdent[EI_NIDENT];
-        selfFile.read(selfIdent, sizeof selfIdent);
-        selfFile.close();
-        if (memcmp(elfIdent, selfIdent, EI_VERSION) != 0)
+        if (memcmp(data, ELFMAG, SELFMAG) != 0)
         {
-            throw InvalidElfException("Not a compatible ELF object file");
+            throw InvalidElfException("Not an ELF object file");
         }
 
-        if (elfIdent[EI_CLASS] == ELFCLASS32)
+        if (data[EI_CLASS] == ELFCLASS32)
         {
-            return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS32>>(elfFile, fileSize, fileName));
+            location.section = FindElfResourceSection<Elf<ELFCLASS32>>(data, fileSize);
         }
-        else if (elfIdent[EI_CLASS] == ELFCLASS64)
+        else if (data[EI_CLASS] == ELFCLASS64)
         {
-            return std::unique_ptr<BundleObjFile>(new BundleElfFile<Elf<ELFCLASS64>>(elfFile, fileSize, fileName));
+            location.section = FindElfResourceSection<Elf<ELFCLASS64>>(data, fileSize);
         }
         else
         {
             throw InvalidElfException("Unknown ELF format");
         }
+
+        std::shared_ptr<RawBundleResources> rawData;
+        if (location.section.found)
+        {
+            rawData = std::make_shared<RawBundleResources>(
+                std::make_unique<MappedFileView>(std::move(image), location.section.offset, location.section.size));
+            location.resources = rawData;
+        }
+        cache.Store(fileName, location);
+        return std::make_unique<BundleElfFile>(std::move(rawData));
     }
 } // namespace cppmicroservices
 
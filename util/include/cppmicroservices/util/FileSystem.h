@@ -23,6 +23,7 @@
 #ifndef CPPMICROSERVICES_UTIL_FILESYSTEM_H
 #define CPPMICROSERVICES_UTIL_FILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 
 namespace cppmicroservices
@@ -50,6 +51,12 @@ namespace cppmicroservices
         bool IsFile(std::string const& path);
         bool IsRelative(std::string const& path);
 
+        // Get the size in bytes and the last modification time of a file.
+        // The modification time is in nanoseconds since the epoch, with the
+        // resolution supported by the platform.
+        // Returns false if the file does not exist.
+        bool GetFileSizeAndModifiedTime(std::string const& path, int64_t& size, int64_t& modifiedTime);
+
         std::string GetAbsolute(std::string const& path, std::string const& base);
 
         void MakePath(std::string const& path);
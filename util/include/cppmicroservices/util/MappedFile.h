@@ -98,6 +98,38 @@ namespace cppmicroservices
         size_t dataOffset;
     };
 
+    // A range of a mapped file which shares ownership of the mapping.
+    class MappedFileView final : public DataContainer
+    {
+      public:
+        MappedFileView(std::shared_ptr<MappedFile const> file, size_t offset, size_t size)
+            : mappedFile(std::move(file))
+            , viewOffset(offset)
+            , viewSize(size)
+        {
+        }
+
+        void*
+        GetData() const override
+        {
+            if (!mappedFile || !mappedFile->GetData())
+            {
+                return nullptr;
+            }
+            return static_cast<char*>(mappedFile->GetData()) + viewOffset;
+        }
+        std::size_t
+        GetSize() const override
+        {
+            return GetData() ? viewSize : 0;
+        }
+
+      private:
+        std::shared_ptr<MappedFile const> mappedFile;
+        size_t viewOffset;
+        size_t viewSize;
+    };
+
 } // namespace cppmicroservices
 #    endif // CPPMICROSERVICES_MAPPEDFILE_H
 
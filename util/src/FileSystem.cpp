@@ -286,6 +286,33 @@ namespace cppmicroservices
             return S_ISREG(s.st_mode);
         }
 
+        bool
+        GetFileSizeAndModifiedTime(std::string const& path, int64_t& size, int64_t& modifiedTime)
+        {
+            US_STAT s;
+            errno = 0;
+            if (us_stat(path.c_str(), &s))
+            {
+                if (not_found_c_error(errno))
+                {
+                    return false;
+                }
+                else
+                {
+                    throw std::invalid_argument(GetLastCErrorStr());
+                }
+            }
+            size = static_cast<int64_t>(s.st_size);
+#if defined(US_PLATFORM_APPLE)
+            modifiedTime = static_cast<int64_t>(s.st_mtimespec.tv_sec) * 1000000000 + s.st_mtimespec.tv_nsec;
+#elif defined(US_PLATFORM_POSIX)
+            modifiedTime = static_cast<int64_t>(s.st_mtim.tv_sec) * 1000000000 + s.st_mtim.tv_nsec;
+#else
+            modifiedTime = static_cast<int64_t>(s.st_mtime) * 1000000000;
+#endif
+            return true;
+        }
+
         bool
         IsRelative(std::string const& path)
         {